@@ -0,0 +1,7 @@
+#pragma once
+#include <cstdint>
+
+// Heap allocations made through the global operator new so far. AllocationCounter.cpp, linked
+// into options_bench only, replaces operator new to count them; figures read the difference
+// around the code they measure.
+std::uint64_t allocationCount();
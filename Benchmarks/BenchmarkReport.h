@@ -0,0 +1,127 @@
+#pragma once
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// One timed figure from the benchmark suite
+struct BenchmarkMeasurement {
+    std::string name;      // unique key, compared against the baseline entry of the same name
+    std::string unit;      // ns/op, paths/s, ...
+    double value;
+    bool higherIsBetter;
+};
+
+struct BenchmarkComparison {
+    std::size_t compared = 0;
+    std::size_t regressions = 0;
+};
+
+// Results of one benchmark run, written to and read back from JSON:
+//   {"schema": 1, "simdWidth": 8, "hardwareThreads": 16,
+//    "results": [{"name": "...", "unit": "ns/op", "value": 21.4, "better": "lower"}, ...]}
+class BenchmarkReport {
+    std::vector<BenchmarkMeasurement> results_;
+
+    static std::string field(const std::string& object, const std::string& key) {
+        std::size_t at = object.find("\"" + key + "\"");
+        if (at == std::string::npos) return {};
+        at = object.find(':', at);
+        if (at == std::string::npos) return {};
+        ++at;
+        while (at < object.size() && object[at] == ' ') ++at;
+        if (at < object.size() && object[at] == '"') {
+            std::size_t end = object.find('"', at + 1);
+            return object.substr(at + 1, end - at - 1);
+        }
+        std::size_t end = object.find_first_of(",}", at);
+        return object.substr(at, end - at);
+    }
+
+public:
+    unsigned simdWidth = 1;
+    unsigned hardwareThreads = 1;
+
+    void add(std::string name, std::string unit, double value, bool higherIsBetter) {
+        results_.push_back({std::move(name), std::move(unit), value, higherIsBetter});
+    }
+
+    [[nodiscard]] const std::vector<BenchmarkMeasurement>& results() const { return results_; }
+
+    void writeJson(const std::string& path) const {
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("ERROR: Cannot write benchmark report to " + path);
+        out << "{\n  \"schema\": 1,\n  \"simdWidth\": " << simdWidth << ",\n  \"hardwareThreads\": " << hardwareThreads << ",\n  \"results\": [\n";
+        char value[32];
+        for (std::size_t i = 0; i < results_.size(); ++i) {
+            const BenchmarkMeasurement& m = results_[i];
+            std::snprintf(value, sizeof(value), "%.6g", m.value);
+            out << "    {\"name\": \"" << m.name << "\", \"unit\": \"" << m.unit << "\", \"value\": " << value
+                << ", \"better\": \"" << (m.higherIsBetter ? "higher" : "lower") << "\"}" << (i + 1 < results_.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+    // Reads a report written by writeJson
+    static BenchmarkReport readJson(const std::string& path) {
+        std::ifstream in(path);
+        if (!in) throw std::runtime_error("ERROR: Cannot read benchmark baseline " + path);
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        const std::string text = buffer.str();
+
+        BenchmarkReport report;
+        if (std::string width = field(text, "simdWidth"); !width.empty()) report.simdWidth = static_cast<unsigned>(std::stoul(width));
+        if (std::string threads = field(text, "hardwareThreads"); !threads.empty()) report.hardwareThreads = static_cast<unsigned>(std::stoul(threads));
+        std::size_t at = text.find("\"results\"");
+        if (at == std::string::npos) throw std::runtime_error("ERROR: No results in benchmark baseline " + path);
+        while ((at = text.find('{', at)) != std::string::npos) {
+            std::size_t end = text.find('}', at);
+            if (end == std::string::npos) break;
+            const std::string object = text.substr(at, end - at + 1);
+            std::string name = field(object, "name"), value = field(object, "value");
+            if (!name.empty() && !value.empty())
+                report.add(name, field(object, "unit"), std::stod(value), field(object, "better") == "higher");
+            at = end + 1;
+        }
+        return report;
+    }
+
+    // Prints every measurement against its baseline entry. A measurement regresses when it is
+    // worse than the baseline by more than tolerance, relatively.
+    BenchmarkComparison compare(const BenchmarkReport& baseline, double tolerance) const {
+        BenchmarkComparison summary;
+        if (baseline.simdWidth != simdWidth || baseline.hardwareThreads != hardwareThreads)
+            printf("baseline was recorded with %u-wide SIMD on %u threads, this run %u-wide on %u\n",
+                   baseline.simdWidth, baseline.hardwareThreads, simdWidth, hardwareThreads);
+        printf("%-44s%14s%14s%10s  %s\n", "benchmark", "baseline", "current", "change", "");
+        for (const BenchmarkMeasurement& m : results_) {
+            const BenchmarkMeasurement* base = nullptr;
+            for (const BenchmarkMeasurement& b : baseline.results_)
+                if (b.name == m.name) base = &b;
+            if (!base) {
+                printf("%-44s%14s%14.4g%10s  new\n", m.name.c_str(), "-", m.value, "");
+                continue;
+            }
+            if (base->value == 0.0) {
+                // no relative change from zero: any move the wrong way is a regression (an
+                // allocation count that was 0 must stay 0)
+                bool regressed = m.higherIsBetter ? m.value < 0.0 : m.value > 0.0;
+                ++summary.compared;
+                if (regressed) ++summary.regressions;
+                printf("%-44s%14.4g%14.4g%10s  %s\n", m.name.c_str(), base->value, m.value, "-", regressed ? "REGRESSION" : "ok");
+                continue;
+            }
+            double change = m.value / base->value - 1.0;
+            double worse = m.higherIsBetter ? -change : change;
+            bool regressed = worse > tolerance;
+            ++summary.compared;
+            if (regressed) ++summary.regressions;
+            printf("%-44s%14.4g%14.4g%+9.1f%%  %s\n", m.name.c_str(), base->value, m.value, 100.0 * change, regressed ? "REGRESSION" : "ok");
+        }
+        return summary;
+    }
+};
@@ -0,0 +1,386 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Headers/Global.h"
+#include "../Headers/BlackScholes.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/CompactStrategy.h"
+#include "../Headers/ScenarioRunner.h"
+#include "../Headers/ChainFile.h"
+#include "../Headers/ImpliedVolatility.h"
+#include "../Headers/RiskGrid.h"
+#include "../Headers/PortfolioBook.h"
+#include "../Headers/TickReplay.h"
+#include "../Headers/StrategyOptimizer.h"
+#include "../Headers/PdeSolver.h"
+#include "../Headers/Simd.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/ThreadPool.h"
+#include "../Headers/VolatilitySurface.h"
+#include "AllocationCounter.h"
+#include "BenchmarkReport.h"
+
+struct BenchmarkSuiteOptions {
+    bool quick = false;   // fewer sizes and paths, for a smoke run
+    int trials = 5;       // each figure is the best of this many timed runs
+};
+
+namespace benchmark_detail {
+
+inline volatile double sink = 0.0;
+
+// Best wall time of `trials` runs of fn, in nanoseconds
+template <class Fn>
+double bestNs(int trials, Fn&& fn) {
+    double best = 1e300;
+    for (int t = 0; t < trials; ++t) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+// n options spread over moneyness, expiry and type
+struct Chain {
+    std::vector<double> strikes, expiries, prices;
+    std::vector<OptionType> types;
+
+    Chain(std::size_t n, double S, double r, double sigma) : strikes(n), expiries(n), prices(n), types(n) {
+        for (std::size_t i = 0; i < n; ++i) {
+            strikes[i] = S * (0.7 + 0.6 * static_cast<double>(i % 61) / 60.0);
+            expiries[i] = (5.0 + static_cast<double>(i % 17) * 15.0) / gbl::TRADING_DAYS;
+            types[i] = (i % 2 == 0) ? OptionType::Call : OptionType::Put;
+            prices[i] = BlackScholes::calculatePremium(strikes[i], expiries[i], types[i], S, r, sigma).value_or(0.0);
+        }
+    }
+};
+
+inline Strategy ladder(double S, double T, int legs) {
+    Strategy strat("Ladder");
+    for (int i = 0; i < legs; ++i) {
+        double K = S * (0.85 + 0.3 * static_cast<double>(i) / std::max(1, legs - 1));
+        strat.addLeg(Option(K, T, (i % 2 == 0) ? OptionType::Call : OptionType::Put), (i % 3 == 0) ? -1 : 1);
+    }
+    return strat;
+}
+
+}
+
+// Pricing calls at several chain sizes, simulateStrategy across leg counts and thread counts,
+// the batch scenario runner and chain file loading
+inline BenchmarkReport runBenchmarkSuite(const BenchmarkSuiteOptions& options = {}) {
+    using namespace benchmark_detail;
+
+    BenchmarkReport report;
+    report.simdWidth = static_cast<unsigned>(simd::NativeD::width);
+    report.hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    const double S = 100.0, r = 0.04, sigma = 0.25;
+    FlatVolatility flat(sigma);
+    ParametricVolatility smile(sigma, -0.2, 1.0);
+    const std::vector<std::size_t> sizes = options.quick ? std::vector<std::size_t>{1024} : std::vector<std::size_t>{64, 1024, 16384};
+
+    printf("%-44s%14s  %s\n", "benchmark", "value", "unit");
+    auto record = [&](std::string name, std::string unit, double value, bool higherIsBetter) {
+        printf("%-44s%14.4g  %s\n", name.c_str(), value, unit.c_str());
+        report.add(std::move(name), std::move(unit), value, higherIsBetter);
+    };
+
+    for (std::size_t n : sizes) {
+        Chain chain(n, S, r, sigma);
+        // at least ~1M calls per figure so small chains are not dominated by timer noise
+        const int reps = static_cast<int>(std::max<std::size_t>(1, (options.quick ? 200000 : 1000000) / n));
+        const std::string suffix = "/n=" + std::to_string(n);
+        auto perOp = [&](auto&& body) { return bestNs(options.trials, [&] { for (int rep = 0; rep < reps; ++rep) body(); }) / static_cast<double>(n * reps); };
+
+        record("calculate" + suffix, "ns/op", perOp([&] {
+            double acc = 0.0;
+            for (std::size_t i = 0; i < n; ++i)
+                if (auto g = BlackScholes::calculate(chain.strikes[i], chain.expiries[i], chain.types[i], S, r, flat)) acc += g->delta;
+            sink = sink + acc;
+        }), false);
+        record("calculatePremium" + suffix, "ns/op", perOp([&] {
+            double acc = 0.0;
+            for (std::size_t i = 0; i < n; ++i) acc += BlackScholes::calculatePremium(chain.strikes[i], chain.expiries[i], chain.types[i], S, r, sigma).value_or(0.0);
+            sink = sink + acc;
+        }), false);
+        record("getVol/parametric" + suffix, "ns/op", perOp([&] {
+            double acc = 0.0;
+            for (std::size_t i = 0; i < n; ++i) acc += smile.getVol(chain.strikes[i], chain.expiries[i], S);
+            sink = sink + acc;
+        }), false);
+
+        // the solver is ~100x the cost of a pricing call, so it gets fewer repetitions
+        const int ivReps = std::max(1, reps / 50);
+        double ivNs = bestNs(options.trials, [&] {
+            for (int rep = 0; rep < ivReps; ++rep) {
+                double acc = 0.0;
+                for (std::size_t i = 0; i < n; ++i)
+                    acc += BlackScholes::calculateIV(Option(chain.strikes[i], chain.expiries[i], chain.types[i]), S, chain.prices[i], r).value_or(0.0);
+                sink = sink + acc;
+            }
+        }) / static_cast<double>(n * ivReps);
+        record("calculateIV" + suffix, "ns/op", ivNs, false);
+    }
+
+    // Simulation throughput by leg count on one thread, then scaling of the four-leg strategy
+    const double T = 60.0 / gbl::TRADING_DAYS;
+    const int paths = options.quick ? 20000 : 100000;
+    auto pathsPerSecond = [&](const Strategy& strat, ThreadPool& pool) {
+        SimulationOptions sim;
+        sim.paths = paths;
+        sim.seed = 11;
+        sim.pool = &pool;
+        double ns = bestNs(options.trials, [&] {
+            result res = OptionWizard::simulateStrategy(strat, S, S * 1.02, 20.0, r, smile, 0.08, sigma, sim);
+            sink = sink + res.expectedValue;
+        });
+        return static_cast<double>(paths) / (ns * 1e-9);
+    };
+
+    ThreadPool single(1);
+    for (int legs : {1, 2, 4, 8})
+        record("simulateStrategy/legs=" + std::to_string(legs), "paths/s", pathsPerSecond(ladder(S, T, legs), single), true);
+
+    std::vector<unsigned> threadCounts{1};
+    for (unsigned t = 2; t <= report.hardwareThreads; t *= 2) threadCounts.push_back(t);
+    if (threadCounts.back() != report.hardwareThreads) threadCounts.push_back(report.hardwareThreads);
+
+    const Strategy condor = ladder(S, T, 4);
+    double base = 0.0;
+    for (unsigned t : threadCounts) {
+        ThreadPool pool(t);
+        double rate = pathsPerSecond(condor, pool);
+        if (t == 1) base = rate;
+        const std::string suffix = "/threads=" + std::to_string(t);
+        record("simulateStrategy/legs=4" + suffix, "paths/s", rate, true);
+        // paths/s per thread relative to one thread; 1.0 is perfect scaling
+        if (t > 1) record("scalingEfficiency" + suffix, "ratio", rate / (base * t), true);
+    }
+
+    // the batch runner on generated CSV records, analytic and written to memory
+    std::ostringstream records;
+    records << "spot,target,targetDays,expiryDays,marketPrice\n";
+    const int scenarios = options.quick ? 100 : 500;
+    for (int i = 0; i < scenarios; ++i) {
+        const double spot = 20.0 + 5.0 * (i % 97);
+        records << spot << "," << spot * (0.95 + 0.001 * (i % 101)) << "," << 1 + i % 40 << "," << 41 + i % 30 << "," << spot * 0.03 << "\n";
+    }
+    const std::string input = records.str();
+    double batchNs = bestNs(options.trials, [&] {
+        std::istringstream in(input);
+        std::ostringstream out;
+        ScenarioRunner::run(in, RecordFormat::Csv, out, RecordFormat::Csv);
+        sink = sink + static_cast<double>(out.str().size());
+    });
+    record("scenarioRunner/analytic", "scenarios/s", scenarios / (batchNs * 1e-9), true);
+
+    // a chain file: CSV conversion, then opening it and solving every quote in place
+    const std::size_t quotes = options.quick ? 20000 : 200000;
+    std::ostringstream chainCsv;
+    chainCsv << "symbol,spot,strike,expiryDays,type,bid,ask\n";
+    for (std::size_t i = 0; i < quotes; ++i) {
+        const double spot = 50.0 + static_cast<double>(i % 40);
+        const double strike = spot * (0.8 + 0.4 * static_cast<double>(i % 41) / 40.0);
+        const double days = 5.0 + static_cast<double>((i / 41) % 24) * 10.0;
+        const OptionType type = (i / 984) % 2 == 0 ? OptionType::Call : OptionType::Put;
+        const double price = BlackScholes::calculatePremium(strike, days / gbl::TRADING_DAYS, type, spot, 0.05, 0.3).value_or(0.0);
+        chainCsv << "U" << i % 40 << "," << spot << "," << strike << "," << days << "," << (type == OptionType::Call ? "C" : "P") << ","
+                 << price * 0.99 << "," << price * 1.01 << "\n";
+    }
+    const std::string chainText = chainCsv.str();
+    const std::string chainPath = (std::filesystem::temp_directory_path() / "options_bench_chain.owc").string();
+    double convertNs = bestNs(options.trials, [&] {
+        std::istringstream in(chainText);
+        sink = sink + static_cast<double>(ChainFile::convertCsv(in, chainPath));
+    });
+    std::vector<double> chainVols(quotes);
+    std::vector<IVStatus> chainStatus(quotes);
+    double openNs = bestNs(options.trials, [&] {
+        ChainFile chain = ChainFile::open(chainPath);
+        sink = sink + chain.mids()[chain.size() - 1];
+    });
+    double solveNs = bestNs(options.trials, [&] {
+        ChainFile chain = ChainFile::open(chainPath);
+        sink = sink + static_cast<double>(ImpliedVolatility::solveBatch(chain.quotes(), chainVols, chainStatus));
+    });
+    std::filesystem::remove(chainPath);
+    const std::string chainSuffix = "/rows=" + std::to_string(quotes);
+    record("chainFile/convertCsv" + chainSuffix, "rows/s", static_cast<double>(quotes) / (convertNs * 1e-9), true);
+    record("chainFile/open" + chainSuffix, "us", openNs * 1e-3, false);
+    record("chainFile/open+solveIV" + chainSuffix, "ns/quote", solveNs / static_cast<double>(quotes), false);
+
+    // a risk grid of an iron condor against pricing each cell's legs one by one
+    RiskGridAxes gridAxes;
+    const std::size_t gridSpots = options.quick ? 41 : 201;
+    for (std::size_t i = 0; i < gridSpots; ++i) gridAxes.spotShocks.push_back(-0.2 + 0.4 * static_cast<double>(i) / static_cast<double>(gridSpots - 1));
+    for (int i = -5; i <= 5; ++i) gridAxes.volShifts.push_back(0.02 * i);
+    for (int i = 0; i < 20; ++i) gridAxes.daysForward.push_back(i);
+    const double gridCells = static_cast<double>(gridSpots * gridAxes.volShifts.size() * gridAxes.daysForward.size());
+    Strategy gridCondor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, 30.0 / gbl::TRADING_DAYS);
+    ParametricVolatility gridVols(0.25, -0.3, 1.5);
+    double gridNs = bestNs(options.trials, [&] {
+        RiskGrid grid(gridCondor, 100.0, 0.05, gridVols, gridAxes);
+        sink = sink + grid.pnl()[grid.pnl().size() - 1];
+    });
+    double naiveNs = bestNs(options.trials, [&] {
+        for (double days : gridAxes.daysForward)
+            for (double shift : gridAxes.volShifts)
+                for (double shock : gridAxes.spotShocks)
+                    for (const StrategyLeg& leg : gridCondor.getLegs()) {
+                        const double S = 100.0 * (1.0 + shock), K = leg.option.getStrike();
+                        const double T = leg.option.getTimeToExpiry() - days / gbl::TRADING_DAYS;
+                        const double sigma = gridVols.getVol(K, T, S) + shift;
+                        sink = sink + BlackScholes::calculatePremium(K, T, leg.option.getType(), S, 0.05, sigma).value_or(0.0);
+                    }
+    });
+    record("riskGrid/ironCondor", "ns/cell", gridNs / gridCells, false);
+    record("riskGrid/perCellPricing", "ns/cell", naiveNs / gridCells, false);
+
+    // a book of netted positions: bulk load, one-strategy updates and a full reprice
+    const std::size_t bookPositions = options.quick ? 10000 : 100000;
+    std::vector<BookPosition> positions(bookPositions);
+    for (std::size_t i = 0; i < bookPositions; ++i)
+        positions[i] = {50.0 + 0.5 * static_cast<double>(i % 200), (5.0 + static_cast<double>((i / 200) % 50) * 5.0) / gbl::TRADING_DAYS,
+                        (i / 10000) % 2 == 0 ? OptionType::Call : OptionType::Put, i % 2 == 0 ? 1.0 : -2.0};
+    double loadNs = bestNs(options.trials, [&] {
+        PortfolioBook book(100.0, 0.05, gridVols);
+        book.add(positions);
+        sink = sink + book.totals().delta;
+    });
+    PortfolioBook book(100.0, 0.05, gridVols);
+    book.add(positions);
+    const std::size_t bookRows = book.size();
+    const std::size_t updates = 1000;
+    double updateNs = bestNs(options.trials, [&] {
+        for (std::size_t i = 0; i < updates; ++i) book.add(gridCondor, i % 2 == 0 ? 1.0 : -1.0);
+        sink = sink + book.totals().vega;
+    });
+    double repriceNs = bestNs(options.trials, [&] { sink = sink + static_cast<double>(book.reprice(101.0, 0.05)); });
+    const std::string bookSuffix = "/rows=" + std::to_string(bookRows);
+    record("portfolioBook/load", "ns/position", loadNs / static_cast<double>(bookPositions), false);
+    record("portfolioBook/strategyUpdate" + bookSuffix, "ns/update", updateNs / static_cast<double>(updates), false);
+    record("portfolioBook/reprice" + bookSuffix, "ns/row", repriceNs / static_cast<double>(bookRows), false);
+
+    // spot ticks on the default strategy set: cached invariants against calculate() per leg
+    std::vector<Strategy> tickStrategies = ScenarioRunner::strategies(100.0, 30.0);
+    TickRepricer repricer(tickStrategies, 100.0, 0.05, gridVols);
+    std::vector<Tick> ticks(options.quick ? 20000 : 200000);
+    for (std::size_t i = 0; i < ticks.size(); ++i) ticks[i] = {static_cast<double>(i), 100.0 * (1.0 + 0.02 * std::sin(0.001 * static_cast<double>(i)))};
+    LatencyReport latency = TickReplay::replay(repricer, ticks);
+    double tickNs = bestNs(options.trials, [&] {
+        for (const Tick& tick : ticks) sink = sink + repricer.onTick(tick.spot).delta;
+    });
+    double recalcNs = bestNs(options.trials, [&] {
+        for (std::size_t i = 0; i < ticks.size(); i += 10)
+            for (const Strategy& strategy : tickStrategies)
+                for (const StrategyLeg& leg : strategy.getLegs())
+                    sink = sink + BlackScholes::calculate(leg.option.getStrike(), leg.option.getTimeToExpiry(), leg.option.getType(), ticks[i].spot, 0.05, gridVols)->delta;
+    });
+    const std::string tickSuffix = "/legs=" + std::to_string(repricer.size());
+    record("tickRepricer/update" + tickSuffix, "ns/tick", tickNs / static_cast<double>(ticks.size()), false);
+    record("tickRepricer/perLegCalculate" + tickSuffix, "ns/tick", recalcNs / static_cast<double>((ticks.size() + 9) / 10), false);
+    record("tickRepricer/replayP99" + tickSuffix, "ns", latency.p99Ns, false);
+
+    // strategy search: held to expiry (closed-form screen) and with legs alive at the horizon
+    StrategySearchSpace searchSpace;
+    for (double K = 80.0; K <= 120.0; K += options.quick ? 4.0 : 2.0) searchSpace.strikes.push_back(K);
+    OptimizerOptions optimizer;
+    optimizer.survivors = 50;
+    optimizer.simulation.paths = options.quick ? 5000 : 20000;
+    optimizer.simulation.seed = 1;
+    optimizer.constraints.maxLoss = 10.0;
+    for (const auto& [label, expiries] : {std::pair<const char*, std::vector<double>>{"holdToExpiry", {20.0}}, {"aliveAtHorizon", {20.0, 40.0}}}) {
+        searchSpace.expiryDays = expiries;
+        std::size_t candidates = 0;
+        double searchNs = bestNs(options.trials, [&] {
+            OptimizerSummary summary = StrategyOptimizer::search(searchSpace, 100.0, 104.0, 20.0, 0.05, gridVols, 0.08, 0.25, optimizer);
+            candidates = summary.candidates;
+            sink = sink + summary.ranked.front().score;
+        });
+        record(std::string("optimizer/") + label + "/candidates=" + std::to_string(candidates), "candidates/s",
+               static_cast<double>(candidates) / (searchNs * 1e-9), true);
+    }
+
+    // American PDE: one put on the default 401 x 200 grid, and a batch of independent options
+    PdeOptions pde;
+    const std::string pdeSuffix = "/grid=" + std::to_string(pde.spotNodes) + "x" + std::to_string(pde.timeSteps);
+    for (bool american : {false, true}) {
+        pde.american = american;
+        double solveNs = bestNs(options.trials, [&] { sink = sink + PdeSolver::solve(100.0, 0.5, OptionType::Put, 100.0, 0.05, 0.25, pde).values[200]; });
+        record(std::string("pde/") + (american ? "americanPut" : "europeanPut") + pdeSuffix, "us/solve", solveNs * 1e-3, false);
+    }
+    std::vector<Option> pdeOptions;
+    for (std::size_t i = 0; i < (options.quick ? 16u : 128u); ++i)
+        pdeOptions.emplace_back(80.0 + static_cast<double>(i % 41), (10.0 + static_cast<double>(i % 7) * 20.0) / gbl::TRADING_DAYS, i % 2 == 0 ? OptionType::Put : OptionType::Call);
+    double pdeBatchNs = bestNs(options.trials, [&] { sink = sink + PdeSolver::solveBatch(pdeOptions, 100.0, 0.05, gridVols, pde).back().values[200]; });
+    record("pde/solveBatch" + pdeSuffix, "options/s", static_cast<double>(pdeOptions.size()) / (pdeBatchNs * 1e-9), true);
+
+    // MC sensitivities: one pass with all eight derivatives against the plain valuation
+    SimulationOptions sensitivityRun;
+    sensitivityRun.paths = paths;
+    sensitivityRun.seed = 11;
+    sensitivityRun.pool = &single;
+    auto simulationNs = [&](bool sensitivities) {
+        sensitivityRun.sensitivities = sensitivities;
+        return bestNs(options.trials, [&] { sink = sink + OptionWizard::simulateStrategy(gridCondor, 100.0, 100.0, 20.0, 0.05, gridVols, 0.08, 0.25, sensitivityRun).expectedValue; });
+    };
+    const double plainNs = simulationNs(false);
+    record("simulateStrategy/sensitivities/overhead", "ratio", simulationNs(true) / plainNs, false);
+
+    // Candidate scan held to expiry, analytic: generating and valuing Strategy objects against
+    // compact ones in a reused book and result buffer, with heap allocations per strategy
+    const std::size_t scanSize = options.quick ? 1024 : 8192;
+    const double scanExpiry = 20.0 / gbl::TRADING_DAYS;
+    SimulationOptions scanOptions;
+    scanOptions.analytic = true;
+    auto scanStrikes = [](std::size_t i) {
+        const double low = 70.0 + static_cast<double>(i % 40), width = 1.0 + static_cast<double>(i / 40 % 10);
+        return std::array<double, 4>{low, low + width, low + 2.0 * width, low + 3.0 * width};
+    };
+    auto strategyScan = [&] {
+        std::vector<Strategy> strategies;
+        for (std::size_t i = 0; i < scanSize; ++i) {
+            const auto K = scanStrikes(i);
+            strategies.push_back(Strategy::ironCondor(K[0], K[1], K[2], K[3], scanExpiry));
+        }
+        sink = sink + OptionWizard::simulateStrategies(strategies, 100.0, 100.0, 20.0, 0.05, gridVols, 0.08, 0.25, scanOptions).back().pop;
+    };
+    StrategyBook scanBook;
+    std::vector<CompactResult> scanResults(scanSize);
+    const StrategyName condorName = StrategyName::intern("Iron Condor");
+    auto compactScan = [&] {
+        scanBook.clear();
+        for (std::size_t i = 0; i < scanSize; ++i) {
+            const auto K = scanStrikes(i);
+            CompactStrategy& condor = scanBook.add(condorName);
+            condor.addLeg(Option(K[1], scanExpiry, OptionType::Put), -1);
+            condor.addLeg(Option(K[0], scanExpiry, OptionType::Put), 1);
+            condor.addLeg(Option(K[2], scanExpiry, OptionType::Call), -1);
+            condor.addLeg(Option(K[3], scanExpiry, OptionType::Call), 1);
+        }
+        OptionWizard::simulateStrategies(scanBook.strategies(), 100.0, 100.0, 20.0, 0.05, gridVols, 0.08, 0.25, scanOptions, scanResults);
+        sink = sink + scanResults.back().pop;
+    };
+    for (const auto& [label, scan] : {std::pair<const char*, std::function<void()>>{"strategy", strategyScan}, {"compactStrategy", compactScan}}) {
+        scan();   // warm the reused buffers
+        const std::uint64_t before = allocationCount();
+        scan();
+        const double allocationsPerStrategy = static_cast<double>(allocationCount() - before) / static_cast<double>(scanSize);
+        const double scanNs = bestNs(options.trials, scan);
+        const std::string scanSuffix = std::string("/") + label + "/n=" + std::to_string(scanSize);
+        record("scan" + scanSuffix, "strategies/s", static_cast<double>(scanSize) / (scanNs * 1e-9), true);
+        record("scan/allocations" + scanSuffix, "allocs/strategy", allocationsPerStrategy, false);
+    }
+    return report;
+}
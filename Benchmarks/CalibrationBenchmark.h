@@ -0,0 +1,83 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/ImpliedVolatility.h"
+#include "../Headers/SviVolatility.h"
+
+// Calibrates SSVI to a synthetic 10,000-quote chain (20 expiries x 500 strikes), cold and as
+// an intraday refit warm-started from the previous surface
+inline void runCalibrationBenchmark() {
+
+    constexpr std::size_t EXPIRIES = 20;
+    constexpr std::size_t STRIKES = 500;
+    std::vector<SviSlice> truth;
+    for (std::size_t i = 0; i < EXPIRIES; ++i) {
+        double T = 0.02 + 1.98 * static_cast<double>(i) / (EXPIRIES - 1);
+        double theta = 0.22 * 0.22 * T;
+        truth.push_back({T, theta, -0.5, 1.0 * std::pow(theta, 0.55) * std::pow(1.0 + theta, -0.55)});
+    }
+    SviVolatility surface(truth);
+
+    auto makeChain = [&](double spot, double elapsed, std::vector<double>& strikes, std::vector<double>& expiries,
+                         std::vector<OptionType>& types, std::vector<double>& prices) {
+        for (const SviSlice& slice : truth) {
+            double T = slice.expiry - elapsed;
+            double width = 3.0 * std::sqrt(slice.theta);
+            for (std::size_t j = 0; j < STRIKES; ++j) {
+                double K = 100.0 * std::exp(-width + 2.0 * width * static_cast<double>(j) / (STRIKES - 1));
+                OptionType type = K < spot ? OptionType::Put : OptionType::Call;
+                strikes.push_back(K);
+                expiries.push_back(T);
+                types.push_back(type);
+                prices.push_back(BlackScholes::calculatePremium(K, T, type, spot, 0.03, surface.getVol(K, T, spot)).value_or(0.0));
+            }
+        }
+    };
+
+    std::vector<double> strikes, expiries, prices, laterStrikes, laterExpiries, laterPrices;
+    std::vector<OptionType> types, laterTypes;
+    makeChain(100.0, 0.0, strikes, expiries, types, prices);
+    makeChain(100.3, 0.25 / (252.0 * 6.5), laterStrikes, laterExpiries, laterTypes, laterPrices);
+    std::size_t n = strikes.size();
+    std::vector<double> spots(n, 100.0), laterSpots(n, 100.3), rates(n, 0.03);
+    QuoteInputs quotes{strikes, expiries, types, spots, rates, prices};
+    QuoteInputs laterQuotes{laterStrikes, laterExpiries, laterTypes, laterSpots, rates, laterPrices};
+
+    using clock = std::chrono::steady_clock;
+    auto ms = [](clock::duration d) { return std::chrono::duration<double, std::milli>(d).count(); };
+    auto summary = [](const SviCalibration& c, int& iterations, double& worst) {
+        iterations = 0;
+        worst = 0.0;
+        for (const SviSliceFit& fit : c.fits) {
+            iterations += fit.iterations;
+            worst = std::max(worst, fit.rmsError);
+        }
+    };
+
+    std::vector<double> vols(n);
+    std::vector<IVStatus> status(n);
+    auto start = clock::now();
+    ImpliedVolatility::solveBatch(quotes, vols, status);
+    double ivMs = ms(clock::now() - start);
+
+    start = clock::now();
+    SviCalibration cold = SviCalibrator::calibrate(quotes);
+    double coldMs = ms(clock::now() - start);
+    start = clock::now();
+    SviCalibration warm = SviCalibrator::calibrate(laterQuotes, &cold.surface);
+    double warmMs = ms(clock::now() - start);
+
+    int coldIterations = 0, warmIterations = 0;
+    double coldError = 0.0, warmError = 0.0;
+    summary(cold, coldIterations, coldError);
+    summary(warm, warmIterations, warmError);
+
+    printf("%-28s%12s%12s%14s\n", "SSVI calibration (10k)", "ms", "LM iters", "worst rms vol");
+    printf("%-28s%12.2f%12s%14s\n", "implied vols only", ivMs, "-", "-");
+    printf("%-28s%12.2f%12d%14.2e\n", "cold", coldMs, coldIterations, coldError);
+    printf("%-28s%12.2f%12d%14.2e\n", "warm refit (spot +0.3%)", warmMs, warmIterations, warmError);
+}
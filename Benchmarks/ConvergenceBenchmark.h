@@ -0,0 +1,60 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+// The Monte Carlo convergence check as a rate: RMS error of the discounted expected value
+// against Black-Scholes over many seeds, per path count and variance-reduction mode
+inline void runConvergenceBenchmark() {
+
+    double S = 100.0, K = 100.0, T = 1.0, r = 0.05, sigma = 0.2;
+    double horizon = 0.5;
+    double bsPrice = BlackScholes::calculatePremium(K, T, OptionType::Call, S, r, sigma).value_or(0.0);
+    Strategy call = Strategy::longCall(K, T);
+    ParametricVolatility volModel(sigma, 0.0, 0.0);
+    const int seeds = 16;
+
+    struct Mode { const char* name; bool quasiRandom; bool controlVariates; };
+    const std::vector<Mode> modes = {{"antithetic", false, false}, {"Sobol", true, false},
+                                     {"control var.", false, true}, {"Sobol + CV", true, true}};
+
+    printf("%-12s", "RMS error");
+    for (const Mode& mode : modes) printf("%14s", mode.name);
+    printf("\n");
+
+    std::vector<double> firstError(modes.size()), lastError(modes.size());
+    const int minLog = 10, maxLog = 17;
+    for (int logPaths = minLog; logPaths <= maxLog; ++logPaths) {
+        printf("%-12d", 1 << logPaths);
+        for (std::size_t m = 0; m < modes.size(); ++m) {
+            SimulationOptions options;
+            options.paths = 1 << logPaths;
+            options.quasiRandom = modes[m].quasiRandom;
+            options.controlVariates = modes[m].controlVariates;
+
+            double squares = 0.0;
+            for (int seed = 0; seed < seeds; ++seed) {
+                options.seed = 1000 + seed;
+                result res = OptionWizard::simulateStrategy(call, S, S, horizon * gbl::TRADING_DAYS, r, volModel, r, sigma, options);
+                double error = res.expectedValue * std::exp(-r * horizon) - bsPrice;
+                squares += error * error;
+            }
+            double rms = std::sqrt(squares / seeds);
+            if (logPaths == minLog) firstError[m] = rms;
+            if (logPaths == maxLog) lastError[m] = rms;
+            printf("%14.2e", rms);
+        }
+        printf("\n");
+    }
+
+    // slope of log(error) against log(paths); plain Monte Carlo is -0.5
+    printf("%-12s", "rate");
+    for (std::size_t m = 0; m < modes.size(); ++m)
+        printf("%14.2f", std::log(lastError[m] / firstError[m]) / std::log(std::pow(2.0, maxLog - minLog)));
+    printf("\n");
+}
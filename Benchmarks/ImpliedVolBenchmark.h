@@ -0,0 +1,63 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <cstdio>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/ImpliedVolatility.h"
+#include "../Headers/Option.h"
+
+// Inverts a synthetic 5,000-quote chain with calculateIV and with the batch solver
+inline void runImpliedVolBenchmark() {
+
+    double S = 100.0;
+    double r = 0.05;
+    std::size_t n = 5000;
+    std::vector<double> strikes(n), expiries(n), spots(n, S), rates(n, r), prices(n);
+    std::vector<OptionType> types(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        strikes[i] = 60.0 + 80.0 * static_cast<double>(i % 250) / 250.0;
+        expiries[i] = 0.05 + 2.0 * static_cast<double>(i / 250) / 20.0;
+        types[i] = (strikes[i] >= S) ? OptionType::Call : OptionType::Put;
+        double sigma = 0.25 - 0.1 * std::log(strikes[i] / S);
+        prices[i] = BlackScholes::calculatePremium(strikes[i], expiries[i], types[i], S, r, sigma).value_or(0.0);
+    }
+
+    using clock = std::chrono::steady_clock;
+    auto nsPerQuote = [n](clock::duration d, int reps) {
+        return std::chrono::duration<double, std::nano>(d).count() / static_cast<double>(n * reps);
+    };
+
+    auto start = clock::now();
+    double sink = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        Option option(strikes[i], expiries[i], types[i]);
+        sink += BlackScholes::calculateIV(option, S, prices[i], r).value_or(0.0);
+    }
+    double scalarNs = nsPerQuote(clock::now() - start, 1);
+
+    std::vector<double> vols(n);
+    std::vector<IVStatus> status(n);
+    QuoteInputs quotes{strikes, expiries, types, spots, rates, prices};
+    ImpliedVolatility::solveBatchInline(quotes, vols, status); // warm-up
+
+    constexpr int REPS = 20;
+    start = clock::now();
+    for (int rep = 0; rep < REPS; ++rep)
+        ImpliedVolatility::solveBatchInline(quotes, vols, status);
+    double batchNs = nsPerQuote(clock::now() - start, REPS);
+
+    start = clock::now();
+    for (int rep = 0; rep < REPS; ++rep)
+        ImpliedVolatility::solveBatch(quotes, vols, status);
+    double threadedNs = nsPerQuote(clock::now() - start, REPS);
+
+    printf("%-28s%12s\n", "Implied vol (5000 quotes)", "ns/quote");
+    printf("%-28s%12.1f\n", "calculateIV", scalarNs);
+    printf("%-28s%12.1f\n", "solveBatch (1 thread)", batchNs);
+    printf("%-28s%12.1f\n", "solveBatch (all threads)", threadedNs);
+    printf("%-28s%12.1fx\n", "speed-up (1 thread)", scalarNs / batchNs);
+    if (sink < 0) std::cout << sink;
+}
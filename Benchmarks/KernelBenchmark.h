@@ -0,0 +1,69 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/PricingKernel.h"
+#include "../Headers/Simd.h"
+#include "../Headers/VolatilitySurface.h"
+
+// Cost per option of each kernel variant on the native vector width, and of the scalar wrappers
+inline void runKernelBenchmark() {
+
+    using V = simd::NativeD;
+    constexpr std::size_t N = 4096;
+    constexpr int REPS = 200;
+    std::vector<double> strikes(N), expiries(N), spots(N, 100.0), rates(N, 0.04), vols(N), out(N);
+    std::vector<double> callLanes(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        strikes[i] = 60.0 + 80.0 * static_cast<double>(i % 97) / 97.0;
+        expiries[i] = 0.02 + static_cast<double>(i % 13) / 13.0;
+        vols[i] = 0.15 + 0.3 * static_cast<double>(i % 7) / 7.0;
+        callLanes[i] = (i % 2 == 0) ? 1.0 : 0.0;
+    }
+
+    using clock = std::chrono::steady_clock;
+    auto nsPerOption = [&](auto&& kernel) {
+        auto start = clock::now();
+        for (int rep = 0; rep < REPS; ++rep) {
+            for (std::size_t i = 0; i + V::width <= N; i += V::width) {
+                GreeksOf<V> g = kernel(i, V::load(&strikes[i]), V::load(&expiries[i]), V::load(&spots[i]), V::load(&rates[i]), V::load(&vols[i]));
+                (g.premium + g.delta + g.gamma + g.theta + g.vega + g.rho).store(&out[i]);
+            }
+        }
+        return std::chrono::duration<double, std::nano>(clock::now() - start).count() / static_cast<double>(N * REPS);
+    };
+
+    printf("%-32s%12s\n", "Black-Scholes kernel", "ns/option");
+    printf("%-32s%12.2f\n", "all, mixed types", nsPerOption([&](std::size_t i, V K, V T, V S, V r, V sigma) {
+        return blackScholesKernel<greek::All>(V::load(&callLanes[i]) > V::broadcast(0.0), K, T, S, r, sigma);
+    }));
+    printf("%-32s%12.2f\n", "all, calls", nsPerOption([](std::size_t, V K, V T, V S, V r, V sigma) {
+        return blackScholesKernel<OptionType::Call, greek::All>(K, T, S, r, sigma);
+    }));
+    printf("%-32s%12.2f\n", "premium + vega, calls", nsPerOption([](std::size_t, V K, V T, V S, V r, V sigma) {
+        return blackScholesKernel<OptionType::Call, greek::Premium | greek::Vega>(K, T, S, r, sigma);
+    }));
+    printf("%-32s%12.2f\n", "premium, calls", nsPerOption([](std::size_t, V K, V T, V S, V r, V sigma) {
+        return blackScholesKernel<OptionType::Call, greek::Premium>(K, T, S, r, sigma);
+    }));
+    printf("%-32s%12.2f\n", "delta + gamma, calls", nsPerOption([](std::size_t, V K, V T, V S, V r, V sigma) {
+        return blackScholesKernel<OptionType::Call, greek::Delta | greek::Gamma>(K, T, S, r, sigma);
+    }));
+
+    // scalar wrappers, one option per call
+    FlatVolatility flat(0.25);
+    double sink = 0.0;
+    auto start = clock::now();
+    for (std::size_t i = 0; i < N; ++i)
+        sink += BlackScholes::calculate(strikes[i], expiries[i], OptionType::Call, 100.0, 0.04, flat)->premium;
+    double fullNs = std::chrono::duration<double, std::nano>(clock::now() - start).count() / N;
+    start = clock::now();
+    for (std::size_t i = 0; i < N; ++i)
+        sink += BlackScholes::calculatePremium(strikes[i], expiries[i], OptionType::Call, 100.0, 0.04, 0.25).value_or(0.0);
+    double premiumNs = std::chrono::duration<double, std::nano>(clock::now() - start).count() / N;
+    printf("%-32s%12.2f\n", "calculate (scalar)", fullNs);
+    printf("%-32s%12.2f\n", "calculatePremium (scalar)", premiumNs);
+    if (sink < 0) std::cout << sink;
+}
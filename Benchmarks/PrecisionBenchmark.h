@@ -0,0 +1,61 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include <cstdio>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+#include "../Tests/SinglePrecisionTest.h"
+
+// Error report of the single-precision tier over the accuracy grid, and its throughput
+// against double for batch pricing and simulation
+inline void runPrecisionBenchmark() {
+
+    printf("%-20s%16s%16s\n", "float vs double", "max abs error", "max rel error");
+    for (const PrecisionErrors& e : comparePricingPrecision())
+        printf("%-20s%16.2e%16.2e\n", e.output, e.maxAbsolute, e.maxRelative);
+
+    constexpr std::size_t N = 8192;
+    constexpr int REPS = 100;
+    std::vector<double> strikes(N), expiries(N), spots(N, 100.0), rates(N, 0.04), vols(N), premium(N), delta(N), gamma(N), theta(N), vega(N), rho(N);
+    std::vector<OptionType> types(N);
+    std::vector<std::uint8_t> valid(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        strikes[i] = 60.0 + 80.0 * static_cast<double>(i % 97) / 97.0;
+        expiries[i] = 0.02 + static_cast<double>(i % 13) / 13.0;
+        vols[i] = 0.15 + 0.3 * static_cast<double>(i % 7) / 7.0;
+        types[i] = (i < N / 2) ? OptionType::Call : OptionType::Put;
+    }
+    ChainInputs chain{strikes, expiries, types, spots, rates, vols};
+
+    auto nsPerOption = [&](const GreeksBatch& outputs, Precision precision) {
+        auto start = std::chrono::steady_clock::now();
+        for (int rep = 0; rep < REPS; ++rep) BlackScholes::calculateBatch(chain, outputs, valid, precision);
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (N * REPS);
+    };
+    GreeksBatch all{premium, delta, gamma, theta, vega, rho};
+    GreeksBatch premiumOnly{.premium = premium};
+
+    printf("%-20s%16s%16s%10s\n", "calculateBatch", "double (ns)", "float (ns)", "speed-up");
+    double allDouble = nsPerOption(all, Precision::Double), allSingle = nsPerOption(all, Precision::Single);
+    double premiumDouble = nsPerOption(premiumOnly, Precision::Double), premiumSingle = nsPerOption(premiumOnly, Precision::Single);
+    printf("%-20s%16.2f%16.2f%9.1fx\n", "all outputs", allDouble, allSingle, allDouble / allSingle);
+    printf("%-20s%16.2f%16.2f%9.1fx\n", "premium", premiumDouble, premiumSingle, premiumDouble / premiumSingle);
+
+    ParametricVolatility volModel(0.25, -0.2, 1.0);
+    Strategy condor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, 60.0 / gbl::TRADING_DAYS);
+    auto simulateMs = [&](Precision precision) {
+        SimulationOptions options;
+        options.seed = 3;
+        options.precision = precision;
+        auto start = std::chrono::steady_clock::now();
+        OptionWizard::simulateStrategy(condor, 100.0, 102.0, 20.0, 0.05, volModel, 0.08, 0.25, options);
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+    double simDouble = simulateMs(Precision::Double), simSingle = simulateMs(Precision::Single);
+    printf("%-20s%16s%16s%10s\n", "simulateStrategy", "double (ms)", "float (ms)", "speed-up");
+    printf("%-20s%16.2f%16.2f%9.1fx\n", "iron condor", simDouble, simSingle, simDouble / simSingle);
+}
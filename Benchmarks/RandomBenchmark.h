@@ -0,0 +1,35 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include "../Headers/Random.h"
+
+// Normal draws per second for each generator, filling a simulation-sized block at a time
+inline void runRandomBenchmark() {
+
+    constexpr std::size_t BLOCK = 2048;
+    constexpr std::size_t DRAWS = 1 << 22;
+    std::vector<double> draws(BLOCK);
+
+    auto drawsPerSecond = [&](const INormalGenerator& generator) {
+        double sum = 0.0;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t first = 0; first < DRAWS; first += BLOCK) {
+            generator.fill(0, first, draws);
+            sum += draws[0];
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (sum != sum) std::cout << sum;
+        return static_cast<double>(DRAWS) / std::chrono::duration<double>(elapsed).count();
+    };
+
+    PhiloxNormalGenerator philox(1);
+    MersenneNormalGenerator mersenne;
+    double philoxRate = drawsPerSecond(philox);
+    double mersenneRate = drawsPerSecond(mersenne);
+
+    printf("%-20s%18s\n", "normal generator", "draws/s (M)");
+    printf("%-20s%18.1f\n", "Philox (SIMD)", philoxRate / 1e6);
+    printf("%-20s%18.1f\n", "mt19937", mersenneRate / 1e6);
+}
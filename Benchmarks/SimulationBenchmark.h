@@ -0,0 +1,127 @@
+#pragma once
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <cstdio>
+#include <cmath>
+#include <string>
+#include "../Headers/OptionWizard.h"
+#include "../Headers/ThreadPool.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+#include "../Headers/Instrumentation.h"
+
+// Times simulateStrategy for the interactive strategy set under different SimulationOptions
+inline void runSimulationBenchmark() {
+
+    double S = 100.0;
+    double T = 60.0 / gbl::TRADING_DAYS;
+    ParametricVolatility volModel(0.25, -0.2, 1.0);
+
+    std::vector<Strategy> strategies;
+    strategies.push_back(Strategy::longCall(S, T));
+    strategies.push_back(Strategy::bullCallSpread(S, S * 1.10, T));
+    strategies.push_back(Strategy::straddle(S, T));
+    strategies.push_back(Strategy::ironCondor(S * 0.90, S * 0.95, S * 1.05, S * 1.10, T));
+
+    auto timeMs = [&](const Strategy& strat, const SimulationOptions& options) {
+        auto start = std::chrono::steady_clock::now();
+        result res = OptionWizard::simulateStrategy(strat, S, S * 1.02, 20.0, 0.05, volModel, 0.08, 0.25, options);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (res.pop < 0) std::cout << res.pop;
+        return std::chrono::duration<double, std::milli>(elapsed).count();
+    };
+
+    SimulationOptions exact;
+    SimulationOptions interpolated;
+    interpolated.interpolateHorizonValue = true;
+
+    printf("%-20s%14s%18s%10s\n", "simulateStrategy", "exact (ms)", "interpolated (ms)", "speed-up");
+    for (const Strategy& strat : strategies) {
+        double exactMs = timeMs(strat, exact);
+        double interpolatedMs = timeMs(strat, interpolated);
+        printf("%-20s%14.2f%18.2f%9.1fx\n", strat.getName().c_str(), exactMs, interpolatedMs, exactMs / interpolatedMs);
+    }
+
+    // the strategy set one at a time against one shared-path pass
+    auto start = std::chrono::steady_clock::now();
+    for (const Strategy& strat : strategies)
+        OptionWizard::simulateStrategy(strat, S, S * 1.02, 20.0, 0.05, volModel, 0.08, 0.25, exact);
+    double separateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    start = std::chrono::steady_clock::now();
+    OptionWizard::simulateStrategies(strategies, S, S * 1.02, 20.0, 0.05, volModel, 0.08, 0.25, exact);
+    double sharedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("%-20s%14s%18s%10s\n", "strategy set", "separate (ms)", "shared paths (ms)", "speed-up");
+    printf("%-20s%14.2f%18.2f%9.1fx\n", "exact", separateMs, sharedMs, separateMs / sharedMs);
+
+    // fixed 100k paths against an adaptive run targeting a one-cent standard error
+    SimulationOptions adaptive;
+    adaptive.paths = 8192;
+    adaptive.targetStandardError = 0.01;
+    printf("%-20s%14s%18s%10s\n", "adaptive (SE $0.01)", "fixed (ms)", "adaptive (ms)", "paths");
+    for (const Strategy& strat : strategies) {
+        double fixedMs = timeMs(strat, exact);
+        double adaptiveMs = timeMs(strat, adaptive);
+        result res = OptionWizard::simulateStrategy(strat, S, S * 1.02, 20.0, 0.05, volModel, 0.08, 0.25, adaptive);
+        printf("%-20s%14.2f%18.2f%10llu\n", strat.getName().c_str(), fixedMs, adaptiveMs, static_cast<unsigned long long>(res.pathsUsed));
+    }
+
+    // closed form / quadrature instead of paths
+    SimulationOptions analytic;
+    analytic.analytic = true;
+    printf("%-20s%14s%18s%10s\n", "analytic", "exact (ms)", "analytic (us)", "speed-up");
+    for (const Strategy& strat : strategies) {
+        double exactMs = timeMs(strat, exact);
+        double analyticMs = timeMs(strat, analytic);
+        printf("%-20s%14.2f%18.1f%9.0fx\n", strat.getName().c_str(), exactMs, analyticMs * 1000.0, exactMs / analyticMs);
+    }
+
+    // the same smile as a market grid, moving with the spot and sticky-strike
+    std::vector<double> nodes, expiries{10.0 / gbl::TRADING_DAYS, 30.0 / gbl::TRADING_DAYS, 60.0 / gbl::TRADING_DAYS}, sampled;
+    for (int k = -10; k <= 10; ++k) nodes.push_back(0.04 * k);
+    for (double t : expiries)
+        for (double m : nodes) sampled.push_back(volModel.getVol(S * std::exp(m), t, S));
+    GridVolatility grid(nodes, expiries, sampled);
+    GridVolatility stickyGrid(nodes, expiries, sampled, GridInterpolation::MonotoneCubic, S);
+    printf("%-20s%14s%18s%18s\n", "vol surface (ms)", "parametric", "grid", "sticky grid");
+    for (const Strategy& strat : strategies) {
+        double surfaceMs[3];
+        const IVolatilitySurface* surfaces[3] = {&volModel, &grid, &stickyGrid};
+        for (int k = 0; k < 3; ++k) {
+            auto begin = std::chrono::steady_clock::now();
+            OptionWizard::simulateStrategy(strat, S, S * 1.02, 20.0, 0.05, *surfaces[k], 0.08, 0.25, exact);
+            surfaceMs[k] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        }
+        printf("%-20s%14.2f%18.2f%18.2f\n", strat.getName().c_str(), surfaceMs[0], surfaceMs[1], surfaceMs[2]);
+    }
+
+    // path-dependent valuation: exit checks on a stepped path
+    printf("%-20s%14s%18s%10s\n", "exit rules", "exact (ms)", "stepped (ms)", "slow-down");
+    for (int steps : {5, 10, 20}) {
+        SimulationOptions stepped;
+        stepped.timeSteps = steps;
+        stepped.takeProfit = 2.0;
+        stepped.stopLoss = 2.0;
+        double exactMs = timeMs(strategies[0], exact);
+        double steppedMs = timeMs(strategies[0], stepped);
+        std::string label = "long call, " + std::to_string(steps) + " steps";
+        printf("%-20s%14.2f%18.2f%9.1fx\n", label.c_str(), exactMs, steppedMs, steppedMs / exactMs);
+    }
+
+    // where the time goes, from SimulationOptions::stats
+    if constexpr (instrument::enabled) {
+        SimulationStats phases;
+        SimulationOptions observed = exact;
+        observed.stats = &phases;
+        printf("%-20s%10s%10s%10s%10s%10s%14s\n", "phases (ms)", "setup", "draws", "value", "reduce", "wall", "paths/s");
+        for (const Strategy& strat : strategies) {
+            OptionWizard::simulateStrategy(strat, S, S * 1.02, 20.0, 0.05, volModel, 0.08, 0.25, observed);
+            printf("%-20s%10.2f%10.2f%10.2f%10.2f%10.2f%14.3g\n", strat.getName().c_str(), phases.setupSeconds * 1e3, phases.drawSeconds * 1e3,
+                   phases.valuationSeconds * 1e3, phases.reductionSeconds * 1e3, phases.wallSeconds * 1e3, phases.pathsPerSecond());
+        }
+    }
+
+    ThreadPoolStats stats = ThreadPool::shared().stats();
+    printf("%-20s%14zu workers, %llu tasks, %llu steals\n", "shared pool", stats.workers,
+           static_cast<unsigned long long>(stats.executed), static_cast<unsigned long long>(stats.steals));
+}
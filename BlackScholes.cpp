@@ -1,83 +1,49 @@
 #include "Headers/BlackScholes.h"
 #include "Headers/Global.h"
 #include "Headers/VolatilitySurface.h"
+#include "Headers/Simd.h"
+#include "Headers/PricingKernel.h"
 #include <cmath>
 #include <algorithm>
-#include <numbers>
 #include <optional>
+#include <stdexcept>
 
-static const double INVERSE_SQUARE_ROOT_2PI = 1.0 / std::sqrt(2.0 * std::numbers::pi);
+namespace {
 
-double BlackScholes::normalPDF(double x) {
-    return (INVERSE_SQUARE_ROOT_2PI) * std::exp(-0.5 * x * x);
+using simd::ScalarD;
+using simd::ScalarF;
+
+// Scalar entry points run the kernels on one lane, typed by a runtime branch
+template <unsigned Mask, class V = ScalarD>
+GreeksOf<V> priceOne(double K, double T, OptionType type, double S, double r, double sigma) {
+    const V k = V::broadcast(K), t = V::broadcast(T), s = V::broadcast(S), rate = V::broadcast(r), vol = V::broadcast(sigma);
+    if (type == OptionType::Call) return blackScholesKernel<OptionType::Call, Mask>(k, t, s, rate, vol);
+    return blackScholesKernel<OptionType::Put, Mask>(k, t, s, rate, vol);
 }
 
-double BlackScholes::normalCDF(double x) {
-    return 0.5 * (1.0 + std::erf(x / std::sqrt(2.0)));
 }
 
-std::optional<Greeks> BlackScholes::calculate(double K, double T, OptionType type, double S, double r, const IVolatilitySurface& volSurface) {
+std::optional<Greeks> BlackScholes::calculate(double K, double T, OptionType type, double S, double r, const IVolatilitySurface& volSurface, Precision precision) {
     double sigma = volSurface.getVol(K, T, S);
     if (T <= 0 || S <= 0 || K <= 0 || sigma < 0) {
         return std::nullopt;
     }
 
-    double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * std::sqrt(T));
-    double d2 = d1 - sigma * std::sqrt(T);
-
-    // pre-calculations
-    double sqrtT = std::sqrt(T);
-    double exp_rT = std::exp(-r * T);
-
-    double pdf_d1 = normalPDF(d1);
-    double cdf_d1 = normalCDF(d1);
-    double cdf_d2 = normalCDF(d2);
-    double cdf_neg_d1 = normalCDF(-d1);
-    double cdf_neg_d2 = normalCDF(-d2);
-
-    Greeks g{};
-
-    g.gamma = pdf_d1 / (S * sigma * sqrtT);
-    g.vega = S * pdf_d1 * sqrtT;
-
-    if(type == OptionType::Call) {
-        g.premium = S * cdf_d1 - K * exp_rT * cdf_d2;
-        g.delta = cdf_d1;
-        g.rho = K * T * exp_rT * cdf_d2 * 0.01; // change per 1% rate
-        g.theta = (double)(-(S * normalPDF(d1) * sigma) / (2 * sqrtT) - r * K * exp_rT * cdf_d2) / gbl::TRADING_DAYS;   // daily theta
-
-    } else { // Put
-        g.premium = K * exp_rT * cdf_neg_d2 - S * cdf_neg_d1;
-        g.delta = cdf_d1 - 1.0;
-        g.rho = -K * T * exp_rT * cdf_neg_d2 * 0.01; // change per 1% rate
-        g.theta = (double)(-(S * normalPDF(d1) * sigma) / (2 * sqrtT) + r * K * exp_rT * cdf_neg_d2) / gbl::TRADING_DAYS;
+    if (precision == Precision::Single) {
+        const GreeksOf<ScalarF> g = priceOne<greek::All, ScalarF>(K, T, type, S, r, sigma);
+        return Greeks{g.premium.v, g.delta.v, g.gamma.v, g.theta.v, g.vega.v, g.rho.v};
     }
-
-    return g;
+    const GreeksOf<ScalarD> g = priceOne<greek::All>(K, T, type, S, r, sigma);
+    return Greeks{g.premium.v, g.delta.v, g.gamma.v, g.theta.v, g.vega.v, g.rho.v};
 }
 
-std::optional<double> BlackScholes::calculatePremium(double K, double T, OptionType type, double S, double r, double sigma) {
+std::optional<double> BlackScholes::calculatePremium(double K, double T, OptionType type, double S, double r, double sigma, Precision precision) {
     if (T <= 0 || S <= 0 || K <= 0 || sigma < 0) {
         return std::nullopt;
     }
 
-    double d1 = (std::log(S / K) + (r + 0.5 * sigma * sigma) * T) / (sigma * std::sqrt(T));
-    double d2 = d1 - sigma * std::sqrt(T);
-
-    // pre-calculations
-    double exp_rT = std::exp(-r * T);
-    double cdf_d1 = normalCDF(d1);
-    double cdf_d2 = normalCDF(d2);
-    double cdf_neg_d1 = normalCDF(-d1);
-    double cdf_neg_d2 = normalCDF(-d2);
-
-    double premium{};
-    if(type == OptionType::Call)
-        premium = S * cdf_d1 - K * exp_rT * cdf_d2;
-    else // Put
-        premium = K * exp_rT * cdf_neg_d2 - S * cdf_neg_d1;
-
-    return premium;
+    if (precision == Precision::Single) return priceOne<greek::Premium, ScalarF>(K, T, type, S, r, sigma).premium.v;
+    return priceOne<greek::Premium>(K, T, type, S, r, sigma).premium.v;
 }
 
 std::optional<double> BlackScholes::calculateIV(const Option& option, double S, double marketPrice, double r) {
@@ -85,13 +51,14 @@ std::optional<double> BlackScholes::calculateIV(const Option& option, double S,
     constexpr double EPSILON = 1e-6;
     double sigma = 0.2;
 
-    for (int i{} ; i < MAX_ITERATIONS; i++) {
-        FlatVolatility tempVol(sigma);
-        std::optional<Greeks> result = calculate(option.getStrike(), option.getTimeToExpiry(), option.getType(), S, r, tempVol);
-        if (!result) return std::nullopt;
+    const double K = option.getStrike();
+    const double T = option.getTimeToExpiry();
+    if (T <= 0 || S <= 0 || K <= 0) return std::nullopt;
 
-        double price = result->premium;
-        double vega = result->vega;
+    for (int i{} ; i < MAX_ITERATIONS; i++) {
+        const GreeksOf<ScalarD> result = priceOne<greek::Premium | greek::Vega>(K, T, option.getType(), S, r, sigma);
+        double price = result.premium.v;
+        double vega = result.vega.v;
 
         double diff = price - marketPrice;
         if (std::abs(diff) < EPSILON) {
@@ -112,9 +79,7 @@ std::optional<double> BlackScholes::calculateIV(const Option& option, double S,
     double high_v = 5.0;
     for (int i = 0; i < 30; ++i) {
         double mid = low_v + (high_v - low_v) / 2.0;
-        FlatVolatility tempVol(mid);
-        std::optional<Greeks> greeks = calculate(option.getStrike(), option.getTimeToExpiry(), option.getType(), S, r, tempVol);
-        double price = greeks ? greeks->premium : 0.0;
+        double price = priceOne<greek::Premium>(K, T, option.getType(), S, r, mid).premium.v;
 
         if (std::abs(price - marketPrice) < EPSILON) return mid;
 
@@ -123,4 +88,108 @@ std::optional<double> BlackScholes::calculateIV(const Option& option, double S,
     }
 
     return (low_v + high_v) / 2.0;
-}
\ No newline at end of file
+}
+
+namespace {
+
+template <unsigned Mask, class V>
+void priceLanes(const ChainInputs& in, const GreeksBatch& out, std::span<std::uint8_t> valid, std::size_t i, std::size_t& validCount) {
+    constexpr std::size_t W = V::width;
+    constexpr unsigned ALL_LANES = (1u << W) - 1u;
+    const V zero = V::broadcast(0.0);
+    const V one = V::broadcast(1.0);
+
+    double callLanes[W];
+    unsigned callBits = 0;
+    for (std::size_t j = 0; j < W; ++j) {
+        const bool call = in.types[i + j] == OptionType::Call;
+        callLanes[j] = call ? 1.0 : 0.0;
+        callBits |= static_cast<unsigned>(call) << j;
+    }
+
+    V K = V::load(&in.strikes[i]);
+    V T = V::load(&in.expiries[i]);
+    V S = V::load(&in.spots[i]);
+    const V r = V::load(&in.rates[i]);
+    V sigma = V::load(&in.vols[i]);
+
+    const auto ok = (K > zero) & (T > zero) & (S > zero) & (sigma > zero);
+    // keep invalid lanes finite, they are zeroed on store
+    K = select(ok, K, one);
+    T = select(ok, T, one);
+    S = select(ok, S, one);
+    sigma = select(ok, sigma, one);
+
+    // chains are usually grouped by type, so most vectors take a single-type kernel
+    GreeksOf<V> g;
+    if (callBits == ALL_LANES) g = blackScholesKernel<OptionType::Call, Mask>(K, T, S, r, sigma);
+    else if (callBits == 0) g = blackScholesKernel<OptionType::Put, Mask>(K, T, S, r, sigma);
+    else g = blackScholesKernel<Mask>(V::load(callLanes) > zero, K, T, S, r, sigma);
+
+    auto store = [&](std::span<double> column, V value) {
+        if (!column.empty()) select(ok, value, zero).store(&column[i]);
+    };
+    if constexpr ((Mask & greek::Premium) != 0) store(out.premium, g.premium);
+    if constexpr ((Mask & greek::Delta) != 0) store(out.delta, g.delta);
+    if constexpr ((Mask & greek::Gamma) != 0) store(out.gamma, g.gamma);
+    if constexpr ((Mask & greek::Theta) != 0) store(out.theta, g.theta);
+    if constexpr ((Mask & greek::Vega) != 0) store(out.vega, g.vega);
+    if constexpr ((Mask & greek::Rho) != 0) store(out.rho, g.rho);
+
+    const unsigned bits = ok.bits();
+    for (std::size_t j = 0; j < W; ++j) {
+        valid[i + j] = static_cast<std::uint8_t>((bits >> j) & 1u);
+        validCount += (bits >> j) & 1u;
+    }
+}
+
+// Wide lanes over the chain, Narrow lanes for the remainder. Float lanes load and store the
+// double columns directly, converting in registers.
+template <unsigned Mask, class Wide, class Narrow>
+std::size_t priceChain(const ChainInputs& inputs, const GreeksBatch& outputs, std::span<std::uint8_t> valid) {
+    const std::size_t n = inputs.strikes.size();
+    std::size_t validCount = 0;
+    std::size_t i = 0;
+    for (; i + Wide::width <= n; i += Wide::width)
+        priceLanes<Mask, Wide>(inputs, outputs, valid, i, validCount);
+    for (; i < n; ++i)
+        priceLanes<Mask, Narrow>(inputs, outputs, valid, i, validCount);
+    return validCount;
+}
+
+template <unsigned Mask>
+std::size_t priceChain(const ChainInputs& inputs, const GreeksBatch& outputs, std::span<std::uint8_t> valid, Precision precision) {
+    if (precision == Precision::Single) return priceChain<Mask, simd::NativeF, simd::ScalarF>(inputs, outputs, valid);
+    return priceChain<Mask, simd::NativeD, simd::ScalarD>(inputs, outputs, valid);
+}
+
+}
+
+std::size_t BlackScholes::calculateBatch(const ChainInputs& inputs, const GreeksBatch& outputs, std::span<std::uint8_t> valid, Precision precision) {
+    const std::size_t n = inputs.strikes.size();
+    auto sized = [n](std::size_t size) { return size == n; };
+    auto sizedOrEmpty = [n](std::size_t size) { return size == n || size == 0; };
+
+    if (!sized(inputs.expiries.size()) || !sized(inputs.types.size()) || !sized(inputs.spots.size())
+        || !sized(inputs.rates.size()) || !sized(inputs.vols.size()) || !sized(valid.size())) {
+        throw std::invalid_argument("ERROR: calculateBatch input sizes differ");
+    }
+    if (!sizedOrEmpty(outputs.premium.size()) || !sizedOrEmpty(outputs.delta.size()) || !sizedOrEmpty(outputs.gamma.size())
+        || !sizedOrEmpty(outputs.theta.size()) || !sizedOrEmpty(outputs.vega.size()) || !sizedOrEmpty(outputs.rho.size())) {
+        throw std::invalid_argument("ERROR: calculateBatch output sizes differ");
+    }
+
+    // the requested columns pick the smallest kernel that covers them
+    unsigned requested = 0;
+    if (!outputs.premium.empty()) requested |= greek::Premium;
+    if (!outputs.delta.empty()) requested |= greek::Delta;
+    if (!outputs.gamma.empty()) requested |= greek::Gamma;
+    if (!outputs.theta.empty()) requested |= greek::Theta;
+    if (!outputs.vega.empty()) requested |= greek::Vega;
+    if (!outputs.rho.empty()) requested |= greek::Rho;
+
+    if ((requested & ~greek::Premium) == 0) return priceChain<greek::Premium>(inputs, outputs, valid, precision);
+    if ((requested & ~(greek::Premium | greek::Vega)) == 0) return priceChain<greek::Premium | greek::Vega>(inputs, outputs, valid, precision);
+    if ((requested & ~(greek::Delta | greek::Gamma)) == 0) return priceChain<greek::Delta | greek::Gamma>(inputs, outputs, valid, precision);
+    return priceChain<greek::All>(inputs, outputs, valid, precision);
+}
@@ -0,0 +1,317 @@
+#include "Headers/ChainFile.h"
+#include "Headers/CsvRecords.h"
+#include "Headers/Global.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <new>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CHAIN_FILE_MMAP 1
+#endif
+
+namespace {
+
+constexpr char MAGIC[8] = {'O', 'W', 'C', 'H', 'A', 'I', 'N', '\0'};
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+constexpr std::uint32_t VERSION = 1;
+constexpr std::size_t ALIGNMENT = 64;
+constexpr std::size_t HEADER_BYTES = 128;
+
+enum Column : std::size_t { Strikes, Expiries, Types, Bids, Asks, Mids, Spots, Rates, Ids, Underlyings, COLUMN_COUNT };
+
+struct FileHeader {
+    char magic[8];
+    std::uint32_t byteOrder;
+    std::uint32_t version;
+    std::uint64_t rows;
+    std::uint64_t underlyings;
+    std::uint64_t offsets[COLUMN_COUNT];   // byte offset of each column, ALIGNMENT-aligned
+};
+static_assert(sizeof(FileHeader) <= HEADER_BYTES);
+
+struct UnderlyingRecord {
+    char symbol[32];   // NUL-terminated
+    double spot;
+    double rate;
+    std::uint64_t first;
+    std::uint64_t count;
+};
+static_assert(sizeof(UnderlyingRecord) == 64);
+
+// the type column is stored as the enum itself so it can be viewed in place
+static_assert(sizeof(OptionType) == sizeof(std::int32_t));
+
+constexpr std::size_t elementBytes(std::size_t column) {
+    switch (column) {
+        case Types: return sizeof(OptionType);
+        case Ids: return sizeof(std::uint32_t);
+        case Underlyings: return sizeof(UnderlyingRecord);
+        default: return sizeof(double);
+    }
+}
+
+std::size_t alignUp(std::size_t bytes) { return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; }
+
+const FileHeader& headerOf(const std::byte* data) { return *reinterpret_cast<const FileHeader*>(data); }
+
+double parseNumber(const std::string& text, const char* name, std::size_t line) {
+    std::size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used == 0 || used != text.size())
+        throw std::invalid_argument("ERROR: line " + std::to_string(line) + ": " + name + " is not a number: " + text);
+    return value;
+}
+
+OptionType parseType(std::string text, std::size_t line) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (text == "c" || text == "call") return OptionType::Call;
+    if (text == "p" || text == "put") return OptionType::Put;
+    throw std::invalid_argument("ERROR: line " + std::to_string(line) + ": type must be C or P: " + text);
+}
+
+}
+
+ChainFile::~ChainFile() {
+    release();
+}
+
+ChainFile::ChainFile(ChainFile&& other) noexcept
+    : data_(other.data_), bytes_(other.bytes_), mapped_(other.mapped_), rows_(other.rows_), underlyings_(other.underlyings_) {
+    other.data_ = nullptr;
+    other.bytes_ = other.rows_ = other.underlyings_ = 0;
+}
+
+ChainFile& ChainFile::operator=(ChainFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(data_, other.data_);
+        std::swap(bytes_, other.bytes_);
+        std::swap(mapped_, other.mapped_);
+        std::swap(rows_, other.rows_);
+        std::swap(underlyings_, other.underlyings_);
+    }
+    return *this;
+}
+
+void ChainFile::release() {
+    if (!data_) return;
+#ifdef CHAIN_FILE_MMAP
+    if (mapped_) munmap(const_cast<std::byte*>(data_), bytes_);
+    else ::operator delete(const_cast<std::byte*>(data_), std::align_val_t(ALIGNMENT));
+#else
+    ::operator delete(const_cast<std::byte*>(data_), std::align_val_t(ALIGNMENT));
+#endif
+    data_ = nullptr;
+    bytes_ = 0;
+}
+
+ChainFile ChainFile::open(const std::string& path) {
+    ChainFile file;
+#ifdef CHAIN_FILE_MMAP
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("ERROR: Cannot open chain file " + path);
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(HEADER_BYTES)) {
+        ::close(fd);
+        throw std::runtime_error("ERROR: Not a chain file: " + path);
+    }
+    file.bytes_ = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, file.bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) throw std::runtime_error("ERROR: Cannot map chain file " + path);
+    file.data_ = static_cast<const std::byte*>(mapping);
+    file.mapped_ = true;
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) throw std::runtime_error("ERROR: Cannot open chain file " + path);
+    file.bytes_ = static_cast<std::size_t>(in.tellg());
+    if (file.bytes_ < HEADER_BYTES) throw std::runtime_error("ERROR: Not a chain file: " + path);
+    auto* buffer = static_cast<std::byte*>(::operator new(file.bytes_, std::align_val_t(ALIGNMENT)));
+    file.data_ = buffer;
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(file.bytes_));
+#endif
+
+    const FileHeader& header = headerOf(file.data_);
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) throw std::runtime_error("ERROR: Not a chain file: " + path);
+    if (header.byteOrder != BYTE_ORDER_MARK) throw std::runtime_error("ERROR: Chain file has the other byte order: " + path);
+    if (header.version != VERSION) throw std::runtime_error("ERROR: Unsupported chain file version: " + path);
+    file.rows_ = header.rows;
+    file.underlyings_ = header.underlyings;
+    for (std::size_t c = 0; c < COLUMN_COUNT; ++c) {
+        const std::size_t count = c == Underlyings ? file.underlyings_ : file.rows_;
+        if (header.offsets[c] % ALIGNMENT != 0 || header.offsets[c] > file.bytes_ || count > (file.bytes_ - header.offsets[c]) / elementBytes(c))
+            throw std::runtime_error("ERROR: Truncated chain file: " + path);
+    }
+    for (std::uint32_t id : file.underlyingIds())
+        if (id >= file.underlyings_) throw std::runtime_error("ERROR: Corrupt chain file: " + path);
+    // each underlying's rows lie inside the file, and together they cover every row
+    std::uint64_t covered = 0;
+    for (const UnderlyingRecord& record : file.column<UnderlyingRecord>(Underlyings, file.underlyings_)) {
+        if (record.first > file.rows_ || record.count > file.rows_ - record.first || record.count > file.rows_ - covered)
+            throw std::runtime_error("ERROR: Corrupt chain file: " + path);
+        covered += record.count;
+    }
+    if (covered != file.rows_) throw std::runtime_error("ERROR: Corrupt chain file: " + path);
+    return file;
+}
+
+void ChainFile::write(const std::string& path, std::span<const ChainUnderlying> underlyings, std::span<const ChainQuote> quotes) {
+    for (const ChainUnderlying& u : underlyings)
+        if (u.symbol.size() >= sizeof(UnderlyingRecord::symbol)) throw std::invalid_argument("ERROR: Symbol too long: " + u.symbol);
+    for (const ChainQuote& q : quotes)
+        if (q.underlying >= underlyings.size()) throw std::invalid_argument("ERROR: Quote refers to a missing underlying");
+
+    std::vector<std::size_t> order(quotes.size());
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        const ChainQuote& x = quotes[a];
+        const ChainQuote& y = quotes[b];
+        if (x.underlying != y.underlying) return x.underlying < y.underlying;
+        if (x.expiry != y.expiry) return x.expiry < y.expiry;
+        if (x.type != y.type) return x.type < y.type;
+        return x.strike < y.strike;
+    });
+
+    const std::size_t rows = quotes.size();
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.version = VERSION;
+    header.rows = rows;
+    header.underlyings = underlyings.size();
+    std::size_t offset = HEADER_BYTES;
+    for (std::size_t c = 0; c < COLUMN_COUNT; ++c) {
+        header.offsets[c] = offset;
+        offset = alignUp(offset + (c == Underlyings ? underlyings.size() : rows) * elementBytes(c));
+    }
+
+    std::vector<std::byte> image(offset);
+    std::memcpy(image.data(), &header, sizeof(header));
+    auto columnAt = [&](std::size_t c) { return image.data() + header.offsets[c]; };
+    auto put = [&](std::size_t c, std::size_t row, const auto& value) {
+        std::memcpy(columnAt(c) + row * sizeof(value), &value, sizeof(value));
+    };
+
+    std::vector<UnderlyingRecord> records(underlyings.size());
+    for (std::size_t u = 0; u < underlyings.size(); ++u) {
+        std::memcpy(records[u].symbol, underlyings[u].symbol.data(), underlyings[u].symbol.size());
+        records[u].spot = underlyings[u].spot;
+        records[u].rate = underlyings[u].rate;
+    }
+    for (std::size_t row = 0; row < rows; ++row) {
+        const ChainQuote& q = quotes[order[row]];
+        const ChainUnderlying& u = underlyings[q.underlying];
+        put(Strikes, row, q.strike);
+        put(Expiries, row, q.expiry);
+        put(Types, row, q.type);
+        put(Bids, row, q.bid);
+        put(Asks, row, q.ask);
+        put(Mids, row, 0.5 * (q.bid + q.ask));
+        put(Spots, row, u.spot);
+        put(Rates, row, u.rate);
+        put(Ids, row, q.underlying);
+        UnderlyingRecord& record = records[q.underlying];
+        if (record.count++ == 0) record.first = row;
+    }
+    for (std::size_t u = 0; u < records.size(); ++u) put(Underlyings, u, records[u]);
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) throw std::runtime_error("ERROR: Cannot write chain file " + path);
+    out.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    if (!out) throw std::runtime_error("ERROR: Cannot write chain file " + path);
+}
+
+std::size_t ChainFile::convertCsv(std::istream& csv, const std::string& path) {
+    std::string line;
+    std::size_t lineNumber = 0;
+    std::vector<std::string> header;
+    while (header.empty() && std::getline(csv, line)) {
+        ++lineNumber;
+        if (!csv::trim(line).empty()) header = csv::split(line);
+    }
+
+    const std::size_t symbolColumn = csv::column(header, "symbol"), spotColumn = csv::column(header, "spot"),
+                      rateColumn = csv::column(header, "rate"), strikeColumn = csv::column(header, "strike"),
+                      typeColumn = csv::column(header, "type"), bidColumn = csv::column(header, "bid"), askColumn = csv::column(header, "ask");
+    std::size_t expiryColumn = csv::column(header, "expiry");
+    const bool expiryInDays = expiryColumn == std::string::npos;
+    if (expiryInDays) expiryColumn = csv::column(header, "expiryDays");
+    for (std::size_t c : {symbolColumn, spotColumn, strikeColumn, expiryColumn, typeColumn, bidColumn, askColumn})
+        if (c == std::string::npos) throw std::invalid_argument("ERROR: Chain CSV needs symbol, spot, strike, expiry or expiryDays, type, bid and ask columns");
+
+    std::vector<ChainUnderlying> underlyings;
+    std::vector<ChainQuote> quotes;
+    std::unordered_map<std::string, std::uint32_t> index;
+    while (std::getline(csv, line)) {
+        ++lineNumber;
+        if (csv::trim(line).empty()) continue;
+        const std::vector<std::string> cells = csv::split(line);
+        if (cells.size() != header.size())
+            throw std::invalid_argument("ERROR: line " + std::to_string(lineNumber) + ": expected " + std::to_string(header.size()) + " fields");
+
+        const std::string& symbol = cells[symbolColumn];
+        auto [it, added] = index.try_emplace(symbol, static_cast<std::uint32_t>(underlyings.size()));
+        if (added) {
+            const double rate = rateColumn == std::string::npos || cells[rateColumn].empty() ? 0.05 : parseNumber(cells[rateColumn], "rate", lineNumber);
+            underlyings.push_back({symbol, parseNumber(cells[spotColumn], "spot", lineNumber), rate});
+        }
+        const double expiry = parseNumber(cells[expiryColumn], "expiry", lineNumber);
+        quotes.push_back({it->second, parseNumber(cells[strikeColumn], "strike", lineNumber), expiryInDays ? expiry / gbl::TRADING_DAYS : expiry,
+                          parseType(cells[typeColumn], lineNumber), parseNumber(cells[bidColumn], "bid", lineNumber), parseNumber(cells[askColumn], "ask", lineNumber)});
+    }
+
+    write(path, underlyings, quotes);
+    return quotes.size();
+}
+
+template <class T>
+std::span<const T> ChainFile::column(std::size_t index, std::size_t count) const {
+    if (!data_) return {};
+    return {reinterpret_cast<const T*>(data_ + headerOf(data_).offsets[index]), count};
+}
+
+ChainUnderlyingView ChainFile::underlying(std::size_t index) const {
+    if (index >= underlyings_) throw std::out_of_range("ERROR: Underlying index out of range");
+    const UnderlyingRecord& record = column<UnderlyingRecord>(Underlyings, underlyings_)[index];
+    return {std::string_view(record.symbol, strnlen(record.symbol, sizeof(record.symbol))), record.spot, record.rate,
+            static_cast<std::size_t>(record.first), static_cast<std::size_t>(record.count)};
+}
+
+std::span<const double> ChainFile::strikes() const { return column<double>(Strikes, rows_); }
+std::span<const double> ChainFile::expiries() const { return column<double>(Expiries, rows_); }
+std::span<const OptionType> ChainFile::types() const { return column<OptionType>(Types, rows_); }
+std::span<const double> ChainFile::bids() const { return column<double>(Bids, rows_); }
+std::span<const double> ChainFile::asks() const { return column<double>(Asks, rows_); }
+std::span<const double> ChainFile::mids() const { return column<double>(Mids, rows_); }
+std::span<const double> ChainFile::spots() const { return column<double>(Spots, rows_); }
+std::span<const double> ChainFile::rates() const { return column<double>(Rates, rows_); }
+std::span<const std::uint32_t> ChainFile::underlyingIds() const { return column<std::uint32_t>(Ids, rows_); }
+
+QuoteInputs ChainFile::quotes(std::size_t first, std::size_t count) const {
+    if (first > rows_) throw std::out_of_range("ERROR: Quote range out of range");
+    count = std::min(count, rows_ - first);
+    return {strikes().subspan(first, count), expiries().subspan(first, count), types().subspan(first, count),
+            spots().subspan(first, count), rates().subspan(first, count), mids().subspan(first, count)};
+}
+
+ChainInputs ChainFile::chain(std::span<const double> vols, std::size_t first) const {
+    if (first > rows_ || vols.size() > rows_ - first) throw std::out_of_range("ERROR: Chain range out of range");
+    const std::size_t count = vols.size();
+    return {strikes().subspan(first, count), expiries().subspan(first, count), types().subspan(first, count),
+            spots().subspan(first, count), rates().subspan(first, count), vols};
+}
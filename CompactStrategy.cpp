@@ -0,0 +1,65 @@
+#include "Headers/CompactStrategy.h"
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+// Names by id, in a deque so the strings never move and views into them stay valid
+struct NameTable {
+    std::mutex mutex;
+    std::deque<std::string> names{std::string()};
+    std::unordered_map<std::string_view, std::uint32_t> ids{{std::string_view(), 0}};
+};
+
+NameTable& nameTable() {
+    static NameTable table;
+    return table;
+}
+
+template <std::size_t... I>
+std::array<StrategyLeg, sizeof...(I)> emptyLegs(std::index_sequence<I...>) {
+    return {((void)I, StrategyLeg{Option(0.0, 0.0, OptionType::Call), 0})...};
+}
+
+}
+
+StrategyName StrategyName::intern(std::string_view name) {
+    NameTable& table = nameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    if (auto found = table.ids.find(name); found != table.ids.end()) return StrategyName(found->second);
+    const auto id = static_cast<std::uint32_t>(table.names.size());
+    const std::string& stored = table.names.emplace_back(name);
+    table.ids.emplace(stored, id);
+    return StrategyName(id);
+}
+
+std::string_view StrategyName::view() const {
+    NameTable& table = nameTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    return table.names[id_];
+}
+
+CompactStrategy::CompactStrategy(StrategyName name)
+    : legs_(emptyLegs(std::make_index_sequence<MAX_LEGS>())), name_(name) {}
+
+void CompactStrategy::addLeg(const Option& option, int quantity) {
+    if (count_ == MAX_LEGS) throw std::invalid_argument("ERROR: CompactStrategy holds at most " + std::to_string(MAX_LEGS) + " legs");
+    legs_[count_++] = {option, quantity};
+}
+
+CompactStrategy CompactStrategy::from(const Strategy& strategy) {
+    if (strategy.getLegs().size() > MAX_LEGS) throw std::invalid_argument("ERROR: Too many legs for a CompactStrategy: " + strategy.getName());
+    CompactStrategy compact(StrategyName::intern(strategy.getName()));
+    for (const StrategyLeg& leg : strategy.getLegs()) compact.addLeg(leg.option, leg.quantity);
+    return compact;
+}
+
+Strategy CompactStrategy::toStrategy() const {
+    Strategy strategy{std::string(name_.view())};
+    for (const StrategyLeg& leg : getLegs()) strategy.addLeg(leg.option, leg.quantity);
+    return strategy;
+}
@@ -0,0 +1,56 @@
+#include "Headers/CubicSpline.h"
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+CubicSpline::CubicSpline(double x0, double x1, const std::vector<double>& values)
+        : x0(x0), x1(x1), step(0.0), inverseStep(0.0) {
+    if (values.size() < 3 || !(x1 > x0)) throw std::invalid_argument("ERROR: CubicSpline needs 3+ samples on a non-empty range");
+
+    const std::size_t n = values.size() - 1;
+    const double h = (x1 - x0) / static_cast<double>(n);
+    step = h;
+    inverseStep = 1.0 / h;
+
+    // second derivatives at the nodes. The end values come from one-sided differences rather than
+    // the natural spline's zero, which would cost accuracy near the edges; the interior follows
+    // from the tridiagonal continuity system (Thomas algorithm).
+    std::vector<double> m(n + 1, 0.0), diag(n + 1, 4.0), rhs(n + 1, 0.0);
+    if (n >= 3) {
+        m[0] = (2.0 * values[0] - 5.0 * values[1] + 4.0 * values[2] - values[3]) / (h * h);
+        m[n] = (2.0 * values[n] - 5.0 * values[n - 1] + 4.0 * values[n - 2] - values[n - 3]) / (h * h);
+    }
+    for (std::size_t i = 1; i < n; ++i)
+        rhs[i] = 6.0 * (values[i + 1] - 2.0 * values[i] + values[i - 1]) / (h * h);
+    rhs[1] -= m[0];
+    rhs[n - 1] -= m[n];
+    for (std::size_t i = 2; i < n; ++i) {
+        const double w = 1.0 / diag[i - 1];
+        diag[i] -= w;
+        rhs[i] -= w * rhs[i - 1];
+    }
+    for (std::size_t i = n - 1; i >= 1; --i)
+        m[i] = (rhs[i] - (i + 1 < n ? m[i + 1] : 0.0)) / diag[i];
+
+    // per-interval polynomial in t = x - x_i
+    coeffs.resize(4 * n);
+    for (std::size_t i = 0; i < n; ++i) {
+        coeffs[4 * i]     = values[i];
+        coeffs[4 * i + 1] = (values[i + 1] - values[i]) / h - h * (2.0 * m[i] + m[i + 1]) / 6.0;
+        coeffs[4 * i + 2] = 0.5 * m[i];
+        coeffs[4 * i + 3] = (m[i + 1] - m[i]) / (6.0 * h);
+    }
+}
+
+double CubicSpline::evaluate(double x) const {
+    const double u = (x - x0) * inverseStep;
+    const auto last = static_cast<double>(intervals() - 1);
+    const double cell = std::clamp(std::floor(u), 0.0, last);
+    const double t = (u - cell) * step;
+    const double* c = &coeffs[4 * static_cast<std::size_t>(cell)];
+    return ((c[3] * t + c[2]) * t + c[1]) * t + c[0];
+}
+
+double CubicSpline::lower() const { return x0; }
+double CubicSpline::upper() const { return x1; }
+std::size_t CubicSpline::intervals() const { return coeffs.size() / 4; }
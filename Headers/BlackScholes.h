@@ -1,16 +1,36 @@
 #pragma once
 #include <optional>
+#include <span>
+#include <cstdint>
 #include "Greeks.h"
 #include "Option.h"
 #include "VolatilitySurface.h"
 
-class BlackScholes {
-private:
-    static double normalPDF(double x);
-    static double normalCDF(double x);
+// Structure-of-arrays view over a chain, one entry per option
+struct ChainInputs {
+    std::span<const double> strikes;
+    std::span<const double> expiries;
+    std::span<const OptionType> types;
+    std::span<const double> spots;
+    std::span<const double> rates;
+    std::span<const double> vols;
+};
+
+// Arithmetic the pricers run in. Single uses float lanes, twice as many per register, and is
+// meant for screening and risk sweeps; inputs and outputs stay double either way.
+enum class Precision { Double, Single };
 
+// Thin wrappers over the kernels in PricingKernel.h, which callers that need a fixed option
+// type and a subset of outputs can use directly
+class BlackScholes {
 public:
-    [[nodiscard]] static std::optional<Greeks> calculate(double K, double T, OptionType type, double spotPrice, double riskFreeRate, const IVolatilitySurface& volSurface);
-    [[nodiscard]] static std::optional<double> calculatePremium(double K, double T, OptionType type, double S, double r, double sigma);
+    [[nodiscard]] static std::optional<Greeks> calculate(double K, double T, OptionType type, double spotPrice, double riskFreeRate, const IVolatilitySurface& volSurface, Precision precision = Precision::Double);
+    [[nodiscard]] static std::optional<double> calculatePremium(double K, double T, OptionType type, double S, double r, double sigma, Precision precision = Precision::Double);
     [[nodiscard]] static std::optional<double> calculateIV( const Option& option, double spotPrice, double marketPrice, double riskFreeRate);
-};
\ No newline at end of file
+
+    // Vectorized pricing of a whole chain. valid[i] is 1 when option i could be priced
+    // (K, T, S and sigma all positive), 0 otherwise; outputs of invalid lanes are zeroed.
+    // Only the requested (non-empty) outputs are computed.
+    // Returns the number of valid options.
+    static std::size_t calculateBatch(const ChainInputs& inputs, const GreeksBatch& outputs, std::span<std::uint8_t> valid, Precision precision = Precision::Double);
+};
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Option.h"
+#include "BlackScholes.h"
+#include "ImpliedVolatility.h"
+
+struct ChainUnderlying {
+    std::string symbol;
+    double spot;
+    double rate;
+};
+
+struct ChainQuote {
+    std::uint32_t underlying;   // index into the underlyings
+    double strike;
+    double expiry;              // years
+    OptionType type;
+    double bid;
+    double ask;
+};
+
+// One underlying of an open chain file; its quotes are the rows [first, first + count)
+struct ChainUnderlyingView {
+    std::string_view symbol;
+    double spot;
+    double rate;
+    std::size_t first;
+    std::size_t count;
+};
+
+// Binary columnar option chain. Rows are sorted by underlying, expiry, type and strike, and
+// every column is a 64-byte aligned array, so an opened file is used in place: the spans
+// point into the memory-mapped file (read into one aligned buffer where mmap is unavailable).
+// Besides strike, expiry, type, bid, ask and underlying id the writer stores each row's mid,
+// spot and rate, so quotes() and chain() feed ImpliedVolatility::solveBatch and
+// BlackScholes::calculateBatch without copying. Files are native-endian; opening a file
+// written with the other byte order fails.
+class ChainFile {
+    const std::byte* data_ = nullptr;
+    std::size_t bytes_ = 0;
+    bool mapped_ = false;
+    std::size_t rows_ = 0;
+    std::size_t underlyings_ = 0;
+
+    template <class T>
+    [[nodiscard]] std::span<const T> column(std::size_t index, std::size_t count) const;
+    void release();
+
+public:
+    ChainFile() = default;
+    ~ChainFile();
+    ChainFile(ChainFile&& other) noexcept;
+    ChainFile& operator=(ChainFile&& other) noexcept;
+    ChainFile(const ChainFile&) = delete;
+    ChainFile& operator=(const ChainFile&) = delete;
+
+    // Throws std::runtime_error when the file is missing, truncated or not a chain file
+    static ChainFile open(const std::string& path);
+
+    // Sorts the quotes and writes them with the underlyings they refer to
+    static void write(const std::string& path, std::span<const ChainUnderlying> underlyings, std::span<const ChainQuote> quotes);
+
+    // Converts a CSV with a header row holding symbol, spot, strike, expiry (years) or
+    // expiryDays (trading days), type (C/P/call/put), bid and ask, plus an optional rate
+    // (default 5%). Underlyings are keyed by symbol; the first row of each sets its spot and rate.
+    // Returns the number of quotes written.
+    static std::size_t convertCsv(std::istream& csv, const std::string& path);
+
+    [[nodiscard]] std::size_t size() const { return rows_; }
+    [[nodiscard]] std::size_t underlyingCount() const { return underlyings_; }
+    [[nodiscard]] ChainUnderlyingView underlying(std::size_t index) const;
+
+    [[nodiscard]] std::span<const double> strikes() const;
+    [[nodiscard]] std::span<const double> expiries() const;
+    [[nodiscard]] std::span<const OptionType> types() const;
+    [[nodiscard]] std::span<const double> bids() const;
+    [[nodiscard]] std::span<const double> asks() const;
+    [[nodiscard]] std::span<const double> mids() const;
+    [[nodiscard]] std::span<const double> spots() const;
+    [[nodiscard]] std::span<const double> rates() const;
+    [[nodiscard]] std::span<const std::uint32_t> underlyingIds() const;
+
+    // Views for rows [first, first + count), all rows by default; prices are the mids
+    [[nodiscard]] QuoteInputs quotes(std::size_t first = 0, std::size_t count = SIZE_MAX) const;
+    [[nodiscard]] ChainInputs chain(std::span<const double> vols, std::size_t first = 0) const;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+#include "Option.h"
+#include "Strategy.h"
+
+// Handle to a name in a process-wide table. Interning takes a lock and copies the name the
+// first time it is seen; handles then copy and compare as integers. Names are never freed.
+class StrategyName {
+    std::uint32_t id_ = 0;   // 0 is the empty name
+
+    explicit StrategyName(std::uint32_t id) : id_(id) {}
+
+public:
+    StrategyName() = default;
+
+    static StrategyName intern(std::string_view name);
+    // Valid for the life of the process
+    [[nodiscard]] std::string_view view() const;
+    [[nodiscard]] std::uint32_t id() const { return id_; }
+
+    friend bool operator==(StrategyName, StrategyName) = default;
+};
+
+// A Strategy with its legs stored inline and an interned name: trivially copyable and free of
+// heap storage, so a scan's candidates are one flat buffer. Up to MAX_LEGS legs, which covers
+// every shape the Strategy factories build.
+class CompactStrategy {
+public:
+    static constexpr std::size_t MAX_LEGS = 4;
+
+private:
+    std::array<StrategyLeg, MAX_LEGS> legs_;
+    std::uint32_t count_ = 0;
+    StrategyName name_;
+
+public:
+    explicit CompactStrategy(StrategyName name = {});
+
+    // Throws std::invalid_argument beyond MAX_LEGS legs
+    void addLeg(const Option& option, int quantity);
+    [[nodiscard]] std::span<const StrategyLeg> getLegs() const { return {legs_.data(), count_}; }
+    [[nodiscard]] StrategyName getName() const { return name_; }
+
+    // Interns the strategy's name; throws std::invalid_argument beyond MAX_LEGS legs
+    static CompactStrategy from(const Strategy& strategy);
+    [[nodiscard]] Strategy toStrategy() const;
+};
+
+// Arena for the strategies of a scan: one contiguous block that clear() empties but keeps, so
+// once it has grown to the largest scan, refilling it allocates nothing. The contents are a
+// span simulateStrategies takes directly.
+class StrategyBook {
+    std::vector<CompactStrategy> strategies_;
+
+public:
+    void reserve(std::size_t count) { strategies_.reserve(count); }
+    void clear() { strategies_.clear(); }
+
+    // Appends an empty strategy to add legs to; the reference lasts until the next add that
+    // grows the block
+    CompactStrategy& add(StrategyName name = {}) { return strategies_.emplace_back(name); }
+    void add(const CompactStrategy& strategy) { strategies_.push_back(strategy); }
+
+    [[nodiscard]] std::span<const CompactStrategy> strategies() const { return strategies_; }
+    [[nodiscard]] const CompactStrategy& operator[](std::size_t index) const { return strategies_[index]; }
+    [[nodiscard]] std::size_t size() const { return strategies_.size(); }
+    [[nodiscard]] std::size_t capacity() const { return strategies_.capacity(); }
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Minimal text record helpers shared by the file readers
+namespace csv {
+
+inline std::string trim(std::string_view text) {
+    const std::size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string_view::npos) return {};
+    const std::size_t last = text.find_last_not_of(" \t\r\n");
+    return std::string(text.substr(first, last - first + 1));
+}
+
+// Plain comma-separated values; surrounding double quotes are dropped
+inline std::vector<std::string> split(const std::string& line) {
+    std::vector<std::string> cells;
+    std::size_t start = 0;
+    while (true) {
+        const std::size_t comma = line.find(',', start);
+        std::string cell = trim(std::string_view(line).substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+        if (cell.size() >= 2 && cell.front() == '"' && cell.back() == '"') cell = cell.substr(1, cell.size() - 2);
+        cells.push_back(std::move(cell));
+        if (comma == std::string::npos) return cells;
+        start = comma + 1;
+    }
+}
+
+// Column of a header row, or npos
+inline std::size_t column(const std::vector<std::string>& header, std::string_view name) {
+    for (std::size_t c = 0; c < header.size(); ++c)
+        if (header[c] == name) return c;
+    return std::string::npos;
+}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// Cubic spline through values sampled on a uniform grid over [x0, x1].
+// Evaluation is a bucket lookup plus one cubic, independent of the grid size.
+class CubicSpline {
+private:
+    double x0;
+    double x1;
+    double step;
+    double inverseStep;
+    std::vector<double> coeffs; // a, b, c, d per interval
+
+public:
+    CubicSpline(double x0, double x1, const std::vector<double>& values);
+
+    [[nodiscard]] double evaluate(double x) const;
+    [[nodiscard]] double lower() const;
+    [[nodiscard]] double upper() const;
+    [[nodiscard]] std::size_t intervals() const;
+};
@@ -1,3 +1,4 @@
+#pragma once
 namespace gbl
 {
     constexpr double CALENDAR_DAYS = 365.2425;
@@ -1,4 +1,5 @@
 #pragma once
+#include <span>
 
 struct Greeks {
     double premium;
@@ -8,3 +9,14 @@ struct Greeks {
     double vega;
     double rho;
 };
+
+// Caller-owned output columns for batch pricing, one entry per option.
+// An empty span skips that output.
+struct GreeksBatch {
+    std::span<double> premium;
+    std::span<double> delta;
+    std::span<double> gamma;
+    std::span<double> theta;
+    std::span<double> vega;
+    std::span<double> rho;
+};
@@ -0,0 +1,36 @@
+#pragma once
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include "Option.h"
+
+class ThreadPool;
+
+enum class IVStatus : std::uint8_t {
+    Converged,
+    NotConverged,
+    BelowIntrinsic,   // price at or under intrinsic value
+    AboveMaximum,     // price at or over the no-arbitrage cap (spot for calls, discounted strike for puts)
+    InvalidInput
+};
+
+// Structure-of-arrays view over market quotes, one entry per option
+struct QuoteInputs {
+    std::span<const double> strikes;
+    std::span<const double> expiries;
+    std::span<const OptionType> types;
+    std::span<const double> spots;
+    std::span<const double> rates;
+    std::span<const double> prices;
+};
+
+class ImpliedVolatility {
+public:
+    // Inverts a whole chain. Each quote starts from a tabulated guess of the normalized
+    // Black price and is refined with vectorized Halley steps; quotes that do not settle
+    // fall back to bisection. The chain is spread over pool, ThreadPool::shared() when nullptr.
+    // Returns the number of converged quotes.
+    static std::size_t solveBatch(const QuoteInputs& quotes, std::span<double> vols, std::span<IVStatus> status, ThreadPool* pool = nullptr);
+    // As solveBatch, entirely on the calling thread
+    static std::size_t solveBatchInline(const QuoteInputs& quotes, std::span<double> vols, std::span<IVStatus> status);
+};
@@ -0,0 +1,37 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+
+// Hot-path timers. Build with OPTIONS_WIZARD_INSTRUMENTATION=0 to compile them out; the
+// stats structs are then returned empty.
+#ifndef OPTIONS_WIZARD_INSTRUMENTATION
+#define OPTIONS_WIZARD_INSTRUMENTATION 1
+#endif
+
+namespace instrument {
+
+inline constexpr bool enabled = OPTIONS_WIZARD_INSTRUMENTATION != 0;
+
+// Interval timer: lap() returns the nanoseconds since construction or the previous lap
+class Stopwatch {
+    std::chrono::steady_clock::time_point last_{};
+
+public:
+    Stopwatch() {
+        if constexpr (enabled) last_ = std::chrono::steady_clock::now();
+    }
+
+    std::uint64_t lap() {
+        if constexpr (enabled) {
+            const auto now = std::chrono::steady_clock::now();
+            const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last_).count();
+            last_ = now;
+            return static_cast<std::uint64_t>(elapsed);
+        }
+        return 0;
+    }
+};
+
+inline double seconds(std::uint64_t nanoseconds) { return static_cast<double>(nanoseconds) * 1e-9; }
+
+}
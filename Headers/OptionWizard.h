@@ -1,10 +1,91 @@
 #pragma once
 #include <optional>
 #include <string>
+#include <vector>
+#include <span>
+#include <cstdint>
 #include "Option.h"
 #include "Strategy.h"
+#include "CompactStrategy.h"
 #include "Greeks.h"
 #include "VolatilitySurface.h"
+#include "BlackScholes.h"
+#include "Random.h"
+#include "ThreadPool.h"
+#include "SimulationStats.h"
+
+struct SimulationOptions {
+    int paths = 100000;
+    // Value each path from a cubic spline of the strategy's horizon value over the normal draw
+    // instead of repricing every leg. The spline is refined until it stays within
+    // interpolationTolerance ($) of the exact pricer; if it cannot, paths are priced exactly.
+    bool interpolateHorizonValue = false;
+    double interpolationTolerance = 1e-4;
+    // Normal draws come from generator when set, otherwise from a Philox stream keyed by seed
+    // (a random seed when unset). A seeded run gives the same result on any pool.
+    const INormalGenerator* generator = nullptr;
+    std::optional<std::uint64_t> seed;
+    ThreadPool* pool = nullptr;   // nullptr runs on ThreadPool::shared()
+    // Adaptive mode, on when either target is set: after the first `paths` paths the engine
+    // keeps adding batches until the expected value's standard error is within
+    // max(targetStandardError, targetRelativeError * |expectedValue|) for every strategy,
+    // or maxPaths is reached.
+    double targetStandardError = 0.0;   // $
+    double targetRelativeError = 0.0;
+    int maxPaths = 2000000;
+    // Variance reduction on top of antithetic pairs. quasiRandom draws from a scrambled Sobol
+    // sequence (reported standard errors are then conservative). controlVariates regresses each
+    // path value on the terminal spot and the legs' payoff at the horizon, whose means are known.
+    bool quasiRandom = false;
+    bool controlVariates = false;
+    // Skip the paths: PoP and EV in closed form from the piecewise-linear payoff when the legs
+    // have expired by the horizon, by Gauss-Hermite quadrature over the horizon draw otherwise.
+    // Deterministic; pathsUsed and the standard errors are zero. Falls back to simulation with
+    // exit rules or when legs expire on different dates before the horizon.
+    bool analytic = false;
+    // Path-dependent valuation. Legs that expire before the horizon settle at intrinsic value
+    // on their own dates, and a path exits early, at its value on that date, once its P&L
+    // reaches takeProfit or falls to -stopLoss ($). Either puts the strategy on bridged paths
+    // over a grid of timeSteps uniform steps plus every leg expiry; the horizon spots stay
+    // the same as for single-draw strategies, so the batch keeps common random numbers.
+    int timeSteps = 1;
+    std::optional<double> takeProfit;
+    std::optional<double> stopLoss;
+    // Arithmetic for repricing the legs on each path. Single prices on float lanes for
+    // screening runs; path values are still summed in double.
+    Precision precision = Precision::Double;
+    // First-order sensitivities of the simulated EV and PoP from the same paths, filling
+    // result::sensitivities. Strategies are then valued exactly rather than from the spline.
+    // Not available for path-dependent strategies or in analytic mode.
+    bool sensitivities = false;
+    // Filled with phase timings, per-thread path counts and throughput for the call when set
+    SimulationStats* stats = nullptr;
+};
+
+// Derivatives of one simulated metric with respect to the simulation inputs: today's spot
+// (per $1), the path vol sigma and drift mu (per 1.00) and the horizon (per trading day)
+struct InputSensitivities {
+    double spot = 0.0;
+    double sigma = 0.0;
+    double mu = 0.0;
+    double days = 0.0;
+};
+
+// EV derivatives are pathwise: each path contributes the strategy's spot derivative at its
+// horizon spot (leg deltas plus the smile's slope) times the spot's derivative with respect to
+// the input, and for the horizon the legs' time decay. PoP counts are flat in the spot, so
+// their derivatives are likelihood-ratio weights on the profitable paths; where an input also
+// moves the profit threshold (the entry cost for the spot, time decay for the horizon) that
+// part is a central difference over the same paths, 1% of spot or one day, with values moved
+// linearly. The vol surface is not bumped: sigma and mu only drive the paths. Horizon
+// sensitivities are NaN when a leg expires on the horizon date, where the value has no
+// two-sided time derivative.
+struct MetricSensitivities {
+    InputSensitivities expectedValue;
+    InputSensitivities pop;
+    InputSensitivities expectedValueStdError;
+    InputSensitivities popStdError;
+};
 
 struct result {
     std::string strategyName;
@@ -14,13 +95,46 @@ struct result {
     double pop;
     Greeks netGreeks;
     double expectedValue;
+    double expectedValueStdError;
+    double popStdError;
+    std::uint64_t pathsUsed;
+    std::optional<MetricSensitivities> sensitivities;
 };
 
+// result of a CompactStrategy, with the interned name in place of an owned string so that a
+// scan's results fit in a reused buffer
+struct CompactResult {
+    StrategyName strategyName;
+    double entryCost = 0.0;
+    double projectedValue = 0.0;
+    double profitPercent = 0.0;
+    double pop = 0.0;
+    Greeks netGreeks{};
+    double expectedValue = 0.0;
+    double expectedValueStdError = 0.0;
+    double popStdError = 0.0;
+    std::uint64_t pathsUsed = 0;
+    std::optional<MetricSensitivities> sensitivities;
+};
 
 class OptionWizard {
 private:
     static double getEstimatedPrice(const Option& i_option, double futureSpot, double futureTimeRemaining, double r, const IVolatilitySurface& volSurface, double CurrentSpot);
+    // Legs valued `elapsed` years from now, each with its own remaining time; expired legs pay intrinsic value
+    static double getHorizonValue(std::span<const StrategyLeg> legs, double simulatedPrice, double elapsed, double r, const IVolatilitySurface& volSurface);
+    // The engine behind both simulateStrategies overloads; results are written to out
+    template <class StrategyT>
+    static void simulate(std::span<const StrategyT> strategies, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options, std::span<CompactResult> out);
 
 public:
-    static result simulateStrategy(const Strategy& strategy, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma);
+    static result simulateStrategy(const Strategy& strategy, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options = {});
+
+    // Values every strategy on one shared set of simulated paths, so results compare under
+    // common random numbers. A strategy simulated alone with the same seed gets the same result.
+    static std::vector<result> simulateStrategies(std::span<const Strategy> strategies, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options = {});
+
+    // The same on compact strategies, results into out (at least one per strategy, else
+    // std::invalid_argument). In analytic mode nothing is allocated per strategy: leg storage,
+    // names and results are the caller's, and the working buffers take two allocations per call.
+    static void simulateStrategies(std::span<const CompactStrategy> strategies, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options, std::span<CompactResult> out);
 };
\ No newline at end of file
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "Random.h"
+
+// Spot paths for one block of antithetic pairs, walked date by date in structure-of-arrays
+// rows. Paths are Brownian bridges pinned to given horizon log-returns, so the horizon spot is
+// exactly the single-draw engine's and only the dates in between are new. Path j and path
+// pairs + j see opposite bridge draws; the draws for date k come from generator stream k,
+// indexed by pair, so a path does not depend on how pairs are split into blocks. Only the
+// current row is kept, which keeps a block's working set in L2.
+class PathBlock {
+    std::vector<double> times_;
+    std::size_t pairs_ = 0;
+    std::size_t date_ = 0;
+    double current_ = 0.0;
+    double sigma_ = 0.0;
+    std::uint64_t firstPair_ = 0;
+    const INormalGenerator* generator_ = nullptr;
+    std::vector<double> logReturns_;
+    std::vector<double> horizonLogReturns_;
+    std::vector<double> spots_;
+    std::vector<double> draws_;
+
+public:
+    // Dates closer than this (one second, in years) are treated as the same date
+    static constexpr double SAME_DATE = 1.0 / (365.0 * 24.0 * 3600.0);
+
+    // times runs from 0 to the horizon; horizonLogReturns holds ln(S_H / current) for all
+    // 2 * pairs paths
+    void begin(const INormalGenerator& generator, std::uint64_t firstPair, std::span<const double> times,
+               double current, double sigma, std::span<const double> horizonLogReturns);
+
+    // Moves every path to the next date; false once the horizon has been passed
+    bool advance();
+
+    [[nodiscard]] std::size_t date() const { return date_; }
+    [[nodiscard]] double time() const { return times_[date_]; }
+    [[nodiscard]] bool atHorizon() const { return date_ + 1 == times_.size(); }
+    [[nodiscard]] std::size_t paths() const { return 2 * pairs_; }
+    [[nodiscard]] std::span<const double> spots() const { return spots_; }
+
+    // Dates from today (0) to the horizon in uniform steps, plus any extra dates (such as leg
+    // expiries) that fall strictly inside
+    static std::vector<double> timeGrid(double horizon, int steps, std::span<const double> extraDates);
+};
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "Option.h"
+#include "VolatilitySurface.h"
+
+class ThreadPool;
+
+struct PdeOptions {
+    bool american = true;
+    std::size_t spotNodes = 401;      // odd, so today's spot is the middle node
+    std::size_t timeSteps = 200;
+    double widthStdDevs = 5.0;        // grid half-width in ln S, in units of sigma sqrt(T)
+    std::size_t rannacherSteps = 2;   // leading Crank-Nicolson steps replaced by two implicit half steps
+    double penaltyTolerance = 1e-8;   // early-exercise penalty is 1/tolerance; also the iteration stop
+    // Stop the backward solve this many years from now, so the grid holds the value at that
+    // horizon with T - elapsed remaining
+    double elapsed = 0.0;
+};
+
+// Value, delta, gamma and daily theta at one spot
+struct PdePoint {
+    double value;
+    double delta;
+    double gamma;
+    double theta;
+};
+
+// One solve: the option across the whole spot grid at the horizon
+struct PdeGrid {
+    std::vector<double> spots;        // ascending, uniform in ln S
+    std::vector<double> values;
+    std::vector<double> deltas;
+    std::vector<double> gammas;
+    std::vector<double> thetas;       // per trading day, from the last time step
+
+    // Quadratic in ln S between nodes; spots off the grid take the nearest end. Throws
+    // std::out_of_range on an empty grid.
+    [[nodiscard]] PdePoint at(double spot) const;
+    // Values at many spots, e.g. the horizon spots of simulated paths
+    void valuesAt(std::span<const double> spots, std::span<double> out) const;
+};
+
+// Black-Scholes PDE in x = ln S on a uniform grid, stepped back from expiry with
+// Crank-Nicolson after Rannacher start-up steps. Early exercise is a penalty term solved by
+// policy iteration, each pass one tridiagonal (Thomas) solve over contiguous columns, so
+// American puts and calls come out of the same loop; without dividends the American call
+// equals the European. The vol is constant per solve. Boundaries are Dirichlet: the
+// discounted intrinsic value (intrinsic once exercise is allowed) at the low end for puts
+// and at the high end for calls.
+class PdeSolver {
+public:
+    // Throws std::invalid_argument unless K, T, S and sigma are positive and the grid has at
+    // least 5 nodes and one step
+    static PdeGrid solve(double K, double T, OptionType type, double spot, double r, double sigma, const PdeOptions& options = {});
+
+    // Independent options in parallel, each at its surface vol for today's spot
+    static std::vector<PdeGrid> solveBatch(std::span<const Option> options, double spot, double r, const IVolatilitySurface& volSurface,
+                                           const PdeOptions& pde = {}, ThreadPool* pool = nullptr);
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <unordered_map>
+#include <vector>
+#include "CompactStrategy.h"
+#include "Greeks.h"
+#include "Option.h"
+#include "Strategy.h"
+#include "VolatilitySurface.h"
+
+struct BookPosition {
+    double strike;
+    double expiry;     // years
+    OptionType type;
+    double quantity;   // signed contracts; negative is short
+};
+
+// Open positions netted by (strike, expiry, type), stored as columns. Each row keeps its
+// per-contract Greeks at the book's market, so adding or removing contracts moves the running
+// totals by quantity x those Greeks and prices only rows that did not exist before. Rows whose
+// quantity nets to zero are dropped by swapping the last row into their place, so row order is
+// not stable. reprice() moves the book to a new spot and rate, prices every row in one batch and
+// rebuilds the totals from scratch, which also clears the rounding that incremental updates
+// accumulate. The surface must outlive the book.
+class PortfolioBook {
+    struct Key {
+        double strike;
+        double expiry;
+        OptionType type;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    double spot_;
+    double r_;
+    const IVolatilitySurface& volSurface_;
+    std::unordered_map<Key, std::size_t, KeyHash> rows_;
+
+    std::vector<double> strikes_, expiries_, quantities_;
+    std::vector<OptionType> types_;
+    std::vector<double> premium_, delta_, gamma_, theta_, vega_, rho_;   // per contract
+    Greeks totals_{};
+
+    void accumulate(std::size_t row, double quantity);
+    std::size_t price(std::size_t first);   // rows [first, size())
+    void dropRow(std::size_t row);
+
+public:
+    PortfolioBook(double spot, double r, const IVolatilitySurface& volSurface);
+
+    // Nets the positions into the book. Throws std::invalid_argument, leaving the book as it
+    // was, when a position has a non-positive strike or expiry or a non-finite quantity.
+    // Positions the surface gives no positive vol for carry zero Greeks.
+    void add(std::span<const BookPosition> positions);
+    void add(const BookPosition& position);
+    // Every leg of the strategy times multiplier; remove() takes them back out
+    void add(const Strategy& strategy, double multiplier = 1.0);
+    void remove(const Strategy& strategy, double multiplier = 1.0);
+    void add(const CompactStrategy& strategy, double multiplier = 1.0);
+    void remove(const CompactStrategy& strategy, double multiplier = 1.0);
+
+    // Reprices every row at the new market; returns the number of rows that priced
+    std::size_t reprice(double spot, double r);
+
+    // Net value (premium) and Greeks of the whole book, rho included
+    [[nodiscard]] const Greeks& totals() const { return totals_; }
+    [[nodiscard]] double quantity(double strike, double expiry, OptionType type) const;
+    [[nodiscard]] std::size_t size() const { return strikes_.size(); }
+    [[nodiscard]] double spot() const { return spot_; }
+    [[nodiscard]] double rate() const { return r_; }
+
+    [[nodiscard]] std::span<const double> strikes() const { return strikes_; }
+    [[nodiscard]] std::span<const double> expiries() const { return expiries_; }
+    [[nodiscard]] std::span<const OptionType> types() const { return types_; }
+    [[nodiscard]] std::span<const double> quantities() const { return quantities_; }
+    // Per-contract Greeks of one row at the book's market
+    [[nodiscard]] Greeks unitGreeks(std::size_t row) const;
+};
@@ -0,0 +1,107 @@
+#pragma once
+#include "Global.h"
+#include "Option.h"
+#include "Simd.h"
+
+// Output bits for the pricing kernels. A kernel only computes the terms its mask needs:
+// delta, gamma and vega skip the discount factor and N(d2), premium skips the Greek algebra.
+namespace greek {
+inline constexpr unsigned Premium = 1u << 0;
+inline constexpr unsigned Delta = 1u << 1;
+inline constexpr unsigned Gamma = 1u << 2;
+inline constexpr unsigned Theta = 1u << 3;
+inline constexpr unsigned Vega = 1u << 4;
+inline constexpr unsigned Rho = 1u << 5;
+inline constexpr unsigned All = Premium | Delta | Gamma | Theta | Vega | Rho;
+}
+
+// Kernel outputs for one lane type; terms outside the mask are left at zero
+template <class V>
+struct GreeksOf {
+    V premium{};
+    V delta{};
+    V gamma{};
+    V theta{};
+    V vega{};
+    V rho{};
+};
+
+namespace pricing_detail {
+
+// The kernel proper, from the per-option terms callers that reprice the same legs keep:
+// log(S/K), sqrt(T), sigma sqrt(T) and K e^(-rT). discountedK is only read for premium, theta
+// and rho. Calls / Puts say which option types the lanes may hold. With both, isCall picks
+// per lane; with one, the other branch is never built. Inputs must be valid (K, T, S, sigma > 0).
+template <unsigned Mask, bool Calls, bool Puts, class V>
+GreeksOf<V> blackScholesFromInvariants(V S, V logMoneyness, V T, V sqrtT, V r, V sigma, V sigmaSqrtT, V discountedK,
+                                       typename V::Mask isCall) {
+    static_assert(Calls || Puts);
+    constexpr bool premium = (Mask & greek::Premium) != 0;
+    constexpr bool delta = (Mask & greek::Delta) != 0;
+    constexpr bool gamma = (Mask & greek::Gamma) != 0;
+    constexpr bool theta = (Mask & greek::Theta) != 0;
+    constexpr bool vega = (Mask & greek::Vega) != 0;
+    constexpr bool rho = (Mask & greek::Rho) != 0;
+
+    auto pick = [&](V call, V put) {
+        if constexpr (Calls && Puts) return select(isCall, call, put);
+        else if constexpr (Calls) return call;
+        else return put;
+    };
+
+    const V d1 = (logMoneyness + (r + V::broadcast(0.5) * sigma * sigma) * T) / sigmaSqrtT;
+    const V pdf_d1 = simd::normalPDF(d1);
+
+    GreeksOf<V> g;
+    V cdf_d1{}, cdf_neg_d1{};
+    if constexpr (premium || delta) simd::normalCDFPair(d1, pdf_d1, cdf_d1, cdf_neg_d1);
+
+    if constexpr (premium || theta || rho) {
+        const V d2 = d1 - sigmaSqrtT;
+        // S n(d1) = K e^(-rT) n(d2), so both densities come from one exp
+        V cdf_d2{}, cdf_neg_d2{};
+        simd::normalCDFPair(d2, S * pdf_d1 / discountedK, cdf_d2, cdf_neg_d2);
+
+        if constexpr (premium) g.premium = pick(S * cdf_d1 - discountedK * cdf_d2, discountedK * cdf_neg_d2 - S * cdf_neg_d1);
+        if constexpr (theta) {
+            const V decay = -(S * pdf_d1 * sigma) / (V::broadcast(2.0) * sqrtT);
+            g.theta = pick(decay - r * discountedK * cdf_d2, decay + r * discountedK * cdf_neg_d2) / V::broadcast(gbl::TRADING_DAYS);   // daily theta
+        }
+        if constexpr (rho) g.rho = pick(discountedK * T * cdf_d2, -(discountedK * T * cdf_neg_d2)) * V::broadcast(0.01);   // per 1% rate
+    }
+
+    if constexpr (delta) g.delta = pick(cdf_d1, cdf_d1 - V::broadcast(1.0));
+    if constexpr (gamma) g.gamma = pdf_d1 / (S * sigmaSqrtT);
+    if constexpr (vega) g.vega = S * pdf_d1 * sqrtT;
+    return g;
+}
+
+template <unsigned Mask, bool Calls, bool Puts, class V>
+GreeksOf<V> blackScholes(V K, V T, V S, V r, V sigma, typename V::Mask isCall) {
+    const V sqrtT = sqrt(T);
+    V discountedK{};
+    if constexpr ((Mask & (greek::Premium | greek::Theta | greek::Rho)) != 0) discountedK = K * simd::exp(-r * T);
+    return blackScholesFromInvariants<Mask, Calls, Puts>(S, simd::log(S / K), T, sqrtT, r, sigma, sigma * sqrtT, discountedK, isCall);
+}
+
+}
+
+// Black-Scholes for lanes that all hold the same option type, fixed at compile time.
+// V is a simd lane type (simd::ScalarD for a single option).
+template <OptionType Type, unsigned Mask, class V>
+GreeksOf<V> blackScholesKernel(V K, V T, V S, V r, V sigma) {
+    return pricing_detail::blackScholes<Mask, Type == OptionType::Call, Type == OptionType::Put>(K, T, S, r, sigma, K > K);
+}
+
+// Black-Scholes for lanes mixing calls and puts
+template <unsigned Mask, class V>
+GreeksOf<V> blackScholesKernel(typename V::Mask isCall, V K, V T, V S, V r, V sigma) {
+    return pricing_detail::blackScholes<Mask, true, true>(K, T, S, r, sigma, isCall);
+}
+
+// Black-Scholes from terms the caller keeps across calls for the same legs: log(S/K), sqrt(T),
+// sigma sqrt(T) and K e^(-rT), for lanes mixing calls and puts
+template <unsigned Mask, class V>
+GreeksOf<V> blackScholesKernel(typename V::Mask isCall, V S, V logMoneyness, V T, V sqrtT, V r, V sigma, V sigmaSqrtT, V discountedK) {
+    return pricing_detail::blackScholesFromInvariants<Mask, true, true>(S, logMoneyness, T, sqrtT, r, sigma, sigmaSqrtT, discountedK, isCall);
+}
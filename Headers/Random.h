@@ -0,0 +1,50 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+
+// Source of standard normal draws for the simulation engine. Draws are addressed by
+// (stream, index) so a range can be filled in any split across threads.
+class INormalGenerator {
+public:
+    virtual ~INormalGenerator() = default;
+
+    // Writes draws firstDraw .. firstDraw + out.size() - 1 of the given stream
+    virtual void fill(std::uint64_t stream, std::uint64_t firstDraw, std::span<double> out) const = 0;
+};
+
+// Counter-based Philox4x32-10 with a vectorized Box-Muller transform. A draw depends only
+// on (seed, stream, index), so results are bit-identical for any thread count or split.
+class PhiloxNormalGenerator : public INormalGenerator {
+    std::uint64_t seed_;
+
+public:
+    explicit PhiloxNormalGenerator(std::uint64_t seed);
+
+    void fill(std::uint64_t stream, std::uint64_t firstDraw, std::span<double> out) const override;
+
+    static std::array<std::uint32_t, 4> philox(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key);
+};
+
+// Owen-scrambled Sobol points (the first Sobol dimension, scrambled with the Laine-Karras
+// hash) mapped through the inverse normal CDF. The simulation needs one draw per path, so a
+// single dimension covers it; the first 2^k draws fill all 2^k equal-probability strata.
+class SobolNormalGenerator : public INormalGenerator {
+    std::uint64_t seed_;
+
+public:
+    explicit SobolNormalGenerator(std::uint64_t seed);
+
+    void fill(std::uint64_t stream, std::uint64_t firstDraw, std::span<double> out) const override;
+
+    // Scrambled point index in [0, 2^32) as 32 bits of the unit interval
+    static std::uint32_t point(std::uint32_t index, std::uint32_t scramble);
+    static double inverseNormalCDF(double p);
+};
+
+// The engine's original generator: a clock-seeded std::mt19937 per thread. Ignores the
+// draw indices, so runs are not reproducible.
+class MersenneNormalGenerator : public INormalGenerator {
+public:
+    void fill(std::uint64_t stream, std::uint64_t firstDraw, std::span<double> out) const override;
+};
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "Strategy.h"
+#include "VolatilitySurface.h"
+
+class ThreadPool;
+
+struct RiskGridAxes {
+    std::vector<double> spotShocks;    // relative moves: spot * (1 + shock)
+    std::vector<double> volShifts;     // added to every leg's surface vol
+    std::vector<double> daysForward;   // trading days from now
+};
+
+// One grid point. P&L is against the strategy's entry cost today; Greeks are net of leg
+// quantities with the BlackScholes conventions (daily theta, vega per 1.00 of vol).
+struct RiskCell {
+    double pnl;
+    double delta;
+    double gamma;
+    double theta;
+    double vega;
+};
+
+// P&L and Greeks cube of a strategy over spot shock x vol shift x days forward. Per-axis
+// intermediates are computed once and shared: log(S/K) per spot and leg, sqrt(T) and
+// K e^(-rT) per day and leg, and the surface vol per day, leg and spot, which every vol shift
+// reuses. Cells are stored [day][vol][spot], spot fastest, and filled in parallel tiles of
+// one (day, vol) row. Replacing an axis keeps the slices of the points it still contains and
+// computes only the new ones. Legs expired by a day are worth their intrinsic value.
+// The surface must outlive the grid.
+class RiskGrid {
+    struct LegDay {
+        double T;             // remaining time, <= 0 once expired
+        double sqrtT;
+        double discountedK;   // K e^(-rT)
+    };
+
+    Strategy strategy_;
+    double spot_;
+    double r_;
+    const IVolatilitySurface& volSurface_;
+    ThreadPool* pool_;
+    double entryCost_ = 0.0;
+    RiskGridAxes axes_;
+
+    std::vector<double> spots_;          // [spot]
+    std::vector<double> logMoneyness_;   // [leg][spot]
+    std::vector<LegDay> legDays_;        // [day][leg]
+    std::vector<double> baseVols_;       // [day][leg][spot]
+    std::vector<double> pnl_, delta_, gamma_, theta_, vega_;   // [day][vol][spot]
+
+    // Moves to `axes`: each map gives, per point of the new axis, its index on the current
+    // axis or SIZE_MAX when it is new. Returns the number of cells computed.
+    std::size_t rebuild(RiskGridAxes axes, const std::vector<std::size_t>& dayMap,
+                        const std::vector<std::size_t>& volMap, const std::vector<std::size_t>& spotMap);
+
+public:
+    // pool nullptr runs on ThreadPool::shared()
+    RiskGrid(Strategy strategy, double spot, double r, const IVolatilitySurface& volSurface, RiskGridAxes axes, ThreadPool* pool = nullptr);
+
+    // Each returns the number of cells recomputed
+    std::size_t setSpotShocks(std::vector<double> spotShocks);
+    std::size_t setVolShifts(std::vector<double> volShifts);
+    std::size_t setDaysForward(std::vector<double> daysForward);
+
+    [[nodiscard]] const RiskGridAxes& axes() const { return axes_; }
+    [[nodiscard]] double entryCost() const { return entryCost_; }
+
+    [[nodiscard]] std::size_t index(std::size_t day, std::size_t vol, std::size_t spot) const {
+        return (day * axes_.volShifts.size() + vol) * axes_.spotShocks.size() + spot;
+    }
+    [[nodiscard]] RiskCell at(std::size_t day, std::size_t vol, std::size_t spot) const;
+
+    [[nodiscard]] std::span<const double> pnl() const { return pnl_; }
+    [[nodiscard]] std::span<const double> delta() const { return delta_; }
+    [[nodiscard]] std::span<const double> gamma() const { return gamma_; }
+    [[nodiscard]] std::span<const double> theta() const { return theta_; }
+    [[nodiscard]] std::span<const double> vega() const { return vega_; }
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+#include "OptionWizard.h"
+#include "Strategy.h"
+
+// The inputs of one interactive session, read from a file record. Field names in CSV headers
+// and JSONL keys match the members (vol for atmVol). expectedReturn and rate are fractions.
+struct Scenario {
+    std::string id;                      // echoed in the output; the record number when absent
+    double spot;
+    double target;
+    double targetDays;
+    double expiryDays;                   // at or after targetDays
+    double expectedReturn = 0.08;
+    std::optional<double> marketPrice;   // ATM call to the target date; its implied vol is the ATM vol
+    std::optional<double> atmVol;        // used when there is no market price or it does not invert
+    double slope = -0.2;
+    double convexity = 1.0;
+    double rate = 0.05;
+};
+
+enum class RecordFormat { Csv, Jsonl };
+
+struct ScenarioRunOptions {
+    ThreadPool* pool = nullptr;     // nullptr runs on ThreadPool::shared()
+    std::size_t window = 256;       // records read, evaluated and written per round; bounds memory
+    // How each scenario is evaluated. Analytic by default, which is what makes thousands of
+    // scenarios per second possible; with analytic off and a seed, scenario i uses seed + i.
+    SimulationOptions simulation = [] { SimulationOptions o; o.analytic = true; return o; }();
+};
+
+struct ScenarioRunSummary {
+    std::size_t scenarios = 0;
+    std::size_t failed = 0;         // records that did not parse or evaluate; written as error rows
+};
+
+class ScenarioRunner {
+public:
+    // The strategy set of the interactive mode, struck around the spot
+    static std::vector<Strategy> strategies(double spot, double expiryDays);
+
+    // ATM vol of the scenario's surface: implied from the market price when it inverts,
+    // else atmVol, else 30%
+    static double atmVol(const Scenario& scenario);
+
+    static std::vector<result> evaluate(const Scenario& scenario, const SimulationOptions& options = {});
+
+    // Streams records from in and writes one row per strategy to out, in input order.
+    // CSV input needs a header row. Records run in parallel, `window` at a time.
+    static ScenarioRunSummary run(std::istream& in, RecordFormat inFormat, std::ostream& out, RecordFormat outFormat,
+                                  const ScenarioRunOptions& options = {});
+
+    // Jsonl for .jsonl / .json / .ndjson paths, Csv otherwise
+    static RecordFormat formatOf(const std::string& path);
+};
@@ -0,0 +1,552 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+// Thin wrappers over the vector registers the pricing kernels run on.
+// Kernels are written once against this interface and instantiated for the widest
+// type the compiler was allowed to target (NativeD), with ScalarD for remainders; NativeF and
+// ScalarF are the single-precision counterparts.
+namespace simd {
+
+struct ScalarD {
+    using value_type = double;
+    static constexpr std::size_t width = 1;
+    static constexpr const char* name = "scalar";
+
+    struct Mask {
+        bool m;
+        friend Mask operator&(Mask a, Mask b) { return {a.m && b.m}; }
+        friend Mask operator|(Mask a, Mask b) { return {a.m || b.m}; }
+        friend Mask operator!(Mask a) { return {!a.m}; }
+        [[nodiscard]] unsigned bits() const { return m ? 1u : 0u; }
+    };
+
+    double v;
+
+    static ScalarD load(const double* p) { return {*p}; }
+    static ScalarD broadcast(double x) { return {x}; }
+    void store(double* p) const { *p = v; }
+
+    friend ScalarD operator+(ScalarD a, ScalarD b) { return {a.v + b.v}; }
+    friend ScalarD operator-(ScalarD a, ScalarD b) { return {a.v - b.v}; }
+    friend ScalarD operator*(ScalarD a, ScalarD b) { return {a.v * b.v}; }
+    friend ScalarD operator/(ScalarD a, ScalarD b) { return {a.v / b.v}; }
+    friend ScalarD operator-(ScalarD a) { return {-a.v}; }
+
+    friend Mask operator<(ScalarD a, ScalarD b) { return {a.v < b.v}; }
+    friend Mask operator<=(ScalarD a, ScalarD b) { return {a.v <= b.v}; }
+    friend Mask operator>(ScalarD a, ScalarD b) { return {a.v > b.v}; }
+    friend Mask operator>=(ScalarD a, ScalarD b) { return {a.v >= b.v}; }
+
+    friend ScalarD mulAdd(ScalarD a, ScalarD b, ScalarD c) { return {a.v * b.v + c.v}; }
+    friend ScalarD sqrt(ScalarD a) { return {std::sqrt(a.v)}; }
+    friend ScalarD abs(ScalarD a) { return {std::abs(a.v)}; }
+    friend ScalarD min(ScalarD a, ScalarD b) { return {std::min(a.v, b.v)}; }
+    friend ScalarD max(ScalarD a, ScalarD b) { return {std::max(a.v, b.v)}; }
+    friend ScalarD round(ScalarD a) { return {std::nearbyint(a.v)}; }
+    friend ScalarD select(Mask m, ScalarD a, ScalarD b) { return m.m ? a : b; }
+
+    // x * 2^n for integral n within the normal exponent range
+    friend ScalarD scale2(ScalarD x, ScalarD n) { return {std::ldexp(x.v, static_cast<int>(n.v))}; }
+    // positive normal x = m * 2^e with m in [1, 2)
+    friend void splitExponent(ScalarD x, ScalarD& m, ScalarD& e) {
+        int exponent{};
+        m.v = 2.0 * std::frexp(x.v, &exponent);
+        e.v = exponent - 1;
+    }
+};
+
+// One lane gains nothing from the polynomial kernels below; defer to libm
+inline ScalarD exp(ScalarD x) { return {std::exp(x.v)}; }
+inline ScalarD log(ScalarD x) { return {std::log(x.v)}; }
+inline ScalarD normalTail(ScalarD x, ScalarD /*density*/) { return {0.5 * std::erfc(std::abs(x.v) / std::sqrt(2.0))}; }
+inline void sinCos2Pi(ScalarD u, ScalarD& sine, ScalarD& cosine) {
+    constexpr double TWO_PI = 6.283185307179586;
+    sine.v = std::sin(TWO_PI * u.v);
+    cosine.v = std::cos(TWO_PI * u.v);
+}
+
+// Single-precision lanes for the float pricing tier. Besides float loads and stores they read
+// and write double arrays, converting on the way, so kernels can run on double inputs.
+struct ScalarF {
+    using value_type = float;
+    static constexpr std::size_t width = 1;
+    static constexpr const char* name = "scalar float";
+
+    using Mask = ScalarD::Mask;
+
+    float v;
+
+    static ScalarF load(const float* p) { return {*p}; }
+    static ScalarF load(const double* p) { return {static_cast<float>(*p)}; }
+    static ScalarF broadcast(double x) { return {static_cast<float>(x)}; }
+    void store(float* p) const { *p = v; }
+    void store(double* p) const { *p = v; }
+
+    friend ScalarF operator+(ScalarF a, ScalarF b) { return {a.v + b.v}; }
+    friend ScalarF operator-(ScalarF a, ScalarF b) { return {a.v - b.v}; }
+    friend ScalarF operator*(ScalarF a, ScalarF b) { return {a.v * b.v}; }
+    friend ScalarF operator/(ScalarF a, ScalarF b) { return {a.v / b.v}; }
+    friend ScalarF operator-(ScalarF a) { return {-a.v}; }
+
+    friend Mask operator<(ScalarF a, ScalarF b) { return {a.v < b.v}; }
+    friend Mask operator<=(ScalarF a, ScalarF b) { return {a.v <= b.v}; }
+    friend Mask operator>(ScalarF a, ScalarF b) { return {a.v > b.v}; }
+    friend Mask operator>=(ScalarF a, ScalarF b) { return {a.v >= b.v}; }
+
+    friend ScalarF mulAdd(ScalarF a, ScalarF b, ScalarF c) { return {a.v * b.v + c.v}; }
+    friend ScalarF sqrt(ScalarF a) { return {std::sqrt(a.v)}; }
+    friend ScalarF abs(ScalarF a) { return {std::abs(a.v)}; }
+    friend ScalarF min(ScalarF a, ScalarF b) { return {std::min(a.v, b.v)}; }
+    friend ScalarF max(ScalarF a, ScalarF b) { return {std::max(a.v, b.v)}; }
+    friend ScalarF round(ScalarF a) { return {std::nearbyint(a.v)}; }
+    friend ScalarF select(Mask m, ScalarF a, ScalarF b) { return m.m ? a : b; }
+
+    friend ScalarF scale2(ScalarF x, ScalarF n) { return {std::ldexp(x.v, static_cast<int>(n.v))}; }
+    friend void splitExponent(ScalarF x, ScalarF& m, ScalarF& e) {
+        int exponent{};
+        m.v = 2.0f * std::frexp(x.v, &exponent);
+        e.v = static_cast<float>(exponent - 1);
+    }
+};
+
+inline ScalarF exp(ScalarF x) { return {std::exp(x.v)}; }
+inline ScalarF log(ScalarF x) { return {std::log(x.v)}; }
+inline ScalarF normalTail(ScalarF x, ScalarF /*density*/) { return {0.5f * std::erfc(std::abs(x.v) / std::sqrt(2.0f))}; }
+
+#if defined(__AVX2__) && defined(__FMA__)
+struct Avx2D {
+    using value_type = double;
+    static constexpr std::size_t width = 4;
+    static constexpr const char* name = "avx2";
+
+    struct Mask {
+        __m256d m;
+        friend Mask operator&(Mask a, Mask b) { return {_mm256_and_pd(a.m, b.m)}; }
+        friend Mask operator|(Mask a, Mask b) { return {_mm256_or_pd(a.m, b.m)}; }
+        friend Mask operator!(Mask a) { return {_mm256_xor_pd(a.m, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)))}; }
+        [[nodiscard]] unsigned bits() const { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+    };
+
+    __m256d v;
+
+    static Avx2D load(const double* p) { return {_mm256_loadu_pd(p)}; }
+    static Avx2D broadcast(double x) { return {_mm256_set1_pd(x)}; }
+    void store(double* p) const { _mm256_storeu_pd(p, v); }
+
+    friend Avx2D operator+(Avx2D a, Avx2D b) { return {_mm256_add_pd(a.v, b.v)}; }
+    friend Avx2D operator-(Avx2D a, Avx2D b) { return {_mm256_sub_pd(a.v, b.v)}; }
+    friend Avx2D operator*(Avx2D a, Avx2D b) { return {_mm256_mul_pd(a.v, b.v)}; }
+    friend Avx2D operator/(Avx2D a, Avx2D b) { return {_mm256_div_pd(a.v, b.v)}; }
+    friend Avx2D operator-(Avx2D a) { return {_mm256_xor_pd(a.v, _mm256_set1_pd(-0.0))}; }
+
+    friend Mask operator<(Avx2D a, Avx2D b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+    friend Mask operator<=(Avx2D a, Avx2D b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ)}; }
+    friend Mask operator>(Avx2D a, Avx2D b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+    friend Mask operator>=(Avx2D a, Avx2D b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ)}; }
+
+    friend Avx2D mulAdd(Avx2D a, Avx2D b, Avx2D c) { return {_mm256_fmadd_pd(a.v, b.v, c.v)}; }
+    friend Avx2D sqrt(Avx2D a) { return {_mm256_sqrt_pd(a.v)}; }
+    friend Avx2D abs(Avx2D a) { return {_mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v)}; }
+    friend Avx2D min(Avx2D a, Avx2D b) { return {_mm256_min_pd(a.v, b.v)}; }
+    friend Avx2D max(Avx2D a, Avx2D b) { return {_mm256_max_pd(a.v, b.v)}; }
+    friend Avx2D round(Avx2D a) { return {_mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    friend Avx2D select(Mask m, Avx2D a, Avx2D b) { return {_mm256_blendv_pd(b.v, a.v, m.m)}; }
+
+    friend Avx2D scale2(Avx2D x, Avx2D n) {
+        // n + 1023 lands in the low mantissa bits of (n + 2^52 + 1023); shift it into the exponent field
+        const __m256d biased = _mm256_add_pd(n.v, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+        const __m256i bits = _mm256_slli_epi64(_mm256_castpd_si256(biased), 52);
+        return {_mm256_mul_pd(x.v, _mm256_castsi256_pd(bits))};
+    }
+    friend void splitExponent(Avx2D x, Avx2D& m, Avx2D& e) {
+        const __m256i bits = _mm256_castpd_si256(x.v);
+        const __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+        m.v = _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3FF0000000000000LL)));
+        const __m256i exponent = _mm256_srli_epi64(bits, 52);
+        const __m256d magic = _mm256_set1_pd(4503599627370496.0);
+        const __m256d biased = _mm256_castsi256_pd(_mm256_or_si256(exponent, _mm256_castpd_si256(magic)));
+        e.v = _mm256_sub_pd(biased, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+    }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct Avx512D {
+    using value_type = double;
+    static constexpr std::size_t width = 8;
+    static constexpr const char* name = "avx512";
+
+    struct Mask {
+        __mmask8 m;
+        friend Mask operator&(Mask a, Mask b) { return {static_cast<__mmask8>(a.m & b.m)}; }
+        friend Mask operator|(Mask a, Mask b) { return {static_cast<__mmask8>(a.m | b.m)}; }
+        friend Mask operator!(Mask a) { return {static_cast<__mmask8>(~a.m)}; }
+        [[nodiscard]] unsigned bits() const { return m; }
+    };
+
+    __m512d v;
+
+    static Avx512D load(const double* p) { return {_mm512_loadu_pd(p)}; }
+    static Avx512D broadcast(double x) { return {_mm512_set1_pd(x)}; }
+    void store(double* p) const { _mm512_storeu_pd(p, v); }
+
+    friend Avx512D operator+(Avx512D a, Avx512D b) { return {_mm512_add_pd(a.v, b.v)}; }
+    friend Avx512D operator-(Avx512D a, Avx512D b) { return {_mm512_sub_pd(a.v, b.v)}; }
+    friend Avx512D operator*(Avx512D a, Avx512D b) { return {_mm512_mul_pd(a.v, b.v)}; }
+    friend Avx512D operator/(Avx512D a, Avx512D b) { return {_mm512_div_pd(a.v, b.v)}; }
+    friend Avx512D operator-(Avx512D a) { return {_mm512_sub_pd(_mm512_setzero_pd(), a.v)}; }
+
+    friend Mask operator<(Avx512D a, Avx512D b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ)}; }
+    friend Mask operator<=(Avx512D a, Avx512D b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ)}; }
+    friend Mask operator>(Avx512D a, Avx512D b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ)}; }
+    friend Mask operator>=(Avx512D a, Avx512D b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ)}; }
+
+    friend Avx512D mulAdd(Avx512D a, Avx512D b, Avx512D c) { return {_mm512_fmadd_pd(a.v, b.v, c.v)}; }
+    friend Avx512D sqrt(Avx512D a) { return {_mm512_sqrt_pd(a.v)}; }
+    friend Avx512D abs(Avx512D a) { return {_mm512_abs_pd(a.v)}; }
+    friend Avx512D min(Avx512D a, Avx512D b) { return {_mm512_min_pd(a.v, b.v)}; }
+    friend Avx512D max(Avx512D a, Avx512D b) { return {_mm512_max_pd(a.v, b.v)}; }
+    friend Avx512D round(Avx512D a) { return {_mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    friend Avx512D select(Mask m, Avx512D a, Avx512D b) { return {_mm512_mask_blend_pd(m.m, b.v, a.v)}; }
+
+    friend Avx512D scale2(Avx512D x, Avx512D n) { return {_mm512_scalef_pd(x.v, n.v)}; }
+    friend void splitExponent(Avx512D x, Avx512D& m, Avx512D& e) {
+        m.v = _mm512_getmant_pd(x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+        e.v = _mm512_getexp_pd(x.v);
+    }
+};
+#endif
+
+#if defined(__AVX2__) && defined(__FMA__)
+struct Avx2F {
+    using value_type = float;
+    static constexpr std::size_t width = 8;
+    static constexpr const char* name = "avx2 float";
+
+    struct Mask {
+        __m256 m;
+        friend Mask operator&(Mask a, Mask b) { return {_mm256_and_ps(a.m, b.m)}; }
+        friend Mask operator|(Mask a, Mask b) { return {_mm256_or_ps(a.m, b.m)}; }
+        friend Mask operator!(Mask a) { return {_mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+        [[nodiscard]] unsigned bits() const { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+    };
+
+    __m256 v;
+
+    static Avx2F load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    static Avx2F load(const double* p) {
+        return {_mm256_set_m128(_mm256_cvtpd_ps(_mm256_loadu_pd(p + 4)), _mm256_cvtpd_ps(_mm256_loadu_pd(p)))};
+    }
+    static Avx2F broadcast(double x) { return {_mm256_set1_ps(static_cast<float>(x))}; }
+    void store(float* p) const { _mm256_storeu_ps(p, v); }
+    void store(double* p) const {
+        _mm256_storeu_pd(p, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+        _mm256_storeu_pd(p + 4, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+    }
+
+    friend Avx2F operator+(Avx2F a, Avx2F b) { return {_mm256_add_ps(a.v, b.v)}; }
+    friend Avx2F operator-(Avx2F a, Avx2F b) { return {_mm256_sub_ps(a.v, b.v)}; }
+    friend Avx2F operator*(Avx2F a, Avx2F b) { return {_mm256_mul_ps(a.v, b.v)}; }
+    friend Avx2F operator/(Avx2F a, Avx2F b) { return {_mm256_div_ps(a.v, b.v)}; }
+    friend Avx2F operator-(Avx2F a) { return {_mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f))}; }
+
+    friend Mask operator<(Avx2F a, Avx2F b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+    friend Mask operator<=(Avx2F a, Avx2F b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+    friend Mask operator>(Avx2F a, Avx2F b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+    friend Mask operator>=(Avx2F a, Avx2F b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+
+    friend Avx2F mulAdd(Avx2F a, Avx2F b, Avx2F c) { return {_mm256_fmadd_ps(a.v, b.v, c.v)}; }
+    friend Avx2F sqrt(Avx2F a) { return {_mm256_sqrt_ps(a.v)}; }
+    friend Avx2F abs(Avx2F a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+    friend Avx2F min(Avx2F a, Avx2F b) { return {_mm256_min_ps(a.v, b.v)}; }
+    friend Avx2F max(Avx2F a, Avx2F b) { return {_mm256_max_ps(a.v, b.v)}; }
+    friend Avx2F round(Avx2F a) { return {_mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    friend Avx2F select(Mask m, Avx2F a, Avx2F b) { return {_mm256_blendv_ps(b.v, a.v, m.m)}; }
+
+    friend Avx2F scale2(Avx2F x, Avx2F n) {
+        // same trick as Avx2D with the 23-bit float mantissa
+        const __m256 biased = _mm256_add_ps(n.v, _mm256_set1_ps(8388608.0f + 127.0f));
+        const __m256i bits = _mm256_slli_epi32(_mm256_castps_si256(biased), 23);
+        return {_mm256_mul_ps(x.v, _mm256_castsi256_ps(bits))};
+    }
+    friend void splitExponent(Avx2F x, Avx2F& m, Avx2F& e) {
+        const __m256i bits = _mm256_castps_si256(x.v);
+        const __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi32(0x007FFFFF));
+        m.v = _mm256_castsi256_ps(_mm256_or_si256(mantissa, _mm256_set1_epi32(0x3F800000)));
+        const __m256i exponent = _mm256_srli_epi32(bits, 23);
+        const __m256 magic = _mm256_set1_ps(8388608.0f);
+        const __m256 biased = _mm256_castsi256_ps(_mm256_or_si256(exponent, _mm256_castps_si256(magic)));
+        e.v = _mm256_sub_ps(biased, _mm256_set1_ps(8388608.0f + 127.0f));
+    }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct Avx512F {
+    using value_type = float;
+    static constexpr std::size_t width = 16;
+    static constexpr const char* name = "avx512 float";
+
+    struct Mask {
+        __mmask16 m;
+        friend Mask operator&(Mask a, Mask b) { return {static_cast<__mmask16>(a.m & b.m)}; }
+        friend Mask operator|(Mask a, Mask b) { return {static_cast<__mmask16>(a.m | b.m)}; }
+        friend Mask operator!(Mask a) { return {static_cast<__mmask16>(~a.m)}; }
+        [[nodiscard]] unsigned bits() const { return m; }
+    };
+
+    __m512 v;
+
+    static Avx512F load(const float* p) { return {_mm512_loadu_ps(p)}; }
+    static Avx512F load(const double* p) {
+        const __m256 lo = _mm512_cvtpd_ps(_mm512_loadu_pd(p));
+        const __m256 hi = _mm512_cvtpd_ps(_mm512_loadu_pd(p + 8));
+        return {_mm512_castpd_ps(_mm512_insertf64x4(_mm512_castps_pd(_mm512_castps256_ps512(lo)), _mm256_castps_pd(hi), 1))};
+    }
+    static Avx512F broadcast(double x) { return {_mm512_set1_ps(static_cast<float>(x))}; }
+    void store(float* p) const { _mm512_storeu_ps(p, v); }
+    void store(double* p) const {
+        _mm512_storeu_pd(p, _mm512_cvtps_pd(_mm512_castps512_ps256(v)));
+        _mm512_storeu_pd(p + 8, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1))));
+    }
+
+    friend Avx512F operator+(Avx512F a, Avx512F b) { return {_mm512_add_ps(a.v, b.v)}; }
+    friend Avx512F operator-(Avx512F a, Avx512F b) { return {_mm512_sub_ps(a.v, b.v)}; }
+    friend Avx512F operator*(Avx512F a, Avx512F b) { return {_mm512_mul_ps(a.v, b.v)}; }
+    friend Avx512F operator/(Avx512F a, Avx512F b) { return {_mm512_div_ps(a.v, b.v)}; }
+    friend Avx512F operator-(Avx512F a) { return {_mm512_sub_ps(_mm512_setzero_ps(), a.v)}; }
+
+    friend Mask operator<(Avx512F a, Avx512F b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)}; }
+    friend Mask operator<=(Avx512F a, Avx512F b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)}; }
+    friend Mask operator>(Avx512F a, Avx512F b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)}; }
+    friend Mask operator>=(Avx512F a, Avx512F b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)}; }
+
+    friend Avx512F mulAdd(Avx512F a, Avx512F b, Avx512F c) { return {_mm512_fmadd_ps(a.v, b.v, c.v)}; }
+    friend Avx512F sqrt(Avx512F a) { return {_mm512_sqrt_ps(a.v)}; }
+    friend Avx512F abs(Avx512F a) { return {_mm512_abs_ps(a.v)}; }
+    friend Avx512F min(Avx512F a, Avx512F b) { return {_mm512_min_ps(a.v, b.v)}; }
+    friend Avx512F max(Avx512F a, Avx512F b) { return {_mm512_max_ps(a.v, b.v)}; }
+    friend Avx512F round(Avx512F a) { return {_mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)}; }
+    friend Avx512F select(Mask m, Avx512F a, Avx512F b) { return {_mm512_mask_blend_ps(m.m, b.v, a.v)}; }
+
+    friend Avx512F scale2(Avx512F x, Avx512F n) { return {_mm512_scalef_ps(x.v, n.v)}; }
+    friend void splitExponent(Avx512F x, Avx512F& m, Avx512F& e) {
+        m.v = _mm512_getmant_ps(x.v, _MM_MANT_NORM_1_2, _MM_MANT_SIGN_src);
+        e.v = _mm512_getexp_ps(x.v);
+    }
+};
+#endif
+
+#if defined(__AVX512F__)
+using NativeD = Avx512D;
+#elif defined(__AVX2__) && defined(__FMA__)
+using NativeD = Avx2D;
+#else
+using NativeD = ScalarD;
+#endif
+
+#if defined(__AVX512F__)
+using NativeF = Avx512F;
+#elif defined(__AVX2__) && defined(__FMA__)
+using NativeF = Avx2F;
+#else
+using NativeF = ScalarF;
+#endif
+
+// float lanes carry about 7 significant digits; the math kernels below trim their series to match
+template <class V>
+inline constexpr bool singlePrecision = std::is_same_v<typename V::value_type, float>;
+
+// ---- math kernels ----
+
+template <class V>
+V exp(V x) {
+    // e^x = 2^n * e^r with |r| <= ln2/2, Taylor series to 13th order
+    constexpr double LOG2E = 1.4426950408889634;
+    constexpr double LN2_HI = 6.93147180369123816490e-01;
+    constexpr double LN2_LO = 1.90821492927058770002e-10;
+    if constexpr (singlePrecision<V>) x = min(max(x, V::broadcast(-87.0)), V::broadcast(88.0));
+    else x = min(max(x, V::broadcast(-708.0)), V::broadcast(709.0));
+
+    const V n = round(x * V::broadcast(LOG2E));
+    V r = mulAdd(n, V::broadcast(-LN2_HI), x);
+    r = mulAdd(n, V::broadcast(-LN2_LO), r);
+
+    if constexpr (singlePrecision<V>) {
+        // 7th order is within float rounding on |r| <= ln2/2
+        V p = V::broadcast(1.0 / 5040.0);
+        p = mulAdd(p, r, V::broadcast(1.0 / 720.0));
+        p = mulAdd(p, r, V::broadcast(1.0 / 120.0));
+        p = mulAdd(p, r, V::broadcast(1.0 / 24.0));
+        p = mulAdd(p, r, V::broadcast(1.0 / 6.0));
+        p = mulAdd(p, r, V::broadcast(0.5));
+        p = mulAdd(p, r, V::broadcast(1.0));
+        p = mulAdd(p, r, V::broadcast(1.0));
+        return scale2(p, n);
+    }
+
+    V p = V::broadcast(1.0 / 6227020800.0);
+    p = mulAdd(p, r, V::broadcast(1.0 / 479001600.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 39916800.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 3628800.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 362880.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 40320.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 5040.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 720.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 120.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 24.0));
+    p = mulAdd(p, r, V::broadcast(1.0 / 6.0));
+    p = mulAdd(p, r, V::broadcast(0.5));
+    p = mulAdd(p, r, V::broadcast(1.0));
+    p = mulAdd(p, r, V::broadcast(1.0));
+
+    return scale2(p, n);
+}
+
+// Natural log for positive, normal inputs; other lanes are undefined and must be masked by the caller
+template <class V>
+V log(V x) {
+    constexpr double LN2_HI = 6.93147180369123816490e-01;
+    constexpr double LN2_LO = 1.90821492927058770002e-10;
+    constexpr double SQRT2 = 1.4142135623730951;
+
+    V m{}, e{};
+    splitExponent(x, m, e);
+    const auto big = m > V::broadcast(SQRT2);
+    m = select(big, m * V::broadcast(0.5), m);
+    e = select(big, e + V::broadcast(1.0), e);
+
+    // log(m) = 2 atanh(f), f = (m - 1) / (m + 1), |f| < 0.172
+    const V one = V::broadcast(1.0);
+    const V f = (m - one) / (m + one);
+    const V f2 = f * f;
+    const V two = V::broadcast(2.0);
+    if constexpr (singlePrecision<V>) {
+        V s = V::broadcast(1.0 / 11.0);
+        s = mulAdd(s, f2, V::broadcast(1.0 / 9.0));
+        s = mulAdd(s, f2, V::broadcast(1.0 / 7.0));
+        s = mulAdd(s, f2, V::broadcast(1.0 / 5.0));
+        s = mulAdd(s, f2, V::broadcast(1.0 / 3.0));
+        s = s * f2 * f;
+        return mulAdd(e, V::broadcast(LN2_HI), mulAdd(two, s, mulAdd(e, V::broadcast(LN2_LO), two * f)));
+    }
+
+    V s = V::broadcast(1.0 / 23.0);
+    s = mulAdd(s, f2, V::broadcast(1.0 / 21.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 19.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 17.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 15.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 13.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 11.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 9.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 7.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 5.0));
+    s = mulAdd(s, f2, V::broadcast(1.0 / 3.0));
+    s = s * f2 * f;
+
+    return mulAdd(e, V::broadcast(LN2_HI), mulAdd(two, s, mulAdd(e, V::broadcast(LN2_LO), two * f)));
+}
+
+template <class V>
+V normalPDF(V x) {
+    constexpr double INV_SQRT_2PI = 0.3989422804014327;
+    return V::broadcast(INV_SQRT_2PI) * exp(V::broadcast(-0.5) * x * x);
+}
+
+// Lower tail N(-|x|) = exp(-x^2/2) * M(t), where M is a Chebyshev fit of the scaled
+// Mills ratio in t = 4 / (4 + |x|); relative error within 3e-13 out to |x| = 37.5.
+// Takes the density at x so callers that already hold it skip the exp.
+template <class V>
+V normalTail(V x, V density) {
+    static constexpr double COEFFS[] = {
+        0.18061882894392295,     0.22734790079751807,     0.071709535345396036,    0.017121501580411477,
+        0.0029201803849831934,   0.0002899601855720405,   -2.5910985224837689e-06, -5.0591528487869841e-06,
+        -3.5164089527149413e-07, 8.5577714349034784e-08,  1.1207859658010425e-08,  -1.8928551055239722e-09,
+        -3.0012183319984948e-10, 5.6634800590338002e-11,  7.328825662553244e-12,   -2.0410583089221086e-12,
+        -1.3018355295401142e-13, 7.6820083252664031e-14,  -1.1872816352433797e-15, -2.6684134764523746e-15,
+        2.9562005243277998e-16,  7.1982558736252147e-17
+    };
+    // the series past the 12th term is below float resolution
+    constexpr std::size_t N = singlePrecision<V> ? 12 : sizeof(COEFFS) / sizeof(COEFFS[0]);
+    constexpr double T0 = 4.0 / 42.0;
+    constexpr double SQRT_2PI = 2.5066282746310002;
+
+    const V a = min(abs(x), V::broadcast(37.5));
+    const V t = V::broadcast(4.0) / (V::broadcast(4.0) + a);
+    const V y = mulAdd(t, V::broadcast(2.0 / (1.0 - T0)), V::broadcast(-(1.0 + T0) / (1.0 - T0)));
+    const V y2 = y + y;
+
+    // Clenshaw recurrence
+    V b1 = V::broadcast(0.0);
+    V b2 = V::broadcast(0.0);
+    for (std::size_t j = N - 1; j >= 1; --j) {
+        const V tmp = mulAdd(y2, b1, V::broadcast(COEFFS[j]) - b2);
+        b2 = b1;
+        b1 = tmp;
+    }
+    const V mills = mulAdd(y, b1, V::broadcast(COEFFS[0]) - b2);
+    return V::broadcast(SQRT_2PI) * density * mills;
+}
+
+// N(x) and N(-x) from a single tail evaluation
+template <class V>
+void normalCDFPair(V x, V density, V& cdf, V& cdfNeg) {
+    const V tail = normalTail(x, density);
+    const V upper = V::broadcast(1.0) - tail;
+    const auto positive = x > V::broadcast(0.0);
+    cdf = select(positive, upper, tail);
+    cdfNeg = select(positive, tail, upper);
+}
+
+template <class V>
+void normalCDFPair(V x, V& cdf, V& cdfNeg) {
+    normalCDFPair(x, normalPDF(x), cdf, cdfNeg);
+}
+
+// sin(2 pi u) and cos(2 pi u): reduce to the nearest quarter turn, Taylor series on [-pi/4, pi/4]
+template <class V>
+void sinCos2Pi(V u, V& sine, V& cosine) {
+    constexpr double TWO_PI = 6.283185307179586;
+    u = u - round(u);
+    const V quarter = round(u * V::broadcast(4.0));
+    const V a = (u - quarter * V::broadcast(0.25)) * V::broadcast(TWO_PI);
+    const V a2 = a * a;
+
+    V s = V::broadcast(1.0 / 1307674368000.0);
+    s = mulAdd(s, -a2, V::broadcast(1.0 / 6227020800.0));
+    s = mulAdd(s, -a2, V::broadcast(1.0 / 39916800.0));
+    s = mulAdd(s, -a2, V::broadcast(1.0 / 362880.0));
+    s = mulAdd(s, -a2, V::broadcast(1.0 / 5040.0));
+    s = mulAdd(s, -a2, V::broadcast(1.0 / 120.0));
+    s = mulAdd(s, -a2, V::broadcast(1.0 / 6.0));
+    s = mulAdd(s, -a2, V::broadcast(1.0));
+    s = s * a;
+
+    V c = V::broadcast(1.0 / 20922789888000.0);
+    c = mulAdd(c, -a2, V::broadcast(1.0 / 87178291200.0));
+    c = mulAdd(c, -a2, V::broadcast(1.0 / 479001600.0));
+    c = mulAdd(c, -a2, V::broadcast(1.0 / 3628800.0));
+    c = mulAdd(c, -a2, V::broadcast(1.0 / 40320.0));
+    c = mulAdd(c, -a2, V::broadcast(1.0 / 720.0));
+    c = mulAdd(c, -a2, V::broadcast(1.0 / 24.0));
+    c = mulAdd(c, -a2, V::broadcast(0.5));
+    c = mulAdd(c, -a2, V::broadcast(1.0));
+
+    // quarter is one of -2..2; rotate (sin, cos) by that many quarter turns
+    const V q = abs(quarter);
+    const auto positive = quarter > V::broadcast(0.0);
+    const auto odd = (q > V::broadcast(0.5)) & (q < V::broadcast(1.5));
+    const auto half = q > V::broadcast(1.5);
+    sine = select(odd, select(positive, c, -c), select(half, -s, s));
+    cosine = select(odd, select(positive, -s, s), select(half, -c, c));
+}
+
+}
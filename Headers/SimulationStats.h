@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct SimulationThreadStats {
+    std::size_t worker;       // pool worker index; the pool size for the calling thread
+    std::uint64_t blocks;
+    std::uint64_t paths;
+    double busySeconds;       // time spent simulating its blocks
+};
+
+// Where a simulateStrategies call spent its time. Setup, reduction and wall are wall-clock;
+// draws and valuation are wall-clock summed over the threads that ran blocks, so with more
+// threads than cores they include time a thread spent descheduled.
+struct SimulationStats {
+    bool instrumented = false;       // false when built with OPTIONS_WIZARD_INSTRUMENTATION=0
+    double setupSeconds = 0.0;       // pricing legs and controls, spline fits, analytic estimates
+    double drawSeconds = 0.0;        // normals, horizon spots and bridged paths
+    double valuationSeconds = 0.0;   // repricing legs on the paths, exit rules, accumulation
+    double reductionSeconds = 0.0;   // merging block statistics, sizing adaptive rounds, estimates
+    double wallSeconds = 0.0;
+    std::uint64_t paths = 0;
+    std::uint64_t rounds = 0;        // parallel rounds; more than one in adaptive mode
+    std::vector<SimulationThreadStats> threads;   // threads that ran at least one block
+
+    [[nodiscard]] double pathsPerSecond() const;
+    // slowest thread's busy time over the mean busy time; 1 is an even split
+    [[nodiscard]] double imbalance() const;
+
+    [[nodiscard]] std::string toJson() const;
+    // Prometheus text exposition format, one gauge family per figure
+    [[nodiscard]] std::string toPrometheus(std::string_view prefix = "options_wizard_simulation") const;
+};
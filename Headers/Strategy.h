@@ -29,4 +29,6 @@ public:
     static Strategy strangle(double K_lower, double K_higher, double T);
     static Strategy bearPutSpread(double K_higher, double K_lower, double T);
     static Strategy ironCondor(double K_put_long, double K_put_short, double K_call_short, double K_call_long, double T);
+    // Short the near expiry, long the far one, same strike and type
+    static Strategy calendarSpread(double K, double T_near, double T_far, OptionType type);
 };
\ No newline at end of file
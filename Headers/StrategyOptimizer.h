@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include "OptionWizard.h"
+#include "Strategy.h"
+#include "VolatilitySurface.h"
+
+enum class StrategyShape { BullCallSpread, BearPutSpread, Straddle, Strangle, IronCondor, CallCalendar, PutCalendar };
+
+enum class RankBy {
+    ExpectedValue,   // expected P&L at the horizon ($)
+    Pop,             // probability of profit
+    ReturnOnRisk     // expected P&L over max loss; candidates with unbounded loss are skipped
+};
+
+struct StrategySearchSpace {
+    std::vector<double> strikes;
+    std::vector<double> expiryDays;   // trading days; expiries before the horizon are skipped
+    std::vector<StrategyShape> shapes = {StrategyShape::BullCallSpread, StrategyShape::BearPutSpread, StrategyShape::Straddle,
+                                         StrategyShape::Strangle, StrategyShape::IronCondor, StrategyShape::CallCalendar,
+                                         StrategyShape::PutCalendar};
+    double maxWidth = 0.0;            // widest distance between a candidate's strikes, 0 for any
+};
+
+struct StrategyConstraints {
+    std::optional<double> maxCost;    // entry cost ($); credits are negative
+    std::optional<double> maxLoss;    // worst P&L at expiry, as a positive amount ($)
+    double minPop = 0.0;
+};
+
+struct OptimizerOptions {
+    RankBy rankBy = RankBy::ExpectedValue;
+    StrategyConstraints constraints;
+    std::size_t top = 10;
+    std::size_t survivors = 200;      // screened candidates that go on to the simulation
+    SimulationOptions simulation;     // the final run; its pool also runs the screen
+};
+
+struct RankedStrategy {
+    Strategy strategy;
+    double maxLoss;                   // payoff range at expiry as P&L; infinity when unbounded
+    double maxGain;
+    double screenScore;               // analytic score the candidate survived the screen with
+    result evaluation;                // the simulation
+    double score;
+};
+
+struct OptimizerSummary {
+    std::size_t candidates = 0;       // enumerated
+    std::size_t feasible = 0;         // within the cost and loss constraints
+    std::size_t screened = 0;         // valued analytically before the bounds stopped the screen
+    std::size_t simulated = 0;
+    std::vector<RankedStrategy> ranked;
+};
+
+// Searches strategy structures over a strike and expiry grid in three stages:
+//  1. Every candidate is priced from one batch of grid premiums and given its payoff range at
+//     expiry. That settles the cost and loss constraints and bounds the ranking metric: expected
+//     P&L cannot exceed the max gain, PoP is 0 without one, and return on risk cannot exceed
+//     max gain over max loss.
+//  2. Feasible candidates are valued with the analytic horizon estimate in order of falling
+//     bound, in parallel rounds, until the survivors-th best score beats every remaining bound.
+//  3. The survivors are simulated together on one set of paths and ranked.
+// Calendars are bounded at the near expiry, where the spread is worth at most the far option
+// at the strike. Screening is fastest when the horizon is at expiry, where the estimate is
+// closed form; before expiry it needs quadrature over the horizon draw.
+class StrategyOptimizer {
+public:
+    static OptimizerSummary search(const StrategySearchSpace& space, double spot, double target, double targetDays, double r,
+                                   const IVolatilitySurface& volSurface, double mu, double sigma, const OptimizerOptions& options = {});
+
+    // The ranking metric of a valued strategy; nullopt when it cannot be ranked by it
+    static std::optional<double> score(RankBy rankBy, const result& evaluation, double maxLoss);
+    static std::optional<double> score(RankBy rankBy, const CompactResult& evaluation, double maxLoss);
+};
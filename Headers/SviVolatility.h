@@ -0,0 +1,74 @@
+#pragma once
+#include <span>
+#include <vector>
+#include <cstddef>
+#include "VolatilitySurface.h"
+#include "ImpliedVolatility.h"
+
+class ThreadPool;
+
+// One expiry of an SSVI surface, in total variance w = vol^2 * T over k = ln(K/S):
+//   w(k) = theta/2 * (1 + rho*phi*k + sqrt((phi*k + rho)^2 + 1 - rho^2)),  phi = psi / theta
+// theta is the at-the-money total variance, rho the skew and psi = theta*phi the ATM
+// curvature scale. It is a raw SVI slice with a = theta(1-rho^2)/2, b = psi/2, m = -rho/phi,
+// sigma = sqrt(1-rho^2)/phi, and is free of butterfly arbitrage when
+// psi(1+|rho|) < 4 and psi^2(1+|rho|) <= 4 theta (Gatheral-Jacquier).
+struct SviSlice {
+    double expiry;
+    double theta;
+    double rho;
+    double psi;
+
+    [[nodiscard]] double totalVariance(double k) const;
+    [[nodiscard]] bool butterflyFree() const;
+};
+
+// Surface built from SSVI slices. Total variance is linear in T between slices at fixed k,
+// with constant vol beyond the first and last slice. A slice that dips below an earlier one
+// anywhere on |k| <= 4 is floored at it, so calendar spreads never price negative.
+class SviVolatility : public IVolatilitySurface {
+    std::vector<SviSlice> slices_;
+    std::vector<unsigned char> floored_;   // slice needs the running max over earlier slices
+
+    [[nodiscard]] double flooredVariance(std::size_t i, double k) const;
+    [[nodiscard]] double volAt(double k, double timeToExpiry) const;
+
+public:
+    explicit SviVolatility(std::vector<SviSlice> slices);
+
+    [[nodiscard]] double getVol(double strike, double timeToExpiry, double spot) const override;
+    void getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const override;
+    void getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const override;
+
+    [[nodiscard]] const std::vector<SviSlice>& slices() const;
+    // number of slices that cross below an earlier slice and are floored
+    [[nodiscard]] std::size_t calendarCrossings() const;
+};
+
+struct SviFitOptions {
+    ThreadPool* pool = nullptr;   // nullptr fits on ThreadPool::shared()
+    int maxIterations = 200;      // Levenberg-Marquardt iterations per slice
+    double tolerance = 1e-8;      // stop once a step improves the squared error by less than this, relatively
+};
+
+struct SviSliceFit {
+    double rmsError;       // implied vol error over the slice's quotes
+    int iterations;
+    std::size_t quotes;
+};
+
+struct SviCalibration {
+    SviVolatility surface;
+    std::vector<SviSliceFit> fits;   // one per surface slice
+};
+
+class SviCalibrator {
+public:
+    // Fits one SSVI slice per quoted expiry. Quotes are inverted with ImpliedVolatility::solveBatch
+    // (quotes that do not converge are dropped) and each slice is fitted to the implied vols by
+    // Levenberg-Marquardt with the analytic Jacobian, projected onto the butterfly-free region.
+    // Both steps run in parallel on options.pool. A previous calibration seeds the slices it
+    // shares an expiry with, so an intraday refit usually needs only a few iterations per slice.
+    // Expiries with fewer than three usable quotes are skipped.
+    static SviCalibration calibrate(const QuoteInputs& quotes, const SviVolatility* warmStart = nullptr, const SviFitOptions& options = {});
+};
@@ -0,0 +1,66 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ThreadPoolStats {
+    std::size_t workers;
+    std::size_t queued;       // tasks waiting in all worker queues
+    std::uint64_t executed;   // tasks run by workers and by waiting callers
+    std::uint64_t steals;     // tasks taken from another worker's queue
+};
+
+// Long-lived work-stealing executor. Each worker owns a deque: it pops its own work from the
+// back and steals from the front of the others. Callers of parallelFor help run tasks while
+// they wait, so nested and concurrent parallelFor calls cannot deadlock the pool.
+class ThreadPool {
+    struct Task {
+        std::function<void()> run;
+    };
+
+    struct alignas(64) Worker {
+        std::mutex mutex;
+        std::deque<Task> queue;
+        std::atomic<std::uint64_t> executed{0};
+        std::atomic<std::uint64_t> steals{0};
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::vector<std::thread> threads_;
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    std::atomic<std::size_t> pending_{0};
+    std::atomic<std::size_t> nextQueue_{0};
+    std::atomic<std::uint64_t> callerExecuted_{0};
+    bool stopping_ = false;
+
+    void workerLoop(std::size_t index);
+    bool tryRun(std::size_t home);
+
+public:
+    // threads 0 uses every hardware thread. pinThreads binds worker i to CPU i (Linux only).
+    explicit ThreadPool(unsigned threads = 0, bool pinThreads = false);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs body(i) for every i in [0, count) and returns once all calls have finished.
+    // The first exception thrown by body is rethrown here.
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
+
+    [[nodiscard]] std::size_t size() const { return workers_.size(); }
+    // Index of the calling thread among this pool's workers, size() for any other thread
+    [[nodiscard]] std::size_t currentWorker() const;
+    [[nodiscard]] ThreadPoolStats stats() const;
+
+    // Engine-wide pool, created on first use with one worker per hardware thread
+    static ThreadPool& shared();
+};
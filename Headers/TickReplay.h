@@ -0,0 +1,40 @@
+#pragma once
+#include <cstddef>
+#include <iosfwd>
+#include <span>
+#include <string>
+#include <vector>
+#include "TickRepricer.h"
+
+struct Tick {
+    double time;   // as given in the file; the replay does not pace by it
+    double spot;
+};
+
+// Tick-to-Greeks latency of one replay, in nanoseconds
+struct LatencyReport {
+    std::size_t ticks = 0;
+    double meanNs = 0.0;
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double p999Ns = 0.0;
+    double maxNs = 0.0;
+    // histogram[b] counts updates taking [2^b, 2^(b+1)) ns, except histogram[0], which also
+    // takes the 0 ns samples of a coarse clock and so covers [0, 2)
+    std::vector<std::size_t> histogram;
+
+    // Percentile line followed by one row per non-empty histogram bucket
+    [[nodiscard]] std::string toString() const;
+};
+
+class TickReplay {
+public:
+    // CSV with a header row naming a spot (or price) column and optionally a time column, or
+    // one bare spot per line. Throws std::invalid_argument on a malformed or non-positive spot
+    // or a malformed time.
+    static std::vector<Tick> read(std::istream& in);
+
+    // Feeds the ticks to the repricer in order and times each update back to back. The ticks
+    // are parsed and the samples allocated beforehand, so only onTick() is inside the clock.
+    static LatencyReport replay(TickRepricer& repricer, std::span<const Tick> ticks);
+};
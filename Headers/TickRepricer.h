@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "Greeks.h"
+#include "PortfolioBook.h"
+#include "Strategy.h"
+#include "VolatilitySurface.h"
+
+// Reprices a fixed set of legs on every spot tick. Everything that depends only on strike,
+// expiry and vol is computed once: log K, sqrt(T), sigma sqrt(T) and K e^(-rT). A tick then
+// costs one log for the spot and a pass of the shared Black-Scholes kernel over the legs, in
+// place, with no allocation. Vols are sticky-strike: they are looked up at construction and
+// again only on refreshVols(). Columns are padded to whole SIMD registers; padding lanes hold
+// zero quantity.
+class TickRepricer {
+    std::size_t legs_ = 0;
+    double r_;
+    double spot_;
+    const IVolatilitySurface& volSurface_;
+
+    // per leg, padded
+    std::vector<double> strikes_, expiries_, quantities_, isCall_;
+    std::vector<double> logK_, sqrtT_, sigma_, sigmaSqrtT_, discountedK_;
+    // per-contract outputs of the last tick, padded
+    std::vector<double> premium_, delta_, gamma_, theta_, vega_, rho_;
+    Greeks net_{};
+
+    void resize(std::size_t padded);
+    void precompute();   // from strikes, expiries and sigma_
+
+public:
+    // Throws std::invalid_argument for a non-positive spot, strike or expiry
+    TickRepricer(std::span<const BookPosition> positions, double spot, double r, const IVolatilitySurface& volSurface);
+    TickRepricer(const std::vector<Strategy>& strategies, double spot, double r, const IVolatilitySurface& volSurface);
+
+    // Reprices every leg at the new spot and returns the quantity-weighted totals
+    const Greeks& onTick(double spot);
+    // Looks the vols up again at the current spot and reprices
+    const Greeks& refreshVols();
+
+    [[nodiscard]] const Greeks& net() const { return net_; }
+    [[nodiscard]] double spot() const { return spot_; }
+    [[nodiscard]] std::size_t size() const { return legs_; }
+    // Per-contract Greeks of one leg at the last tick
+    [[nodiscard]] Greeks leg(std::size_t index) const;
+};
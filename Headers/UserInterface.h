@@ -48,11 +48,12 @@ namespace UI {
     }
 
     void printTable(const std::vector<result>& results) {
-        std::cout << "\n" << std::string(110, '-') << std::endl;
+        std::cout << "\n" << std::string(120, '-') << std::endl;
         printf("%-20s", "");
         printf("%-10s", "Cost ($)");
         printf("%-15s", "Projected ($)");
         printf("%-13s", "Exp Val ($)");
+        printf("%-10s", "+/- SE");
         printf("%-13s", "Return (%)");
         printf("%-10s", "PoP (%)");
         printf("%-8s", "Delta");
@@ -68,6 +69,7 @@ namespace UI {
             printf("%-10.3f", res.entryCost);
             printf("%-15.3f", res.projectedValue);
             printf("%-13.3f", res.expectedValue);
+            printf("%-10.3f", res.expectedValueStdError);
             printf("%-13.2f", res.profitPercent);
             printf("%-10.2f", (res.pop * 100.0));
             printf("%-8.2f", res.netGreeks.delta);
@@ -77,6 +79,6 @@ namespace UI {
 
             printf("\n");
         }
-        std::cout << std::string(110, '-') << "\n";
+        std::cout << std::string(120, '-') << "\n";
     }
 }
\ No newline at end of file
@@ -1,12 +1,25 @@
 #pragma once
 #include <cmath>
 #include <algorithm>
+#include <span>
+#include <vector>
+#include <optional>
+#include "ImpliedVolatility.h"
 
 class IVolatilitySurface {
 public:
     virtual ~IVolatilitySurface() = default;
 
     [[nodiscard]] virtual double getVol(double strike, double timeToExpiry, double spot) const = 0;
+
+    // Batch lookups: one virtual dispatch per batch instead of one per option. The defaults
+    // loop over getVol; surfaces override them with a non-virtual inner loop.
+    // getVols prices a list of options at one spot, getPathVols one option on many spots.
+    virtual void getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const;
+    virtual void getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const;
+
+    // False when getVol ignores the spot, so one lookup per option serves every path
+    [[nodiscard]] virtual bool dependsOnSpot() const { return true; }
 };
 
 // For unit tests and basic Black-Scholes assumptions
@@ -19,6 +32,9 @@ public:
     [[nodiscard]] double getVol(double /*strike*/, double /*timeToExpiry*/, double /*spot*/) const override {
         return sigma_;
     }
+    void getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const override;
+    void getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const override;
+    [[nodiscard]] bool dependsOnSpot() const override { return false; }
 };
 
 class ParametricVolatility : public IVolatilitySurface {
@@ -26,7 +42,60 @@ class ParametricVolatility : public IVolatilitySurface {
     double slope_;
     double convexity_;
 
+    [[nodiscard]] double smileAt(double strike, double timeToExpiry, double spot) const;
+
 public:
     ParametricVolatility(double atmVol, double slope, double convexity);
     [[nodiscard]] double getVol(double strike, double timeToExpiry, double spot) const override;
-};
\ No newline at end of file
+    void getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const override;
+    void getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const override;
+};
+
+enum class GridInterpolation {
+    Linear,         // bilinear in (log-moneyness, total variance)
+    MonotoneCubic   // Fritsch-Carlson Hermite along log-moneyness: smooth, no overshoot between nodes
+};
+
+// Market surface on a log-moneyness x expiry grid, stored row-major by expiry. Along each
+// expiry row vols are interpolated in ln(K/S); between rows total variance vol^2 * T is
+// interpolated linearly in T. Outside the grid the nearest edge vol is used.
+// With a referenceSpot the grid is sticky-strike: moneyness is measured against that spot
+// and the simulated spot is ignored.
+class GridVolatility : public IVolatilitySurface {
+    std::vector<double> logMoneyness_;
+    std::vector<double> expiries_;
+    std::vector<double> vols_;
+    std::vector<double> slopes_;     // d vol / d logMoneyness at each node, MonotoneCubic only
+    double inverseStep_ = 0.0;       // 1 / node spacing when the nodes are evenly spaced, else 0
+    GridInterpolation interpolation_;
+    std::optional<double> referenceSpot_;
+
+    // the two expiry rows around a maturity and their total-variance weights
+    struct ExpiryBracket {
+        std::size_t lower;
+        std::size_t upper;
+        double lowerWeight;
+        double upperWeight;
+    };
+
+    [[nodiscard]] ExpiryBracket bracket(double timeToExpiry) const;
+    [[nodiscard]] double rowVol(std::size_t row, double m) const;
+    [[nodiscard]] double volAt(double m, const ExpiryBracket& b) const;
+
+public:
+    GridVolatility(std::vector<double> logMoneyness, std::vector<double> expiries, std::vector<double> vols,
+                   GridInterpolation interpolation = GridInterpolation::MonotoneCubic,
+                   std::optional<double> referenceSpot = std::nullopt);
+
+    // Solves the quotes for implied vols and resamples each quoted expiry onto the given
+    // log-moneyness nodes (linear between quotes, flat beyond them). Quotes that do not
+    // converge are dropped; expiries left without a quote are skipped.
+    static GridVolatility fromQuotes(const QuoteInputs& quotes, std::vector<double> logMoneyness,
+                                     GridInterpolation interpolation = GridInterpolation::MonotoneCubic,
+                                     std::optional<double> referenceSpot = std::nullopt);
+
+    [[nodiscard]] double getVol(double strike, double timeToExpiry, double spot) const override;
+    void getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const override;
+    void getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const override;
+    [[nodiscard]] bool dependsOnSpot() const override { return !referenceSpot_; }
+};
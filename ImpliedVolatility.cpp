@@ -0,0 +1,278 @@
+#include "Headers/ImpliedVolatility.h"
+#include "Headers/Simd.h"
+#include "Headers/ThreadPool.h"
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <stdexcept>
+
+// Everything is solved in normalized Black form: x = ln(F/K), s = sigma * sqrt(T) and the
+// undiscounted price divided by sqrt(F K). The time value b(x, s) is symmetric in x, so every
+// quote is reduced to an out-of-the-money call with x <= 0.
+namespace {
+
+constexpr double MAX_LOG_MONEYNESS = 4.0;   // |x| covered by the guess table
+constexpr double MAX_TOTAL_VOL = 8.0;       // largest s in the guess table
+constexpr double MIN_LOG_PRICE = -600.0;    // smallest ln b in the guess table
+constexpr std::size_t ROWS = 65;
+constexpr std::size_t COLS = 256;
+constexpr int MAX_HALLEY_STEPS = 8;
+constexpr double TOLERANCE = 1e-10;         // relative size of the last step in s
+// Halley converges cubically: once a step is this small, the point it lands on is already
+// well inside TOLERANCE and needs no confirming evaluation
+constexpr double SETTLE_STEP = 1e-5;
+constexpr std::size_t CHUNK = 2048;
+
+double normalCDF(double x) {
+    return 0.5 * std::erfc(-x / std::sqrt(2.0));
+}
+
+double normalizedPrice(double x, double s) {
+    return std::exp(0.5 * x) * normalCDF(x / s + 0.5 * s) - std::exp(-0.5 * x) * normalCDF(x / s - 0.5 * s);
+}
+
+// Column coordinate of the guess table, ln(-ln(b e^(-x/2))). Spreads the flat top of the
+// price curve (large s) and compresses the deep out-of-the-money tail.
+double guessAxis(double x, double b) {
+    return std::log(0.5 * x - std::log(b));
+}
+
+// ln s tabulated on a (x, guessAxis) grid, each row with its own column range
+class GuessTable {
+    std::array<double, ROWS> rowStart{};
+    std::array<double, ROWS> rowStep{};
+    std::vector<double> logTotalVol;
+
+    [[nodiscard]] double row(std::size_t i, double w) const {
+        double u = (w - rowStart[i]) / rowStep[i];
+        u = std::clamp(u, 0.0, static_cast<double>(COLS - 1) - 1e-9);
+        const auto j = static_cast<std::size_t>(u);
+        const double frac = u - static_cast<double>(j);
+        const double* values = &logTotalVol[i * COLS + j];
+        return values[0] + (values[1] - values[0]) * frac;
+    }
+
+public:
+    GuessTable() : logTotalVol(ROWS * COLS) {
+        for (std::size_t i = 0; i < ROWS; ++i) {
+            const double x = -MAX_LOG_MONEYNESS * static_cast<double>(i) / (ROWS - 1);
+            const double first = guessAxis(x, normalizedPrice(x, MAX_TOTAL_VOL));
+            const double last = std::log(0.5 * x - MIN_LOG_PRICE);
+            rowStart[i] = first;
+            rowStep[i] = (last - first) / (COLS - 1);
+
+            for (std::size_t j = 0; j < COLS; ++j) {
+                const double w = first + rowStep[i] * static_cast<double>(j);
+                // the axis falls as s grows; bisect on ln s
+                double lo = std::log(1e-6);
+                double hi = std::log(MAX_TOTAL_VOL);
+                for (int k = 0; k < 32; ++k) {
+                    const double mid = 0.5 * (lo + hi);
+                    const double b = normalizedPrice(x, std::exp(mid));
+                    if (!(b > 0.0) || guessAxis(x, b) > w) lo = mid;
+                    else hi = mid;
+                }
+                logTotalVol[i * COLS + j] = 0.5 * (lo + hi);
+            }
+        }
+    }
+
+    // ln s for a given x and guessAxis value
+    [[nodiscard]] double lookup(double x, double w) const {
+        double u = -x / MAX_LOG_MONEYNESS * (ROWS - 1);
+        u = std::clamp(u, 0.0, static_cast<double>(ROWS - 1) - 1e-9);
+        const auto i = static_cast<std::size_t>(u);
+        const double frac = u - static_cast<double>(i);
+        const double first = row(i, w);
+        return first + (row(i + 1, w) - first) * frac;
+    }
+};
+
+const GuessTable& guessTable() {
+    static const GuessTable table;
+    return table;
+}
+
+// Safeguarded fallback for quotes the Halley loop left unsettled
+bool bisect(double x, double beta, double& s) {
+    double lo = std::log(1e-8);
+    double hi = std::log(4.0 * MAX_TOTAL_VOL);
+    for (int k = 0; k < 200 && hi - lo > TOLERANCE; ++k) {
+        const double mid = 0.5 * (lo + hi);
+        if (normalizedPrice(x, std::exp(mid)) < beta) lo = mid;
+        else hi = mid;
+    }
+    s = std::exp(0.5 * (lo + hi));
+    return hi - lo <= TOLERANCE;
+}
+
+template <class V>
+void solveLanes(const QuoteInputs& q, std::span<double> vols, std::span<IVStatus> status, std::size_t i, const GuessTable& table) {
+    constexpr std::size_t W = V::width;
+    constexpr unsigned ALL = (1u << W) - 1u;
+    const V zero = V::broadcast(0.0);
+    const V one = V::broadcast(1.0);
+    const V half = V::broadcast(0.5);
+
+    double callLanes[W];
+    for (std::size_t j = 0; j < W; ++j)
+        callLanes[j] = (q.types[i + j] == OptionType::Call) ? 1.0 : 0.0;
+    const auto isCall = V::load(callLanes) > zero;
+
+    V K = V::load(&q.strikes[i]);
+    V T = V::load(&q.expiries[i]);
+    V S = V::load(&q.spots[i]);
+    const V r = V::load(&q.rates[i]);
+    V price = V::load(&q.prices[i]);
+
+    const auto ok = (K > zero) & (T > zero) & (S > zero) & (price > zero);
+    K = select(ok, K, one);
+    T = select(ok, T, one);
+    S = select(ok, S, one);
+    price = select(ok, price, one);
+
+    // normalize: x = ln(F/K), beta = time value * e^(rT) / sqrt(F K)
+    const V rT = r * T;
+    const V x = simd::log(S / K) + rT;
+    const V halfGrowth = simd::exp(half * rT);
+    const V betaFull = price * halfGrowth / sqrt(S * K);
+    const V ex = simd::exp(half * x);
+    const V exInv = one / ex;
+    const V intrinsic = max(select(isCall, ex - exInv, exInv - ex), zero);
+    V beta = betaFull - intrinsic;
+
+    const V xt = -abs(x);
+    const V eHalf = min(ex, exInv);
+    const V eMinusHalf = max(ex, exInv);
+    const V eFull = eHalf * eHalf;
+
+    const auto below = ok & (beta <= zero);
+    const auto above = ok & !below & (beta >= eHalf);
+    const auto solvable = ok & !below & !above;
+    beta = select(solvable, beta, eHalf * half);
+    const V lnBeta = simd::log(beta);
+
+    // starting point from the guess table
+    double xLanes[W], axisLanes[W], startLanes[W];
+    xt.store(xLanes);
+    simd::log(half * xt - lnBeta).store(axisLanes);
+    for (std::size_t j = 0; j < W; ++j)
+        startLanes[j] = table.lookup(xLanes[j], axisLanes[j]);
+    V s = simd::exp(V::load(startLanes));
+
+    auto normalized = [&](V sv, V& b, V& bp, V& bpp) {
+        const V invS = one / sv;
+        const V xs = xt * invS;
+        const V d1 = xs + half * sv;
+        const V d2 = d1 - sv;
+        const V pdf1 = simd::normalPDF(d1);
+        V cdf1{}, cdfNeg1{}, cdf2{}, cdfNeg2{};
+        simd::normalCDFPair(d1, pdf1, cdf1, cdfNeg1);
+        simd::normalCDFPair(d2, pdf1 * eFull, cdf2, cdfNeg2);
+        b = eHalf * cdf1 - eMinusHalf * cdf2;
+        bp = eHalf * pdf1;
+        bpp = bp * (xs * xs * invS - V::broadcast(0.25) * sv);
+    };
+
+    // below the inflection point s_c = sqrt(2|x|) Halley runs on ln b, which is close to linear there
+    V bc{}, unused1{}, unused2{};
+    normalized(max(sqrt(V::broadcast(-2.0) * xt), V::broadcast(1e-6)), bc, unused1, unused2);
+    const auto lower = beta < bc;
+
+    auto done = !solvable;
+    for (int step = 0; step < MAX_HALLEY_STEPS && done.bits() != ALL; ++step) {
+        V b{}, bp{}, bpp{};
+        normalized(s, b, bp, bpp);
+
+        const V f = b - beta;
+        const V upperStep = V::broadcast(2.0) * f * bp / (V::broadcast(2.0) * bp * bp - f * bpp);
+        const V g = simd::log(max(b, V::broadcast(1e-300))) - lnBeta;
+        const V gp = bp / b;
+        const V gpp = bpp / b - gp * gp;
+        const V lowerStep = V::broadcast(2.0) * g * gp / (V::broadcast(2.0) * gp * gp - g * gpp);
+
+        V next = s - select(lower & (b > zero), lowerStep, upperStep);
+        // overshoot below zero or a NaN step: move geometrically toward the root instead
+        next = select(next > zero, next, select(f > zero, s * half, s * V::broadcast(2.0)));
+        next = min(next, V::broadcast(4.0 * MAX_TOTAL_VOL));
+
+        const auto settled = abs(next - s) <= V::broadcast(SETTLE_STEP) * s;
+        s = select(done, s, next);
+        done = done | settled;
+    }
+
+    double sLanes[W], betaLanes[W];
+    s.store(sLanes);
+    beta.store(betaLanes);
+    const V sqrtT = sqrt(T);
+    double sqrtTLanes[W];
+    sqrtT.store(sqrtTLanes);
+
+    const unsigned okBits = ok.bits();
+    const unsigned belowBits = below.bits();
+    const unsigned aboveBits = above.bits();
+    const unsigned settledBits = (done & solvable).bits();
+    for (std::size_t j = 0; j < W; ++j) {
+        const unsigned bit = 1u << j;
+        IVStatus laneStatus = IVStatus::Converged;
+        double sigma = 0.0;
+        if (!(okBits & bit)) {
+            laneStatus = IVStatus::InvalidInput;
+        } else if (belowBits & bit) {
+            laneStatus = IVStatus::BelowIntrinsic;
+        } else if (aboveBits & bit) {
+            laneStatus = IVStatus::AboveMaximum;
+        } else {
+            double total = sLanes[j];
+            if (!(settledBits & bit) && !bisect(xLanes[j], betaLanes[j], total))
+                laneStatus = IVStatus::NotConverged;
+            sigma = total / sqrtTLanes[j];
+        }
+        vols[i + j] = sigma;
+        status[i + j] = laneStatus;
+    }
+}
+
+void solveRange(const QuoteInputs& quotes, std::span<double> vols, std::span<IVStatus> status, std::size_t begin, std::size_t end) {
+    const GuessTable& table = guessTable();
+    std::size_t i = begin;
+    for (; i + simd::NativeD::width <= end; i += simd::NativeD::width)
+        solveLanes<simd::NativeD>(quotes, vols, status, i, table);
+    for (; i < end; ++i)
+        solveLanes<simd::ScalarD>(quotes, vols, status, i, table);
+}
+
+std::size_t checkedSize(const QuoteInputs& quotes, std::span<const double> vols, std::span<const IVStatus> status) {
+    const std::size_t n = quotes.strikes.size();
+    if (quotes.expiries.size() != n || quotes.types.size() != n || quotes.spots.size() != n
+        || quotes.rates.size() != n || quotes.prices.size() != n || vols.size() != n || status.size() != n) {
+        throw std::invalid_argument("ERROR: solveBatch sizes differ");
+    }
+    return n;
+}
+
+}
+
+std::size_t ImpliedVolatility::solveBatch(const QuoteInputs& quotes, std::span<double> vols, std::span<IVStatus> status, ThreadPool* pool) {
+    const std::size_t n = checkedSize(quotes, vols, status);
+    guessTable(); // build once before fanning out
+
+    const std::size_t chunks = (n + CHUNK - 1) / CHUNK;
+    if (chunks <= 1) {
+        solveRange(quotes, vols, status, 0, n);
+    } else {
+        ThreadPool& workers = pool ? *pool : ThreadPool::shared();
+        workers.parallelFor(chunks, [&](std::size_t c) {
+            solveRange(quotes, vols, status, c * CHUNK, std::min(n, (c + 1) * CHUNK));
+        });
+    }
+
+    return static_cast<std::size_t>(std::count(status.begin(), status.end(), IVStatus::Converged));
+}
+
+std::size_t ImpliedVolatility::solveBatchInline(const QuoteInputs& quotes, std::span<double> vols, std::span<IVStatus> status) {
+    const std::size_t n = checkedSize(quotes, vols, status);
+    solveRange(quotes, vols, status, 0, n);
+    return static_cast<std::size_t>(std::count(status.begin(), status.end(), IVStatus::Converged));
+}
@@ -4,12 +4,474 @@
 #include "Headers/Strategy.h"
 #include "Headers/Global.h"
 #include "Headers/VolatilitySurface.h"
+#include "Headers/CubicSpline.h"
+#include "Headers/Random.h"
+#include "Headers/ThreadPool.h"
+#include "Headers/Simd.h"
+#include "Headers/PathEngine.h"
+#include "Headers/Instrumentation.h"
 #include <optional>
 #include <stdexcept>
 #include <random>
 #include <cmath>
-#include <future>
-#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <array>
+#include <limits>
+#include <atomic>
+
+namespace {
+
+// Spline domain in standard deviations of the horizon draw; paths beyond it are priced exactly
+constexpr double SPLINE_RANGE = 6.0;
+constexpr std::size_t SPLINE_MIN_INTERVALS = 64;
+constexpr std::size_t SPLINE_MAX_INTERVALS = 4096;
+
+// Antithetic pairs per work unit of the path loop; a block's path rows stay in L2
+constexpr std::uint64_t PAIRS_PER_BLOCK = 2048;
+
+// One-sided bumps for the smile's slope in spot (relative) and remaining time (years)
+constexpr double VOL_SPOT_BUMP = 1e-4;
+constexpr double VOL_TIME_BUMP = 1e-4;
+// Threshold moves behind the PoP sensitivities: the entry cost over 1% of spot, time decay over one day
+constexpr double POP_SPOT_BUMP = 0.01;
+
+// Instrumentation counters for one thread of the path loop, one cache line each. Threads
+// outside the pool share the last slot, hence the atomics.
+struct alignas(64) ThreadCounters {
+    std::atomic<std::uint64_t> blocks{0};
+    std::atomic<std::uint64_t> paths{0};
+    std::atomic<std::uint64_t> drawNs{0};
+    std::atomic<std::uint64_t> valuationNs{0};
+};
+
+// Sums over antithetic pairs for one strategy. The two paths of a pair are correlated, so the
+// pair average is the sample the standard errors come from. Values are centred on the entry
+// cost and the two controls (terminal spot, horizon payoff of the legs) on their known means,
+// which keeps plain sums well conditioned and lets blocks merge by addition.
+// One cache line pair each so blocks finishing on different cores do not share a line.
+struct alignas(64) PathStats {
+    std::uint64_t pairs = 0;
+    std::uint64_t profitablePaths = 0;
+    double hitSumSquares = 0.0;   // pair hit rates are 0, 0.5 or 1
+    double y = 0.0, yy = 0.0;
+    double x1 = 0.0, x2 = 0.0;
+    double x1x1 = 0.0, x2x2 = 0.0, x1x2 = 0.0, x1y = 0.0, x2y = 0.0;
+    // pair averages of the derivative samples: EV then PoP, each by spot, sigma, mu, days
+    std::array<double, 8> sensitivities{}, sensitivitySquares{};
+
+    void add(double value, int hits, double spot, double payoff) {
+        pairs++;
+        profitablePaths += hits;
+        hitSumSquares += 0.25 * hits * hits;
+        y += value;
+        yy += value * value;
+        x1 += spot;
+        x2 += payoff;
+        x1x1 += spot * spot;
+        x2x2 += payoff * payoff;
+        x1x2 += spot * payoff;
+        x1y += spot * value;
+        x2y += payoff * value;
+    }
+
+    void addSensitivities(const std::array<double, 8>& sample) {
+        for (std::size_t k = 0; k < sample.size(); ++k) {
+            sensitivities[k] += sample[k];
+            sensitivitySquares[k] += sample[k] * sample[k];
+        }
+    }
+
+    void merge(const PathStats& o) {
+        pairs += o.pairs;
+        profitablePaths += o.profitablePaths;
+        hitSumSquares += o.hitSumSquares;
+        y += o.y;
+        yy += o.yy;
+        x1 += o.x1;
+        x2 += o.x2;
+        x1x1 += o.x1x1;
+        x2x2 += o.x2x2;
+        x1x2 += o.x1x2;
+        x1y += o.x1y;
+        x2y += o.x2y;
+        for (std::size_t k = 0; k < sensitivities.size(); ++k) {
+            sensitivities[k] += o.sensitivities[k];
+            sensitivitySquares[k] += o.sensitivitySquares[k];
+        }
+    }
+
+    [[nodiscard]] double pop() const {
+        return static_cast<double>(profitablePaths) / static_cast<double>(2 * pairs);
+    }
+
+    [[nodiscard]] double popStdError() const {
+        if (pairs < 2) return 0.0;
+        const double n = static_cast<double>(pairs);
+        const double hits = 0.5 * static_cast<double>(profitablePaths);
+        return std::sqrt(std::max(0.0, hitSumSquares - hits * hits / n) / (n - 1.0) / n);
+    }
+
+    [[nodiscard]] MetricSensitivities sensitivityEstimate() const {
+        std::array<double, 8> mean{}, error{};
+        const double n = static_cast<double>(pairs);
+        for (std::size_t k = 0; k < mean.size() && pairs > 0; ++k) {
+            mean[k] = sensitivities[k] / n;
+            if (pairs > 1) error[k] = std::sqrt(std::max(0.0, sensitivitySquares[k] - n * mean[k] * mean[k]) / (n - 1.0) / n);
+        }
+        return {{mean[0], mean[1], mean[2], mean[3]}, {mean[4], mean[5], mean[6], mean[7]},
+                {error[0], error[1], error[2], error[3]}, {error[4], error[5], error[6], error[7]}};
+    }
+
+    // Mean of the centred value and its standard error. With controls, the value is regressed
+    // on whichever controls carry information; their known means are zero after centring.
+    [[nodiscard]] std::pair<double, double> estimate(bool controlled) const {
+        if (pairs < 2) return {pairs ? y : 0.0, 0.0};
+        const double n = static_cast<double>(pairs);
+        const double my = y / n, m1 = x1 / n, m2 = x2 / n;
+        const double syy = yy - n * my * my;
+        const double s11 = x1x1 - n * m1 * m1, s22 = x2x2 - n * m2 * m2, s12 = x1x2 - n * m1 * m2;
+        const double s1y = x1y - n * m1 * my, s2y = x2y - n * m2 * my;
+
+        double b1 = 0.0, b2 = 0.0;
+        int used = 0;
+        const double det = s11 * s22 - s12 * s12;
+        if (controlled && det > 1e-9 * s11 * s22) {
+            b1 = (s22 * s1y - s12 * s2y) / det;
+            b2 = (s11 * s2y - s12 * s1y) / det;
+            used = 2;
+        } else if (controlled && s22 > 1e-12 * (1.0 + s11)) {
+            // collinear controls, e.g. a payoff linear in the spot over every path
+            b2 = s2y / s22;
+            used = 1;
+        } else if (controlled && s11 > 0.0) {
+            b1 = s1y / s11;
+            used = 1;
+        }
+
+        const double mean = my - b1 * m1 - b2 * m2;
+        const double residual = std::max(0.0, syy - b1 * s1y - b2 * s2y) / std::max(1.0, n - 1.0 - used);
+        return {mean, std::sqrt(residual / n)};
+    }
+};
+
+// Spot at the horizon for draw Z and its antithetic -Z
+template <class V>
+void terminalSpots(const double* draws, double* up, double* down, std::size_t i, double current, double drift, double vol) {
+    const V Z = V::load(draws + i);
+    const V S0 = V::broadcast(current);
+    const V mean = V::broadcast(drift);
+    const V scale = V::broadcast(vol);
+    (S0 * simd::exp(mulAdd(scale, Z, mean))).store(up + i);
+    (S0 * simd::exp(mean - scale * Z)).store(down + i);
+}
+
+// Per-strategy state shared by every block of the path loop
+struct StrategyRun {
+    double totalCost = 0.0;
+    Greeks greeks = {};
+    bool aliveAtHorizon = true;   // no leg has expired by the horizon
+    bool settlesEarly = false;    // some leg expires strictly before the horizon
+    bool needsPath = false;       // valued along a path rather than from the horizon spot alone
+    bool sensitive = false;       // sensitivities accumulated alongside the value
+    double entrySlope = 0.0;      // entry cost's derivative in today's spot, smile included
+    double payoffMean = 0.0;      // known mean of the legs' payoff at the horizon
+    std::optional<CubicSpline> spline;
+};
+
+// Expected value and probability of profit of one strategy at the horizon
+struct HorizonEstimate {
+    double expectedValue = 0.0;
+    double expectedValueStdError = 0.0;
+    double pop = 0.0;
+    double popStdError = 0.0;
+    std::uint64_t paths = 0;
+    std::optional<MetricSensitivities> sensitivities;
+};
+
+// Horizon spot S = current * exp(drift + vol * Z) with Z standard normal
+struct HorizonDistribution {
+    double current;
+    double drift;
+    double vol;
+
+    [[nodiscard]] double draw(double spot) const {
+        if (spot <= 0.0) return -std::numeric_limits<double>::infinity();
+        if (std::isinf(spot)) return std::numeric_limits<double>::infinity();
+        return (std::log(spot / current) - drift) / vol;
+    }
+    [[nodiscard]] static double cdf(double z) {
+        return 0.5 * std::erfc(-z / std::sqrt(2.0));
+    }
+    // P(a < S < b) and E[S; a < S < b]
+    [[nodiscard]] double probability(double a, double b) const {
+        return cdf(draw(b)) - cdf(draw(a));
+    }
+    [[nodiscard]] double partialMean(double a, double b) const {
+        const double mean = current * std::exp(drift + 0.5 * vol * vol);
+        return mean * (cdf(draw(b) - vol) - cdf(draw(a) - vol));
+    }
+};
+
+// Legs at expiry form a piecewise-linear payoff in the horizon spot. On each piece between
+// strikes the profit is linear, so the breakeven is a single root and PoP and EV are sums of
+// lognormal probabilities and partial means.
+HorizonEstimate expiryEstimate(std::span<const StrategyLeg> legs, double cost, const HorizonDistribution& dist) {
+    thread_local std::vector<double> knots;
+    knots.assign(1, 0.0);
+    for (const StrategyLeg& leg : legs) knots.push_back(leg.option.getStrike());
+    std::sort(knots.begin(), knots.end());
+    knots.erase(std::unique(knots.begin(), knots.end()), knots.end());
+    knots.push_back(std::numeric_limits<double>::infinity());
+
+    HorizonEstimate estimate;
+    for (std::size_t k = 0; k + 1 < knots.size(); ++k) {
+        const double a = knots[k], b = knots[k + 1];
+        // payoff = intercept + slope * S on (a, b)
+        double intercept = 0.0, slope = 0.0;
+        for (const StrategyLeg& leg : legs) {
+            const double K = leg.option.getStrike();
+            if (leg.option.getType() == OptionType::Call && K <= a) {
+                slope += leg.quantity;
+                intercept -= leg.quantity * K;
+            }
+            if (leg.option.getType() == OptionType::Put && K >= b) {
+                slope -= leg.quantity;
+                intercept += leg.quantity * K;
+            }
+        }
+        estimate.expectedValue += intercept * dist.probability(a, b) + slope * dist.partialMean(a, b);
+
+        // profitable part of the piece
+        double lo = a, hi = b;
+        if (slope == 0.0) {
+            if (intercept - cost <= 0.0) continue;
+        } else {
+            const double breakeven = (cost - intercept) / slope;
+            if (slope > 0.0) lo = std::max(a, breakeven);
+            else hi = std::min(b, breakeven);
+            if (lo >= hi) continue;
+        }
+        estimate.pop += dist.probability(lo, hi);
+    }
+    return estimate;
+}
+
+// Gauss-Hermite nodes and weights for the weight exp(-x^2), by Newton iteration on the
+// orthonormal Hermite recurrence
+struct GaussHermite {
+    static constexpr int N = 64;
+    std::array<double, N> nodes{};
+    std::array<double, N> weights{};
+
+    GaussHermite() {
+        constexpr double PI_TO_MINUS_QUARTER = 0.7511255444649425;
+        double z = 0.0;
+        for (int i = 0; i < (N + 1) / 2; ++i) {
+            if (i == 0) z = std::sqrt(2.0 * N + 1) - 1.85575 * std::pow(2.0 * N + 1, -0.16667);
+            else if (i == 1) z -= 1.14 * std::pow(static_cast<double>(N), 0.426) / z;
+            else if (i == 2) z = 1.86 * z - 0.86 * nodes[0];
+            else if (i == 3) z = 1.91 * z - 0.91 * nodes[1];
+            else z = 2.0 * z - nodes[i - 2];
+
+            double derivative = 0.0;
+            for (int iteration = 0; iteration < 100; ++iteration) {
+                double p1 = PI_TO_MINUS_QUARTER, p2 = 0.0;
+                for (int j = 0; j < N; ++j) {
+                    const double p3 = p2;
+                    p2 = p1;
+                    p1 = z * std::sqrt(2.0 / (j + 1)) * p2 - std::sqrt(static_cast<double>(j) / (j + 1)) * p3;
+                }
+                derivative = std::sqrt(2.0 * N) * p2;
+                const double previous = z;
+                z = previous - p1 / derivative;
+                if (std::abs(z - previous) <= 1e-15 * std::abs(z)) break;
+            }
+            nodes[i] = z;
+            nodes[N - 1 - i] = -z;
+            weights[i] = weights[N - 1 - i] = 2.0 / (derivative * derivative);
+        }
+    }
+};
+
+// Legs still alive at the horizon: EV by Gauss-Hermite quadrature over the normal draw, PoP
+// from the breakevens in the draw, located on a grid and refined by bisection
+template <class Fn>
+double quadratureMean(Fn&& valueAtDraw) {
+    static const GaussHermite rule;
+    constexpr double INV_SQRT_PI = 0.5641895835477563;
+
+    double mean = 0.0;
+    for (int i = 0; i < GaussHermite::N; ++i)
+        mean += rule.weights[i] * INV_SQRT_PI * valueAtDraw(std::sqrt(2.0) * rule.nodes[i]);
+    return mean;
+}
+
+template <class Fn>
+HorizonEstimate quadratureEstimate(Fn&& valueAtDraw, double cost) {
+    HorizonEstimate estimate;
+    estimate.expectedValue = quadratureMean(valueAtDraw);
+
+    constexpr double RANGE = 9.0;
+    constexpr int STEPS = 240;
+    auto profit = [&](double z) { return valueAtDraw(z) - cost; };
+    double z0 = -RANGE;
+    double p0 = profit(z0);
+    double openedAt = p0 > 0.0 ? -std::numeric_limits<double>::infinity() : 0.0;
+    bool open = p0 > 0.0;
+    for (int k = 1; k <= STEPS; ++k) {
+        const double z1 = -RANGE + 2.0 * RANGE * k / STEPS;
+        const double p1 = profit(z1);
+        if ((p0 > 0.0) != (p1 > 0.0)) {
+            double lo = z0, hi = z1;
+            for (int iteration = 0; iteration < 52; ++iteration) {
+                const double mid = 0.5 * (lo + hi);
+                if ((profit(mid) > 0.0) == (p0 > 0.0)) lo = mid;
+                else hi = mid;
+            }
+            const double root = 0.5 * (lo + hi);
+            if (open) estimate.pop += HorizonDistribution::cdf(root) - HorizonDistribution::cdf(openedAt);
+            else openedAt = root;
+            open = !open;
+        }
+        z0 = z1;
+        p0 = p1;
+    }
+    if (open) estimate.pop += 1.0 - HorizonDistribution::cdf(openedAt);
+    return estimate;
+}
+
+// Names for error messages and results. Strategies owning their names report them through
+// result, so their compact results carry the empty name rather than growing the table.
+std::string displayName(const Strategy& strategy) { return strategy.getName(); }
+std::string displayName(const CompactStrategy& strategy) { return std::string(strategy.getName().view()); }
+StrategyName nameOf(const Strategy&) { return {}; }
+StrategyName nameOf(const CompactStrategy& strategy) { return strategy.getName(); }
+
+double intrinsicValue(const Option& option, double spot) {
+    if (option.getType() == OptionType::Call) return std::max(0.0, spot - option.getStrike());
+    return std::max(0.0, option.getStrike() - spot);
+}
+
+double intrinsicValue(std::span<const StrategyLeg> legs, double spot) {
+    double value = 0.0;
+    for (const StrategyLeg& leg : legs) value += intrinsicValue(leg.option, spot) * leg.quantity;
+    return value;
+}
+
+// Value of the legs on every path `elapsed` years from now: live legs through the batch
+// pricer, expired legs from the values they settled at on their expiry date (intrinsic on
+// these spots when no settled values are given). Vols come from one batch lookup per leg,
+// or a single lookup when the surface ignores the spot.
+// With spotSlopes and timeSlopes given, also the value's derivatives in the path spot and in
+// `elapsed` (per year): leg deltas and thetas from the same batch call, plus vega times the
+// smile's slope from one bumped lookup each. Expired legs slope as their payoff and do not decay.
+void valueOnPaths(std::span<const StrategyLeg> legs, double elapsed, std::span<const double> spots,
+                  std::span<const std::vector<double>> settled, double r, const IVolatilitySurface& volSurface,
+                  Precision precision, std::span<double> values, std::span<double> spotSlopes = {}, std::span<double> timeSlopes = {}) {
+    thread_local std::vector<double> strikes, expiries, rates, vols, premium;
+    thread_local std::vector<double> delta, theta, vega, bumpedSpots, bumpedVols;
+    thread_local std::vector<OptionType> types;
+    thread_local std::vector<std::uint8_t> valid;
+    const std::size_t n = spots.size();
+    const bool slopes = !spotSlopes.empty();
+
+    std::fill(values.begin(), values.end(), 0.0);
+    if (slopes) {
+        std::fill(spotSlopes.begin(), spotSlopes.end(), 0.0);
+        std::fill(timeSlopes.begin(), timeSlopes.end(), 0.0);
+    }
+    for (std::size_t l = 0; l < legs.size(); ++l) {
+        const Option& option = legs[l].option;
+        const double quantity = legs[l].quantity;
+        const double remaining = option.getTimeToExpiry() - elapsed;
+
+        if (remaining <= PathBlock::SAME_DATE) {
+            if (settled.empty()) {
+                for (std::size_t p = 0; p < n; ++p) values[p] += intrinsicValue(option, spots[p]) * quantity;
+            } else {
+                for (std::size_t p = 0; p < n; ++p) values[p] += settled[l][p] * quantity;
+            }
+            if (!slopes) continue;
+            const double K = option.getStrike();
+            for (std::size_t p = 0; p < n; ++p) {
+                if (option.getType() == OptionType::Call) spotSlopes[p] += spots[p] > K ? quantity : 0.0;
+                else spotSlopes[p] -= spots[p] < K ? quantity : 0.0;
+            }
+            continue;
+        }
+
+        strikes.assign(n, option.getStrike());
+        expiries.assign(n, remaining);
+        types.assign(n, option.getType());
+        rates.assign(n, r);
+        vols.resize(n);
+        premium.resize(n);
+        valid.resize(n);
+        if (volSurface.dependsOnSpot()) volSurface.getPathVols(option.getStrike(), remaining, spots, vols);
+        else std::fill(vols.begin(), vols.end(), volSurface.getVol(option.getStrike(), remaining, spots[0]));
+
+        if (!slopes) {
+            BlackScholes::calculateBatch({strikes, expiries, types, spots, rates, vols}, {.premium = premium}, valid, precision);
+            for (std::size_t p = 0; p < n; ++p) values[p] += premium[p] * quantity;
+            continue;
+        }
+
+        delta.resize(n);
+        theta.resize(n);
+        vega.resize(n);
+        BlackScholes::calculateBatch({strikes, expiries, types, spots, rates, vols},
+                                     {.premium = premium, .delta = delta, .theta = theta, .vega = vega}, valid, precision);
+        bumpedVols.resize(n);
+        if (volSurface.dependsOnSpot()) {
+            bumpedSpots.resize(n);
+            for (std::size_t p = 0; p < n; ++p) bumpedSpots[p] = spots[p] * (1.0 + VOL_SPOT_BUMP);
+            volSurface.getPathVols(option.getStrike(), remaining, bumpedSpots, bumpedVols);
+            for (std::size_t p = 0; p < n; ++p) delta[p] += vega[p] * (bumpedVols[p] - vols[p]) / (spots[p] * VOL_SPOT_BUMP);
+            volSurface.getPathVols(option.getStrike(), remaining + VOL_TIME_BUMP, spots, bumpedVols);
+        } else {
+            std::fill(bumpedVols.begin(), bumpedVols.end(), volSurface.getVol(option.getStrike(), remaining + VOL_TIME_BUMP, spots[0]));
+        }
+        // theta is daily with the vol held; elapsed time shortens the remaining time the vol is read at
+        for (std::size_t p = 0; p < n; ++p) {
+            values[p] += premium[p] * quantity;
+            spotSlopes[p] += delta[p] * quantity;
+            timeSlopes[p] += (theta[p] * gbl::TRADING_DAYS - vega[p] * (bumpedVols[p] - vols[p]) / VOL_TIME_BUMP) * quantity;
+        }
+    }
+}
+
+// Doubles the grid until every interval midpoint is within tolerance of the exact value.
+// The checked midpoints become the nodes of the next, finer grid.
+std::optional<CubicSpline> fitHorizonSpline(const std::function<double(double)>& valueAtDraw, double tolerance) {
+    std::size_t n = SPLINE_MIN_INTERVALS;
+    std::vector<double> nodes(n + 1);
+    for (std::size_t i = 0; i <= n; ++i)
+        nodes[i] = valueAtDraw(-SPLINE_RANGE + 2.0 * SPLINE_RANGE * static_cast<double>(i) / static_cast<double>(n));
+
+    while (true) {
+        CubicSpline spline(-SPLINE_RANGE, SPLINE_RANGE, nodes);
+        std::vector<double> refined(2 * n + 1);
+        double worst = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            double mid = -SPLINE_RANGE + 2.0 * SPLINE_RANGE * (static_cast<double>(i) + 0.5) / static_cast<double>(n);
+            double exact = valueAtDraw(mid);
+            worst = std::max(worst, std::abs(spline.evaluate(mid) - exact));
+            refined[2 * i] = nodes[i];
+            refined[2 * i + 1] = exact;
+        }
+        refined[2 * n] = nodes[n];
+
+        if (worst <= tolerance) return spline;
+        if (2 * n > SPLINE_MAX_INTERVALS) return std::nullopt;
+        nodes = std::move(refined);
+        n *= 2;
+    }
+}
+
+}
 
 double OptionWizard::getEstimatedPrice(const Option& i_option, double futureSpot, double futureTimeRemaining, double r, const IVolatilitySurface& volSurface, double currentSpot) {
     double K = i_option.getStrike();
@@ -21,126 +483,483 @@ double OptionWizard::getEstimatedPrice(const Option& i_option, double futureSpot
     return premium.value_or(0.0);
 }
 
-result OptionWizard::simulateStrategy(const Strategy& strategy, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma) {
-
-    double totalCost = 0.0;
-    Greeks strategyGreeks = {};
-    const std::vector<StrategyLeg>& legs = strategy.getLegs();
+double OptionWizard::getHorizonValue(std::span<const StrategyLeg> legs, double simulatedPrice, double elapsed, double r, const IVolatilitySurface& volSurface) {
+    double pathValue = 0.0;
 
     for(const StrategyLeg& leg : legs) {
-        double K = leg.option.getStrike();
-        double T = leg.option.getTimeToExpiry();
-        OptionType type = leg.option.getType();
-        std::optional<Greeks> g = BlackScholes::calculate(K, T, type, current, r, volSurface);
-        if(!g) throw std::runtime_error("Error pricing leg");
-        totalCost += g->premium * leg.quantity;
+        double legValue = 0.0;
+        double timeRemaining = leg.option.getTimeToExpiry() - elapsed;
 
-        strategyGreeks.delta += g->delta * leg.quantity;
-        strategyGreeks.gamma += g->gamma * leg.quantity;
-        strategyGreeks.theta += g->theta * leg.quantity;
-        strategyGreeks.vega  += g->vega  * leg.quantity;
+        if(timeRemaining <= PathBlock::SAME_DATE) {
+            legValue = intrinsicValue(leg.option, simulatedPrice);
+        } else {
+            legValue = getEstimatedPrice(leg.option, simulatedPrice, timeRemaining, r, volSurface, simulatedPrice);
+        }
+        pathValue += legValue * leg.quantity;
     }
+    return pathValue;
+}
 
-    double timeToTarget = daysToTarget / gbl::TRADING_DAYS;
-    if(legs.empty()) throw std::runtime_error("Strategy has no legs");
-    double timeRemaining = legs[0].option.getTimeToExpiry() - timeToTarget;
-    if(timeRemaining < 0) timeRemaining = 0;
+result OptionWizard::simulateStrategy(const Strategy& strategy, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options) {
+    return simulateStrategies(std::span<const Strategy>(&strategy, 1), current, target, daysToTarget, r, volSurface, mu, sigma, options).front();
+}
+
+std::vector<result> OptionWizard::simulateStrategies(std::span<const Strategy> strategies, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options) {
+    std::vector<CompactResult> compact(strategies.size());
+    simulate(strategies, current, target, daysToTarget, r, volSurface, mu, sigma, options, compact);
+
+    std::vector<result> results;
+    results.reserve(compact.size());
+    for (std::size_t s = 0; s < compact.size(); ++s) {
+        const CompactResult& c = compact[s];
+        results.push_back({strategies[s].getName(), c.entryCost, c.projectedValue, c.profitPercent, c.pop, c.netGreeks,
+                           c.expectedValue, c.expectedValueStdError, c.popStdError, c.pathsUsed, c.sensitivities});
+    }
+    return results;
+}
+
+void OptionWizard::simulateStrategies(std::span<const CompactStrategy> strategies, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options, std::span<CompactResult> out) {
+    if (out.size() < strategies.size()) throw std::invalid_argument("ERROR: Result buffer smaller than the strategy list");
+    simulate(strategies, current, target, daysToTarget, r, volSurface, mu, sigma, options, out);
+}
+
+template <class StrategyT>
+void OptionWizard::simulate(std::span<const StrategyT> strategies, double current, double target, double daysToTarget, double r, const IVolatilitySurface& volSurface, double mu, double sigma, const SimulationOptions& options, std::span<CompactResult> out) {
 
-    int simulations = 100000;
-    int threadCount = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
-    int simsPerThread = simulations / threadCount;
-    std::vector<std::future<std::pair<int, double>>> futures; // profitableCount, totalValueSum
+    instrument::Stopwatch wallClock, phaseClock;
+    std::uint64_t setupNs = 0, reductionNs = 0, rounds = 0;
+    std::vector<ThreadCounters> counters;
 
+    double timeToTarget = daysToTarget / gbl::TRADING_DAYS;
     double drift = (mu - 0.5 * sigma * sigma) * timeToTarget;
     double vol = sigma * std::sqrt(timeToTarget);
 
-    auto worker = [&](int iterations) -> std::pair<int, double> {
-        static thread_local std::mt19937 gen = [](){
-            std::random_device rd;
-            auto now = std::chrono::high_resolution_clock::now();
-            std::seed_seq ss{
-                    static_cast<unsigned long long>(rd()),
-                    static_cast<unsigned long long>(now.time_since_epoch().count()),
-                    static_cast<unsigned long long>(std::hash<std::thread::id>{}(std::this_thread::get_id()))
+    // Control variates: the terminal spot and the legs' payoff at the horizon, whose means
+    // under the simulated drift are closed-form (Black-Scholes with rate mu)
+    const bool controlled = options.controlVariates && timeToTarget > 0 && sigma > 0;
+    const double growthToTarget = std::exp(mu * timeToTarget);
+    const double spotMean = current * growthToTarget;
+
+    std::vector<StrategyRun> runs(strategies.size());
+    for (std::size_t s = 0; s < strategies.size(); ++s) {
+        StrategyRun& run = runs[s];
+        const std::span<const StrategyLeg> legs = strategies[s].getLegs();
+
+        for(const StrategyLeg& leg : legs) {
+            double K = leg.option.getStrike();
+            double T = leg.option.getTimeToExpiry();
+            OptionType type = leg.option.getType();
+            std::optional<Greeks> g = BlackScholes::calculate(K, T, type, current, r, volSurface);
+            if(!g) throw std::runtime_error("Error pricing leg of " + displayName(strategies[s]));
+            run.totalCost += g->premium * leg.quantity;
+
+            run.greeks.delta += g->delta * leg.quantity;
+            run.greeks.gamma += g->gamma * leg.quantity;
+            run.greeks.theta += g->theta * leg.quantity;
+            run.greeks.vega  += g->vega  * leg.quantity;
+            run.greeks.rho   += g->rho   * leg.quantity;
+
+            if (!options.sensitivities) continue;
+            const double skew = (volSurface.getVol(K, T, current * (1.0 + VOL_SPOT_BUMP)) - volSurface.getVol(K, T, current)) / (current * VOL_SPOT_BUMP);
+            run.entrySlope += (g->delta + g->vega * skew) * leg.quantity;
+        }
+
+        if(legs.empty()) throw std::runtime_error("Strategy has no legs: " + displayName(strategies[s]));
+        for (const StrategyLeg& leg : legs) {
+            const double remaining = leg.option.getTimeToExpiry() - timeToTarget;
+            if (remaining <= PathBlock::SAME_DATE) run.aliveAtHorizon = false;
+            if (remaining < -PathBlock::SAME_DATE) run.settlesEarly = true;
+        }
+
+        for (const StrategyLeg& leg : legs) {
+            if (!controlled) break;
+            std::optional<double> payoff = BlackScholes::calculatePremium(leg.option.getStrike(), timeToTarget, leg.option.getType(), current, mu, sigma);
+            if (!payoff) throw std::runtime_error("Error pricing control of " + displayName(strategies[s]));
+            run.payoffMean += *payoff * growthToTarget * leg.quantity;
+        }
+
+    }
+
+    // Legs expiring before the horizon settle on their own dates and exit rules are checked
+    // along the way, both of which need the spot at intermediate dates
+    const bool exitRules = options.takeProfit.has_value() || options.stopLoss.has_value();
+    bool anyPath = false;
+    for (StrategyRun& run : runs) {
+        run.needsPath = (exitRules || run.settlesEarly) && timeToTarget > 0;
+        run.sensitive = options.sensitivities && !run.needsPath && timeToTarget > 0 && sigma > 0;
+        anyPath = anyPath || run.needsPath;
+    }
+
+    // expired legs are plain payoffs with kinks, cheaper to evaluate than to interpolate
+    for (std::size_t s = 0; s < runs.size(); ++s) {
+        StrategyRun& run = runs[s];
+        if (options.interpolateHorizonValue && !run.needsPath && !run.sensitive && run.aliveAtHorizon && vol > 0) {
+            run.spline = fitHorizonSpline([&](double Z) {
+                return getHorizonValue(strategies[s].getLegs(), current * std::exp(drift + vol * Z), timeToTarget, r, volSurface);
+            }, options.interpolationTolerance);
+        }
+    }
+
+    auto finish = [&](const std::vector<HorizonEstimate>& estimates) {
+        for (std::size_t s = 0; s < runs.size(); ++s) {
+            const StrategyRun& run = runs[s];
+
+            double totalProjectedValue = getHorizonValue(strategies[s].getLegs(), target, timeToTarget, r, volSurface);
+
+            double profitPercent = (run.totalCost != 0.0) ? ((totalProjectedValue - run.totalCost) / std::abs(run.totalCost)) * 100.0 : 0.0;
+
+            out[s] = {
+                    nameOf(strategies[s]),
+                    run.totalCost,
+                    totalProjectedValue,
+                    profitPercent,
+                    estimates[s].pop,
+                    run.greeks,
+                    estimates[s].expectedValue,
+                    estimates[s].expectedValueStdError,
+                    estimates[s].popStdError,
+                    estimates[s].paths,
+                    estimates[s].sensitivities
             };
-            return std::mt19937(ss);
-        }();
-
-        std::normal_distribution<> d(0, 1);
-        int ProfitablePaths = 0;
-        double threadSum = 0.0;
-
-        auto simulatePath = [&](double simulatedPrice) {
-            double pathValue = 0.0;
-
-            for(const StrategyLeg& leg : legs) {
-                double legValue = 0.0;
-
-                if(timeRemaining <= 0) {
-                    if(leg.option.getType() == OptionType::Call)
-                        legValue = std::max(0.0, simulatedPrice - leg.option.getStrike());
-                    if(leg.option.getType() == OptionType::Put)
-                        legValue = std::max(0.0, leg.option.getStrike() - simulatedPrice);
-                } else {
-                    legValue = getEstimatedPrice(leg.option, simulatedPrice, timeRemaining, r, volSurface, simulatedPrice);
+        }
+
+        reductionNs += phaseClock.lap();
+        if (options.stats) {
+            SimulationStats stats;
+            if constexpr (instrument::enabled) {
+                stats.instrumented = true;
+                stats.wallSeconds = instrument::seconds(wallClock.lap());
+                stats.setupSeconds = instrument::seconds(setupNs);
+                stats.reductionSeconds = instrument::seconds(reductionNs);
+                stats.rounds = rounds;
+                for (std::size_t t = 0; t < counters.size(); ++t) {
+                    const ThreadCounters& c = counters[t];
+                    const std::uint64_t drawNs = c.drawNs.load(std::memory_order_relaxed), valuationNs = c.valuationNs.load(std::memory_order_relaxed);
+                    stats.drawSeconds += instrument::seconds(drawNs);
+                    stats.valuationSeconds += instrument::seconds(valuationNs);
+                    stats.paths += c.paths.load(std::memory_order_relaxed);
+                    if (c.blocks.load(std::memory_order_relaxed) > 0)
+                        stats.threads.push_back({t, c.blocks.load(std::memory_order_relaxed), c.paths.load(std::memory_order_relaxed), instrument::seconds(drawNs + valuationNs)});
                 }
-                pathValue += legValue * leg.quantity;
             }
-            return pathValue;
-        };
-
-        for (int i = 0; i < iterations / 2; ++i) {
-            double Z = d(gen);
-            double pnl{};
+            *options.stats = std::move(stats);
+        }
+    };
 
-            double price1 = current * std::exp(drift + vol * Z);
-            double val1 = simulatePath(price1);
-            threadSum += val1;
-            pnl = val1 - totalCost;
-            if (pnl > 0) ProfitablePaths++;
+    // Without exit rules the value depends on a single lognormal spot, so PoP and EV are
+    // one-dimensional integrals: over the horizon spot, or over the common expiry spot when
+    // every leg has expired by then. Legs settling on different earlier dates need paths.
+    auto commonExpiry = [&](std::size_t s) -> std::optional<double> {
+        const std::span<const StrategyLeg> legs = strategies[s].getLegs();
+        for (const StrategyLeg& leg : legs)
+            if (std::abs(leg.option.getTimeToExpiry() - legs[0].option.getTimeToExpiry()) > PathBlock::SAME_DATE) return std::nullopt;
+        return legs[0].option.getTimeToExpiry();
+    };
+    bool analytic = options.analytic && !exitRules && vol > 0;
+    for (std::size_t s = 0; s < runs.size(); ++s)
+        analytic = analytic && (!runs[s].settlesEarly || commonExpiry(s));
 
-            double price2 = current * std::exp(drift + vol * (-Z));
-            double val2 = simulatePath(price2);
-            threadSum += val2;
-            pnl = val2 - totalCost;
-            if (pnl > 0) ProfitablePaths++;
+    if (analytic) {
+        std::vector<HorizonEstimate> estimates(runs.size());
+        for (std::size_t s = 0; s < runs.size(); ++s) {
+            const std::span<const StrategyLeg> legs = strategies[s].getLegs();
+            const StrategyRun& run = runs[s];
+            if (!run.aliveAtHorizon && commonExpiry(s)) {
+                const double settle = std::min(*commonExpiry(s), timeToTarget);
+                const HorizonDistribution dist{current, (mu - 0.5 * sigma * sigma) * settle, sigma * std::sqrt(settle)};
+                estimates[s] = expiryEstimate(legs, run.totalCost, dist);
+            } else {
+                estimates[s] = quadratureEstimate([&](double Z) {
+                    return getHorizonValue(legs, current * std::exp(drift + vol * Z), timeToTarget, r, volSurface);
+                }, run.totalCost);
+                if (!run.aliveAtHorizon) {
+                    // legs expiring on the horizon put kinks in the value; take their part of
+                    // the EV in closed form and leave only the smooth legs to the quadrature
+                    thread_local std::vector<StrategyLeg> expired, live;
+                    expired.clear();
+                    live.clear();
+                    for (const StrategyLeg& leg : legs)
+                        (leg.option.getTimeToExpiry() - timeToTarget <= PathBlock::SAME_DATE ? expired : live).push_back(leg);
+                    const HorizonDistribution dist{current, drift, vol};
+                    estimates[s].expectedValue = expiryEstimate(expired, 0.0, dist).expectedValue + quadratureMean([&](double Z) {
+                        return getHorizonValue(live, current * std::exp(drift + vol * Z), timeToTarget, r, volSurface);
+                    });
+                }
+            }
         }
+        setupNs += phaseClock.lap();
+        finish(estimates);
+        return;
+    }
 
-        return {ProfitablePaths, threadSum};
-    };
+    // Paths run as antithetic pairs in fixed-size blocks. Each block draws its normals by index
+    // and the block statistics are merged in block order, so a seeded run does not depend on
+    // threads. Every strategy is valued on the same terminal spots.
+    const bool adaptive = options.targetStandardError > 0.0 || options.targetRelativeError > 0.0;
+    if (adaptive && options.maxPaths < 2) throw std::runtime_error("maxPaths must allow at least one path pair");
 
-    for(int i = 0 ; i < threadCount ; i++) {
-        int count = (i == threadCount - 1) ? (simulations - (i * simsPerThread)) : simsPerThread;
-        futures.push_back(std::async(std::launch::async, worker, count));
+    std::uint64_t pairs = static_cast<std::uint64_t>(std::max(options.paths / 2, 1));
+    std::uint64_t maxBlocks = 0;
+    if (adaptive) {
+        // adaptive rounds only ever add whole blocks
+        maxBlocks = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(options.maxPaths / 2) / PAIRS_PER_BLOCK);
+        pairs = std::min(maxBlocks, (pairs + PAIRS_PER_BLOCK - 1) / PAIRS_PER_BLOCK) * PAIRS_PER_BLOCK;
     }
 
-    int totalProfitablePaths = 0;
-    double grandTotalValue = 0.0;
+    std::vector<double> times;
+    if (anyPath) {
+        std::vector<double> expiries;
+        for (const StrategyT& strategy : strategies)
+            for (const StrategyLeg& leg : strategy.getLegs()) expiries.push_back(leg.option.getTimeToExpiry());
+        times = PathBlock::timeGrid(timeToTarget, std::max(options.timeSteps, 1), expiries);
+    }
 
-    for(std::future<std::pair<int,double>>& f : futures) {
-        auto result = f.get();
-        totalProfitablePaths += result.first;
-        grandTotalValue += result.second;
+    const std::uint64_t seed = options.seed ? *options.seed : (static_cast<std::uint64_t>(std::random_device{}()) << 32 | std::random_device{}());
+    std::unique_ptr<INormalGenerator> ownGenerator;
+    if (!options.generator) {
+        if (options.quasiRandom) ownGenerator = std::make_unique<SobolNormalGenerator>(seed);
+        else ownGenerator = std::make_unique<PhiloxNormalGenerator>(seed);
     }
+    const INormalGenerator& generator = options.generator ? *options.generator : *ownGenerator;
 
-    double totalProjectedValue = 0.0;
+    const std::size_t strategyCount = runs.size();
+    std::vector<PathStats> totals(strategyCount);
+    std::vector<PathStats> blockStats;   // [block][strategy] for the current round
+    std::uint64_t blocksDone = 0;
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::shared();
+    if constexpr (instrument::enabled) counters = std::vector<ThreadCounters>(pool.size() + 1);
 
-    for(const StrategyLeg& leg : legs) {
-        double val = getEstimatedPrice(leg.option, target, timeRemaining, r, volSurface, target);
-        totalProjectedValue += val * leg.quantity;
-    }
-
-    double profitPercent = (totalCost != 0.0) ? ((totalProjectedValue - totalCost) / std::abs(totalCost)) * 100.0 : 0.0;
-    double pop = static_cast<double>(totalProfitablePaths) / simulations;
-    double expectedValue = grandTotalValue / simulations;
-
-    return {
-            strategy.getName(),
-            totalCost,
-            totalProjectedValue,
-            profitPercent,
-            pop,
-            strategyGreeks,
-            expectedValue
+    // Every block draws the horizon spots once. Strategies that only depend on the horizon are
+    // valued path by path (or from their spline); the rest walk bridged paths over the time
+    // grid, settling legs at intrinsic value on their expiry dates and checking exit rules on
+    // every date before the horizon in one batch pass per leg.
+    struct PathState {
+        std::vector<std::vector<double>> settled;   // [leg][path], empty until the leg expires
+        std::vector<double> finals;
+        std::vector<std::uint8_t> open;
     };
+
+    auto simulateBlock = [&](std::uint64_t first, std::size_t count, PathStats* stats) {
+        instrument::Stopwatch blockClock;
+        std::uint64_t drawNs = 0, valuationNs = 0;
+        auto countBlock = [&] {
+            if constexpr (instrument::enabled) {
+                valuationNs += blockClock.lap();
+                ThreadCounters& c = counters[std::min(pool.currentWorker(), pool.size())];
+                c.blocks.fetch_add(1, std::memory_order_relaxed);
+                c.paths.fetch_add(2 * count, std::memory_order_relaxed);
+                c.drawNs.fetch_add(drawNs, std::memory_order_relaxed);
+                c.valuationNs.fetch_add(valuationNs, std::memory_order_relaxed);
+            }
+        };
+
+        thread_local std::vector<double> draws, horizonSpots, values, spotSlopes, timeSlopes;
+        thread_local std::vector<PathState> states;
+        thread_local PathBlock block;
+        draws.resize(count);
+        horizonSpots.resize(2 * count);
+        double* upSpots = horizonSpots.data();
+        double* downSpots = horizonSpots.data() + count;
+        generator.fill(0, first, draws);
+        std::size_t i = 0;
+        for (; i + simd::NativeD::width <= count; i += simd::NativeD::width)
+            terminalSpots<simd::NativeD>(draws.data(), upSpots, downSpots, i, current, drift, vol);
+        for (; i < count; ++i)
+            terminalSpots<simd::ScalarD>(draws.data(), upSpots, downSpots, i, current, drift, vol);
+        drawNs += blockClock.lap();
+
+        auto accumulate = [&](std::size_t s, auto&& pathValue) {
+            const StrategyRun& run = runs[s];
+            const std::span<const StrategyLeg> legs = strategies[s].getLegs();
+            for (std::size_t i = 0; i < count; ++i) {
+                double val1 = pathValue(i);
+                double val2 = pathValue(count + i);
+                int hits = (val1 - run.totalCost > 0) + (val2 - run.totalCost > 0);
+
+                double spot = 0.0, payoff = 0.0;
+                if (controlled) {
+                    spot = 0.5 * (upSpots[i] + downSpots[i]) - spotMean;
+                    payoff = 0.5 * (intrinsicValue(legs, upSpots[i]) + intrinsicValue(legs, downSpots[i])) - run.payoffMean;
+                }
+                stats[s].add(0.5 * (val1 + val2) - run.totalCost, hits, spot, payoff);
+            }
+        };
+
+        // Per path, the horizon spot's derivative in each input times the value's slope in it
+        // (pathwise), and the profitable paths weighted by the score of the horizon draw
+        // (likelihood ratio). The profit threshold's own moves are central differences.
+        auto accumulateSensitivities = [&](std::size_t s) {
+            const StrategyRun& run = runs[s];
+            const double sqrtT = std::sqrt(timeToTarget);
+            const double logDrift = mu - 0.5 * sigma * sigma;
+            const double spotBump = POP_SPOT_BUMP * current;
+            const double dayBump = 1.0 / gbl::TRADING_DAYS;
+            for (std::size_t i = 0; i < count; ++i) {
+                std::array<double, 8> sample{};
+                for (std::size_t p : {i, count + i}) {
+                    const double Z = p < count ? draws[i] : -draws[i];
+                    const double S = horizonSpots[p];
+                    const double slope = spotSlopes[p];
+                    sample[0] += slope * S / current;
+                    sample[1] += slope * S * (Z * sqrtT - sigma * timeToTarget);
+                    sample[2] += slope * S * timeToTarget;
+                    sample[3] += (slope * S * (logDrift + 0.5 * sigma * Z / sqrtT) + timeSlopes[p]) * dayBump;
+
+                    const double pnl = values[p] - run.totalCost;
+                    const double hit = pnl > 0 ? 1.0 : 0.0;
+                    const double entryMove = run.entrySlope * spotBump;
+                    const double decay = timeSlopes[p] * dayBump;
+                    sample[4] += hit * Z / (current * vol) + 0.5 * ((pnl > entryMove) - (pnl > -entryMove)) / spotBump;
+                    sample[5] += hit * ((Z * Z - 1.0) / sigma - Z * sqrtT);
+                    sample[6] += hit * Z * sqrtT / sigma;
+                    sample[7] += hit * ((Z * Z - 1.0) / (2.0 * timeToTarget) + Z * logDrift / vol) * dayBump
+                                 + 0.5 * ((pnl + decay > 0) - (pnl - decay > 0));
+                }
+                for (double& x : sample) x *= 0.5;
+                stats[s].addSensitivities(sample);
+            }
+        };
+
+        const std::size_t paths = 2 * count;
+        values.resize(paths);
+        for (std::size_t s = 0; s < strategyCount; ++s) {
+            const StrategyRun& run = runs[s];
+            if (run.needsPath) continue;
+            const std::span<const StrategyLeg> legs = strategies[s].getLegs();
+            if (run.sensitive) {
+                spotSlopes.resize(paths);
+                timeSlopes.resize(paths);
+                valueOnPaths(legs, timeToTarget, horizonSpots, {}, r, volSurface, options.precision, values, spotSlopes, timeSlopes);
+                accumulate(s, [&](std::size_t p) { return values[p]; });
+                accumulateSensitivities(s);
+                continue;
+            }
+            if (!run.spline) {
+                valueOnPaths(legs, timeToTarget, horizonSpots, {}, r, volSurface, options.precision, values);
+                accumulate(s, [&](std::size_t p) { return values[p]; });
+                continue;
+            }
+            accumulate(s, [&](std::size_t p) {
+                const double Z = p < count ? draws[p] : -draws[p - count];
+                if (std::abs(Z) <= SPLINE_RANGE) return run.spline->evaluate(Z);
+                return getHorizonValue(legs, horizonSpots[p], timeToTarget, r, volSurface);
+            });
+        }
+        valuationNs += blockClock.lap();
+        if (!anyPath) {
+            countBlock();
+            return;
+        }
+
+        states.resize(std::max(states.size(), strategyCount));
+        for (std::size_t s = 0; s < strategyCount; ++s) {
+            if (!runs[s].needsPath) continue;
+            PathState& state = states[s];
+            state.settled.resize(strategies[s].getLegs().size());
+            for (std::vector<double>& legValues : state.settled) legValues.clear();
+            state.finals.resize(paths);
+            state.open.assign(paths, 1);
+        }
+
+        thread_local std::vector<double> horizonLogReturns;
+        horizonLogReturns.resize(paths);
+        for (std::size_t i = 0; i < count; ++i) {
+            horizonLogReturns[i] = drift + vol * draws[i];
+            horizonLogReturns[count + i] = drift - vol * draws[i];
+        }
+        block.begin(generator, first, times, current, sigma, horizonLogReturns);
+
+        while (block.advance()) {
+            drawNs += blockClock.lap();
+            std::span<const double> spots = block.spots();
+            for (std::size_t s = 0; s < strategyCount; ++s) {
+                const StrategyRun& run = runs[s];
+                if (!run.needsPath) continue;
+                const std::span<const StrategyLeg> legs = strategies[s].getLegs();
+                PathState& state = states[s];
+
+                for (std::size_t l = 0; l < legs.size(); ++l) {
+                    if (!state.settled[l].empty() || legs[l].option.getTimeToExpiry() > block.time() + PathBlock::SAME_DATE) continue;
+                    state.settled[l].resize(paths);
+                    for (std::size_t p = 0; p < paths; ++p) state.settled[l][p] = intrinsicValue(legs[l].option, spots[p]);
+                }
+                if (!block.atHorizon() && !exitRules) continue;
+
+                valueOnPaths(legs, block.time(), spots, state.settled, r, volSurface, options.precision, values);
+                for (std::size_t p = 0; p < paths; ++p) {
+                    if (!state.open[p]) continue;
+                    const double pnl = values[p] - run.totalCost;
+                    const bool exit = block.atHorizon() || (options.takeProfit && pnl >= *options.takeProfit)
+                                      || (options.stopLoss && pnl <= -*options.stopLoss);
+                    if (exit) {
+                        state.finals[p] = values[p];
+                        state.open[p] = 0;
+                    }
+                }
+            }
+            valuationNs += blockClock.lap();
+        }
+
+        for (std::size_t s = 0; s < strategyCount; ++s)
+            if (runs[s].needsPath) accumulate(s, [&](std::size_t p) { return states[s].finals[p]; });
+        countBlock();
+    };
+
+    auto runRound = [&](std::uint64_t blockEnd) {
+        const std::uint64_t roundBlocks = blockEnd - blocksDone;
+        blockStats.assign(roundBlocks * strategyCount, PathStats{});
+        reductionNs += phaseClock.lap();
+
+        pool.parallelFor(roundBlocks, [&](std::size_t roundBlock) {
+            const std::uint64_t first = (blocksDone + roundBlock) * PAIRS_PER_BLOCK;
+            const std::size_t count = std::min<std::uint64_t>(PAIRS_PER_BLOCK, pairs - first);
+            simulateBlock(first, count, &blockStats[roundBlock * strategyCount]);
+        });
+        phaseClock.lap();   // the round itself is accounted per thread
+        ++rounds;
+
+        for (std::uint64_t b = 0; b < roundBlocks; ++b)
+            for (std::size_t s = 0; s < strategyCount; ++s)
+                totals[s].merge(blockStats[b * strategyCount + s]);
+        blocksDone = blockEnd;
+    };
+
+    // the loosest of the two targets applies
+    auto targetError = [&](double expectedValue) {
+        return std::max(options.targetStandardError, options.targetRelativeError * std::abs(expectedValue));
+    };
+
+    setupNs += phaseClock.lap();
+    runRound((pairs + PAIRS_PER_BLOCK - 1) / PAIRS_PER_BLOCK);
+
+    while (adaptive && blocksDone < maxBlocks) {
+        // standard error falls as 1/sqrt(n): size the next round for the slowest strategy
+        double growth = 1.0;
+        for (std::size_t s = 0; s < strategyCount; ++s) {
+            const auto [mean, error] = totals[s].estimate(controlled);
+            const double target = targetError(runs[s].totalCost + mean);
+            if (error > target) growth = std::max(growth, target > 0.0 ? (error / target) * (error / target) : 4.0);
+        }
+        if (growth <= 1.0) break;
+
+        // overshoot the estimate slightly rather than paying for an extra round
+        const auto wanted = static_cast<std::uint64_t>(std::ceil(static_cast<double>(blocksDone) * std::min(growth * 1.1, 16.0)));
+        const std::uint64_t blockEnd = std::min(maxBlocks, std::max(wanted, blocksDone + 1));
+        pairs = blockEnd * PAIRS_PER_BLOCK;
+        runRound(blockEnd);
+    }
+
+    std::vector<HorizonEstimate> estimates(strategyCount);
+    for (std::size_t s = 0; s < strategyCount; ++s) {
+        const auto [mean, stdError] = totals[s].estimate(controlled);
+        estimates[s] = {runs[s].totalCost + mean, stdError, totals[s].pop(), totals[s].popStdError(), 2 * totals[s].pairs};
+        if (!runs[s].sensitive) continue;
+        estimates[s].sensitivities = totals[s].sensitivityEstimate();
+        if (!runs[s].aliveAtHorizon) {
+            constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+            estimates[s].sensitivities->expectedValue.days = estimates[s].sensitivities->pop.days = nan;
+            estimates[s].sensitivities->expectedValueStdError.days = estimates[s].sensitivities->popStdError.days = nan;
+        }
+    }
+    finish(estimates);
 }
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "Headers/PathEngine.h"
+#include "Headers/Simd.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// One bridge step for a pair of paths: move a fraction `pull` of the way to the horizon, plus
+// noise of standard deviation `spread`
+template <class V>
+void bridgeStep(const double* draws, double* logReturns, const double* horizon, double* spots,
+                std::size_t pairs, std::size_t i, double pull, double spread, double current) {
+    const V Z = V::load(draws + i);
+    const V a = V::broadcast(pull);
+    const V b = V::broadcast(spread);
+    const V S0 = V::broadcast(current);
+
+    V up = V::load(logReturns + i);
+    up = mulAdd(a, V::load(horizon + i) - up, up) + b * Z;
+    up.store(logReturns + i);
+    (S0 * simd::exp(up)).store(spots + i);
+
+    V down = V::load(logReturns + pairs + i);
+    down = mulAdd(a, V::load(horizon + pairs + i) - down, down) - b * Z;
+    down.store(logReturns + pairs + i);
+    (S0 * simd::exp(down)).store(spots + pairs + i);
+}
+
+}
+
+void PathBlock::begin(const INormalGenerator& generator, std::uint64_t firstPair, std::span<const double> times,
+                      double current, double sigma, std::span<const double> horizonLogReturns) {
+    if (times.size() < 2) throw std::invalid_argument("ERROR: a path needs at least one step");
+    if (horizonLogReturns.size() % 2 != 0) throw std::invalid_argument("ERROR: paths come in antithetic pairs");
+
+    times_.assign(times.begin(), times.end());
+    pairs_ = horizonLogReturns.size() / 2;
+    date_ = 0;
+    current_ = current;
+    sigma_ = sigma;
+    firstPair_ = firstPair;
+    generator_ = &generator;
+    horizonLogReturns_.assign(horizonLogReturns.begin(), horizonLogReturns.end());
+    logReturns_.assign(paths(), 0.0);
+    spots_.assign(paths(), current);
+    draws_.resize(pairs_);
+}
+
+bool PathBlock::advance() {
+    if (atHorizon()) return false;
+    ++date_;
+
+    double* spots = spots_.data();
+    if (atHorizon()) {
+        for (std::size_t p = 0; p < paths(); ++p) {
+            logReturns_[p] = horizonLogReturns_[p];
+            spots[p] = current_ * std::exp(horizonLogReturns_[p]);
+        }
+        return true;
+    }
+
+    const double dt = times_[date_] - times_[date_ - 1];
+    const double left = times_.back() - times_[date_ - 1];
+    const double pull = dt / left;
+    const double spread = sigma_ * std::sqrt(dt * (left - dt) / left);
+    generator_->fill(date_, firstPair_, draws_);
+
+    std::size_t i = 0;
+    for (; i + simd::NativeD::width <= pairs_; i += simd::NativeD::width)
+        bridgeStep<simd::NativeD>(draws_.data(), logReturns_.data(), horizonLogReturns_.data(), spots, pairs_, i, pull, spread, current_);
+    for (; i < pairs_; ++i)
+        bridgeStep<simd::ScalarD>(draws_.data(), logReturns_.data(), horizonLogReturns_.data(), spots, pairs_, i, pull, spread, current_);
+    return true;
+}
+
+std::vector<double> PathBlock::timeGrid(double horizon, int steps, std::span<const double> extraDates) {
+    if (steps < 1) throw std::invalid_argument("ERROR: timeGrid needs at least one step");
+
+    std::vector<double> times;
+    for (int k = 0; k <= steps; ++k)
+        times.push_back(horizon * k / steps);
+    for (double date : extraDates)
+        if (date > 0.0 && date < horizon) times.push_back(date);
+    std::sort(times.begin(), times.end());
+
+    std::vector<double> unique{times.front()};
+    for (std::size_t k = 1; k < times.size(); ++k)
+        if (times[k] - unique.back() > SAME_DATE) unique.push_back(times[k]);
+    unique.back() = horizon;
+    return unique;
+}
@@ -0,0 +1,212 @@
+#include "Headers/PdeSolver.h"
+#include "Headers/Global.h"
+#include "Headers/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Tridiagonal system sub x[i-1] + diag[i] x[i] + sup x[i+1] = rhs[i] with constant off
+// diagonals, eliminated from the top node down so that a solve is multiplies only. The factors
+// of a constant base diagonal are kept; a solve that adds weight to nodes below `changed`
+// refactors just those nodes, which is all an exercise region at the low end disturbs.
+class Tridiagonal {
+    double sub_ = 0.0, centre_ = 0.0, sup_ = 0.0;
+    std::vector<double> baseInverse_, baseRatio_;   // 1/pivot and sub/pivot of the base diagonal
+    std::vector<double> ratio_;
+
+public:
+    void factor(double sub, double centre, double sup, std::size_t n) {
+        sub_ = sub;
+        centre_ = centre;
+        sup_ = sup;
+        baseInverse_.resize(n);
+        baseRatio_.resize(n);
+        ratio_.resize(n);
+        double ratio = 0.0;
+        for (std::size_t i = n; i-- > 0;) {
+            baseInverse_[i] = 1.0 / (centre - sup * ratio);
+            ratio = baseRatio_[i] = sub * baseInverse_[i];
+        }
+    }
+
+    // extra[i] is added to the diagonal of nodes i < changed; rhs is overwritten by x
+    void solve(std::span<const double> extra, std::size_t changed, std::span<double> rhs) {
+        const std::size_t n = rhs.size();
+        double y = 0.0;
+        for (std::size_t i = n; i-- > changed;) y = rhs[i] = (rhs[i] - sup_ * y) * baseInverse_[i];
+        double ratio = changed < n ? baseRatio_[changed] : 0.0;
+        for (std::size_t i = changed; i-- > 0;) {
+            const double inverse = 1.0 / (centre_ + extra[i] - sup_ * ratio);
+            ratio = ratio_[i] = sub_ * inverse;
+            y = rhs[i] = (rhs[i] - sup_ * y) * inverse;
+        }
+        for (std::size_t i = 1; i < n; ++i) rhs[i] -= (i < changed ? ratio_[i] : baseRatio_[i]) * rhs[i - 1];
+    }
+};
+
+// Quadratic through nodes i-1, i, i+1 at offset t (in nodes) from i
+double quadratic(const std::vector<double>& f, std::size_t i, double t) {
+    return f[i] + 0.5 * t * (f[i + 1] - f[i - 1]) + 0.5 * t * t * (f[i + 1] - 2.0 * f[i] + f[i - 1]);
+}
+
+}
+
+PdePoint PdeGrid::at(double spot) const {
+    const std::size_t n = spots.size();
+    if (n < 3) throw std::out_of_range("ERROR: Empty PDE grid");
+    const double dx = std::log(spots[1] / spots[0]);
+    const double u = std::clamp(std::log(spot / spots[0]) / dx, 0.0, static_cast<double>(n - 1));
+    const std::size_t i = std::clamp<std::size_t>(static_cast<std::size_t>(std::lround(u)), 1, n - 2);
+    const double t = u - static_cast<double>(i);
+    return {quadratic(values, i, t), quadratic(deltas, i, t), quadratic(gammas, i, t), quadratic(thetas, i, t)};
+}
+
+void PdeGrid::valuesAt(std::span<const double> at, std::span<double> out) const {
+    const std::size_t n = spots.size();
+    if (n < 3) throw std::out_of_range("ERROR: Empty PDE grid");
+    if (at.size() != out.size()) throw std::invalid_argument("ERROR: valuesAt input and output sizes differ");
+    const double logFirst = std::log(spots[0]);
+    const double inverseDx = 1.0 / std::log(spots[1] / spots[0]);
+    for (std::size_t k = 0; k < at.size(); ++k) {
+        const double u = std::clamp((std::log(at[k]) - logFirst) * inverseDx, 0.0, static_cast<double>(n - 1));
+        const std::size_t i = std::clamp<std::size_t>(static_cast<std::size_t>(std::lround(u)), 1, n - 2);
+        out[k] = quadratic(values, i, u - static_cast<double>(i));
+    }
+}
+
+PdeGrid PdeSolver::solve(double K, double T, OptionType type, double spot, double r, double sigma, const PdeOptions& options) {
+    if (K <= 0 || T <= 0 || spot <= 0 || sigma <= 0) throw std::invalid_argument("ERROR: PDE solve needs positive K, T, S and sigma");
+    if (options.spotNodes < 5 || options.timeSteps == 0) throw std::invalid_argument("ERROR: PDE grid needs at least 5 nodes and one step");
+
+    // odd node count keeps today's spot on the middle node
+    const std::size_t N = options.spotNodes | 1;
+    const std::size_t M = N - 2;   // interior nodes
+    const bool isCall = type == OptionType::Call;
+    const double half = options.widthStdDevs * sigma * std::sqrt(T) + std::abs(std::log(K / spot));
+    const double dx = 2.0 * half / static_cast<double>(N - 1);
+    const double x0 = std::log(spot) - half;
+
+    PdeGrid grid;
+    grid.spots.resize(N);
+    std::vector<double> payoff(N), V(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        grid.spots[i] = std::exp(x0 + dx * static_cast<double>(i));
+        payoff[i] = isCall ? std::max(grid.spots[i] - K, 0.0) : std::max(K - grid.spots[i], 0.0);
+    }
+    V = payoff;
+    std::vector<double> previous = V;
+    double lastStep = 0.0;
+
+    const double horizon = T - std::max(options.elapsed, 0.0);
+    if (horizon > 0.0) {
+        // L V_i = a V_(i-1) + b V_i + c V_(i+1) for V_t + (r - sigma^2/2) V_x + sigma^2/2 V_xx - r V = 0
+        const double alpha = 0.5 * sigma * sigma / (dx * dx);
+        const double beta = (r - 0.5 * sigma * sigma) / (2.0 * dx);
+        const double a = alpha - beta, b = -2.0 * alpha - r, c = alpha + beta;
+        const double penalty = 1.0 / options.penaltyTolerance;
+
+        std::vector<double> rhs(M), extra(M, 0.0), solution(M), iterate(M);
+        Tridiagonal system;
+        double factoredTheta = -1.0, factoredStep = -1.0;
+        const double dt = horizon / static_cast<double>(options.timeSteps);
+        double tau = 0.0;
+
+        // one theta-scheme step of size h from tau to tau + h
+        auto step = [&](double theta, double h) {
+            const double next = tau + h;
+            const double Slow = grid.spots.front(), Shigh = grid.spots.back();
+            const double discountedK = K * std::exp(-r * next);
+            const double low = isCall ? 0.0 : (options.american ? K - Slow : discountedK - Slow);
+            const double high = isCall ? Shigh - discountedK : 0.0;
+
+            const double explicitPart = (1.0 - theta) * h;
+            for (std::size_t j = 0; j < M; ++j) {
+                const std::size_t i = j + 1;
+                rhs[j] = V[i] + explicitPart * (a * V[i - 1] + b * V[i] + c * V[i + 1]);
+            }
+            rhs[0] += theta * h * a * low;
+            rhs[M - 1] += theta * h * c * high;
+            if (theta != factoredTheta || h != factoredStep) {
+                system.factor(-theta * h * a, 1.0 - theta * h * b, -theta * h * c, M);
+                factoredTheta = theta;
+                factoredStep = h;
+            }
+
+            solution = rhs;
+            if (!options.american) {
+                system.solve(extra, 0, solution);
+            } else {
+                // policy iteration on the penalty: nodes below the payoff are pulled onto it
+                for (std::size_t j = 0; j < M; ++j) iterate[j] = V[j + 1];
+                for (int pass = 0; pass < 100; ++pass) {
+                    std::size_t changed = 0;
+                    bool sameSet = pass > 0;
+                    for (std::size_t j = 0; j < M; ++j) {
+                        const bool exercised = iterate[j] < payoff[j + 1];
+                        const double weight = exercised ? penalty : 0.0;
+                        sameSet = sameSet && extra[j] == weight;
+                        extra[j] = weight;
+                        solution[j] = rhs[j] + weight * payoff[j + 1];
+                        if (exercised) changed = j + 1;
+                    }
+                    // the iterate already solves the system for this exercise set
+                    if (sameSet) break;
+                    system.solve(extra, changed, solution);
+                    double change = 0.0;
+                    for (std::size_t j = 0; j < M; ++j)
+                        change = std::max(change, std::abs(solution[j] - iterate[j]) / std::max(1.0, std::abs(solution[j])));
+                    iterate.swap(solution);
+                    if (change <= options.penaltyTolerance) break;
+                }
+                solution.swap(iterate);
+            }
+
+            previous = V;
+            V[0] = low;
+            V[N - 1] = high;
+            for (std::size_t j = 0; j < M; ++j) V[j + 1] = solution[j];
+            tau = next;
+            lastStep = h;
+        };
+
+        const std::size_t startup = std::min(options.rannacherSteps, options.timeSteps);
+        for (std::size_t n = 0; n < startup; ++n) {
+            step(1.0, 0.5 * dt);
+            step(1.0, 0.5 * dt);
+        }
+        for (std::size_t n = startup; n < options.timeSteps; ++n) step(0.5, dt);
+    }
+
+    grid.values = V;
+    grid.deltas.resize(N);
+    grid.gammas.resize(N);
+    grid.thetas.resize(N);
+    for (std::size_t i = 1; i + 1 < N; ++i) {
+        const double Vx = (V[i + 1] - V[i - 1]) / (2.0 * dx);
+        const double Vxx = (V[i + 1] - 2.0 * V[i] + V[i - 1]) / (dx * dx);
+        const double S = grid.spots[i];
+        grid.deltas[i] = Vx / S;
+        grid.gammas[i] = (Vxx - Vx) / (S * S);
+    }
+    grid.deltas[0] = grid.deltas[1];
+    grid.deltas[N - 1] = grid.deltas[N - 2];
+    grid.gammas[0] = grid.gammas[1];
+    grid.gammas[N - 1] = grid.gammas[N - 2];
+    for (std::size_t i = 0; i < N; ++i)
+        grid.thetas[i] = lastStep > 0.0 ? -(V[i] - previous[i]) / lastStep / gbl::TRADING_DAYS : 0.0;
+    return grid;
+}
+
+std::vector<PdeGrid> PdeSolver::solveBatch(std::span<const Option> options, double spot, double r, const IVolatilitySurface& volSurface,
+                                           const PdeOptions& pde, ThreadPool* pool) {
+    std::vector<PdeGrid> grids(options.size());
+    ThreadPool& workers = pool ? *pool : ThreadPool::shared();
+    workers.parallelFor(options.size(), [&](std::size_t i) {
+        const Option& option = options[i];
+        const double sigma = volSurface.getVol(option.getStrike(), option.getTimeToExpiry(), spot);
+        grids[i] = solve(option.getStrike(), option.getTimeToExpiry(), option.getType(), spot, r, sigma, pde);
+    });
+    return grids;
+}
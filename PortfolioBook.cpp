@@ -0,0 +1,151 @@
+#include "Headers/PortfolioBook.h"
+#include "Headers/BlackScholes.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+// Quantities within this of zero count as flat; the residual is taken out of the totals
+constexpr double FLAT = 1e-12;
+
+}
+
+std::size_t PortfolioBook::KeyHash::operator()(const Key& key) const {
+    std::size_t h = std::hash<double>{}(key.strike);
+    h ^= std::hash<double>{}(key.expiry) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h ^ (static_cast<std::size_t>(key.type) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+}
+
+PortfolioBook::PortfolioBook(double spot, double r, const IVolatilitySurface& volSurface)
+    : spot_(spot), r_(r), volSurface_(volSurface) {
+    if (spot <= 0) throw std::invalid_argument("ERROR: Spot must be positive");
+}
+
+void PortfolioBook::add(std::span<const BookPosition> positions) {
+    for (const BookPosition& position : positions) {
+        if (!(position.strike > 0) || !(position.expiry > 0) || !std::isfinite(position.quantity))
+            throw std::invalid_argument("ERROR: Book positions need a positive strike and expiry and a finite quantity");
+    }
+
+    const std::size_t first = size();
+    std::vector<std::size_t> touched;
+    touched.reserve(positions.size());
+    for (const BookPosition& position : positions) {
+        if (position.quantity == 0.0) continue;
+        auto [it, inserted] = rows_.try_emplace(Key{position.strike, position.expiry, position.type}, size());
+        const std::size_t row = it->second;
+        if (inserted) {
+            strikes_.push_back(position.strike);
+            expiries_.push_back(position.expiry);
+            types_.push_back(position.type);
+            quantities_.push_back(0.0);
+        }
+        quantities_[row] += position.quantity;
+        // existing rows already carry Greeks at this market; new ones are priced below
+        if (row < first) accumulate(row, position.quantity);
+        touched.push_back(row);
+    }
+
+    price(first);
+    for (std::size_t row = first; row < size(); ++row) accumulate(row, quantities_[row]);
+
+    // descending, so the row swapped into a dropped slot has been looked at already
+    std::sort(touched.begin(), touched.end(), std::greater<>());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    for (std::size_t row : touched)
+        if (std::abs(quantities_[row]) <= FLAT) dropRow(row);
+}
+
+void PortfolioBook::add(const BookPosition& position) {
+    add(std::span<const BookPosition>(&position, 1));
+}
+
+void PortfolioBook::add(const Strategy& strategy, double multiplier) {
+    std::vector<BookPosition> positions;
+    positions.reserve(strategy.getLegs().size());
+    for (const StrategyLeg& leg : strategy.getLegs())
+        positions.push_back({leg.option.getStrike(), leg.option.getTimeToExpiry(), leg.option.getType(), leg.quantity * multiplier});
+    add(positions);
+}
+
+void PortfolioBook::remove(const Strategy& strategy, double multiplier) {
+    add(strategy, -multiplier);
+}
+
+void PortfolioBook::add(const CompactStrategy& strategy, double multiplier) {
+    std::array<BookPosition, CompactStrategy::MAX_LEGS> positions{};
+    const std::span<const StrategyLeg> legs = strategy.getLegs();
+    for (std::size_t i = 0; i < legs.size(); ++i)
+        positions[i] = {legs[i].option.getStrike(), legs[i].option.getTimeToExpiry(), legs[i].option.getType(), legs[i].quantity * multiplier};
+    add(std::span<const BookPosition>(positions.data(), legs.size()));
+}
+
+void PortfolioBook::remove(const CompactStrategy& strategy, double multiplier) {
+    add(strategy, -multiplier);
+}
+
+std::size_t PortfolioBook::reprice(double spot, double r) {
+    if (spot <= 0) throw std::invalid_argument("ERROR: Spot must be positive");
+    spot_ = spot;
+    r_ = r;
+    const std::size_t priced = price(0);
+    totals_ = {};
+    for (std::size_t row = 0; row < size(); ++row) accumulate(row, quantities_[row]);
+    return priced;
+}
+
+double PortfolioBook::quantity(double strike, double expiry, OptionType type) const {
+    auto it = rows_.find(Key{strike, expiry, type});
+    return it == rows_.end() ? 0.0 : quantities_[it->second];
+}
+
+Greeks PortfolioBook::unitGreeks(std::size_t row) const {
+    if (row >= size()) throw std::out_of_range("ERROR: Book row out of range");
+    return {premium_[row], delta_[row], gamma_[row], theta_[row], vega_[row], rho_[row]};
+}
+
+void PortfolioBook::accumulate(std::size_t row, double quantity) {
+    totals_.premium += quantity * premium_[row];
+    totals_.delta += quantity * delta_[row];
+    totals_.gamma += quantity * gamma_[row];
+    totals_.theta += quantity * theta_[row];
+    totals_.vega += quantity * vega_[row];
+    totals_.rho += quantity * rho_[row];
+}
+
+std::size_t PortfolioBook::price(std::size_t first) {
+    const std::size_t n = size() - first;
+    for (std::vector<double>* column : {&premium_, &delta_, &gamma_, &theta_, &vega_, &rho_}) column->resize(size());
+    if (n == 0) return 0;
+
+    std::span<const double> strikes = std::span<const double>(strikes_).subspan(first);
+    std::span<const double> expiries = std::span<const double>(expiries_).subspan(first);
+    std::vector<double> spots(n, spot_), rates(n, r_), vols(n);
+    std::vector<std::uint8_t> valid(n);
+    volSurface_.getVols(strikes, expiries, spot_, vols);
+
+    ChainInputs inputs{strikes, expiries, std::span<const OptionType>(types_).subspan(first), spots, rates, vols};
+    auto tail = [first](std::vector<double>& column) { return std::span<double>(column).subspan(first); };
+    GreeksBatch outputs{tail(premium_), tail(delta_), tail(gamma_), tail(theta_), tail(vega_), tail(rho_)};
+    return BlackScholes::calculateBatch(inputs, outputs, valid);
+}
+
+void PortfolioBook::dropRow(std::size_t row) {
+    accumulate(row, -quantities_[row]);
+    rows_.erase(Key{strikes_[row], expiries_[row], types_[row]});
+    const std::size_t last = size() - 1;
+    if (row != last) {
+        strikes_[row] = strikes_[last];
+        expiries_[row] = expiries_[last];
+        types_[row] = types_[last];
+        quantities_[row] = quantities_[last];
+        for (std::vector<double>* column : {&premium_, &delta_, &gamma_, &theta_, &vega_, &rho_}) (*column)[row] = (*column)[last];
+        rows_[Key{strikes_[row], expiries_[row], types_[row]}] = row;
+    }
+    for (std::vector<double>* column : {&strikes_, &expiries_, &quantities_, &premium_, &delta_, &gamma_, &theta_, &vega_, &rho_}) column->pop_back();
+    types_.pop_back();
+}
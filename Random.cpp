@@ -0,0 +1,182 @@
+#include "Headers/Random.h"
+#include "Headers/Simd.h"
+#include <random>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Draws come out of Box-Muller in groups of four per Philox counter
+constexpr std::size_t DRAWS_PER_COUNTER = 4;
+constexpr std::size_t BATCH_COUNTERS = 256;
+
+std::uint32_t mulHiLo(std::uint32_t a, std::uint32_t b, std::uint32_t& hi) {
+    const std::uint64_t product = static_cast<std::uint64_t>(a) * b;
+    hi = static_cast<std::uint32_t>(product >> 32);
+    return static_cast<std::uint32_t>(product);
+}
+
+// uniform on (0, 1) from 32 random bits
+double toUniform(std::uint32_t bits) {
+    return (static_cast<double>(bits) + 0.5) * (1.0 / 4294967296.0);
+}
+
+template <class V>
+void boxMuller(const double* u1, const double* u2, double* radiusCos, double* radiusSin, std::size_t i) {
+    const V radius = sqrt(V::broadcast(-2.0) * simd::log(V::load(u1 + i)));
+    V sine{}, cosine{};
+    simd::sinCos2Pi(V::load(u2 + i), sine, cosine);
+    (radius * cosine).store(radiusCos + i);
+    (radius * sine).store(radiusSin + i);
+}
+
+}
+
+PhiloxNormalGenerator::PhiloxNormalGenerator(std::uint64_t seed)
+        : seed_(seed) {}
+
+std::array<std::uint32_t, 4> PhiloxNormalGenerator::philox(std::array<std::uint32_t, 4> ctr, std::array<std::uint32_t, 2> key) {
+    constexpr std::uint32_t M0 = 0xD2511F53;
+    constexpr std::uint32_t M1 = 0xCD9E8D57;
+    constexpr std::uint32_t W0 = 0x9E3779B9;
+    constexpr std::uint32_t W1 = 0xBB67AE85;
+
+    for (int round = 0; round < 10; ++round) {
+        std::uint32_t hi0{}, hi1{};
+        const std::uint32_t lo0 = mulHiLo(M0, ctr[0], hi0);
+        const std::uint32_t lo1 = mulHiLo(M1, ctr[2], hi1);
+        ctr = {hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        key[0] += W0;
+        key[1] += W1;
+    }
+    return ctr;
+}
+
+void PhiloxNormalGenerator::fill(std::uint64_t stream, std::uint64_t firstDraw, std::span<double> out) const {
+    const std::array<std::uint32_t, 2> key{static_cast<std::uint32_t>(seed_), static_cast<std::uint32_t>(seed_ >> 32)};
+
+    alignas(64) double u1[BATCH_COUNTERS * 2], u2[BATCH_COUNTERS * 2];
+    alignas(64) double radiusCos[BATCH_COUNTERS * 2], radiusSin[BATCH_COUNTERS * 2];
+
+    std::uint64_t counter = firstDraw / DRAWS_PER_COUNTER;
+    std::size_t skip = firstDraw % DRAWS_PER_COUNTER;
+    std::size_t written = 0;
+
+    while (written < out.size()) {
+        const std::size_t needed = out.size() - written + skip;
+        const std::size_t counters = std::min(BATCH_COUNTERS, (needed + DRAWS_PER_COUNTER - 1) / DRAWS_PER_COUNTER);
+
+        // each counter yields two (u1, u2) pairs
+        for (std::size_t c = 0; c < counters; ++c) {
+            const std::uint64_t index = counter + c;
+            const std::array<std::uint32_t, 4> bits = philox(
+                    {static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+                     static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)}, key);
+            u1[2 * c] = toUniform(bits[0]);
+            u2[2 * c] = toUniform(bits[1]);
+            u1[2 * c + 1] = toUniform(bits[2]);
+            u2[2 * c + 1] = toUniform(bits[3]);
+        }
+
+        // every pair goes through the same vector kernel, padded to full width, so a draw
+        // never depends on where the range was split
+        const std::size_t pairs = 2 * counters;
+        const std::size_t padded = (pairs + simd::NativeD::width - 1) / simd::NativeD::width * simd::NativeD::width;
+        std::fill(u1 + pairs, u1 + padded, 0.5);
+        std::fill(u2 + pairs, u2 + padded, 0.5);
+        for (std::size_t i = 0; i < padded; i += simd::NativeD::width)
+            boxMuller<simd::NativeD>(u1, u2, radiusCos, radiusSin, i);
+
+        // draw 4c + {0, 1, 2, 3} = pair 2c cos, pair 2c sin, pair 2c+1 cos, pair 2c+1 sin
+        for (std::size_t d = skip; d < counters * DRAWS_PER_COUNTER && written < out.size(); ++d) {
+            const std::size_t pair = d / 2;
+            out[written++] = (d % 2 == 0) ? radiusCos[pair] : radiusSin[pair];
+        }
+
+        counter += counters;
+        skip = 0;
+    }
+}
+
+SobolNormalGenerator::SobolNormalGenerator(std::uint64_t seed)
+        : seed_(seed) {}
+
+std::uint32_t SobolNormalGenerator::point(std::uint32_t index, std::uint32_t scramble) {
+    // Sobol dimension 1 is the bit-reversed index; an Owen scramble of it is the bit-reversed
+    // Laine-Karras permutation of the index
+    std::uint32_t x = index + scramble;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0f0f0f0fu) | ((x & 0x0f0f0f0fu) << 4);
+    x = ((x >> 8) & 0x00ff00ffu) | ((x & 0x00ff00ffu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+// Acklam's rational approximation (relative error 1.2e-9) polished by one Halley step on erfc
+double SobolNormalGenerator::inverseNormalCDF(double p) {
+    constexpr double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                            1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    constexpr double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                            6.680131188771972e+01, -1.328068155288572e+01};
+    constexpr double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                            -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    constexpr double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                            3.754408661907416e+00};
+    constexpr double LOW = 0.02425;
+
+    double x{};
+    if (p < LOW) {
+        const double q = std::sqrt(-2.0 * std::log(p));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+            / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    } else if (p <= 1.0 - LOW) {
+        const double q = p - 0.5;
+        const double t = q * q;
+        x = (((((a[0] * t + a[1]) * t + a[2]) * t + a[3]) * t + a[4]) * t + a[5]) * q
+            / (((((b[0] * t + b[1]) * t + b[2]) * t + b[3]) * t + b[4]) * t + 1.0);
+    } else {
+        const double q = std::sqrt(-2.0 * std::log(1.0 - p));
+        x = -(((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5])
+            / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+    }
+
+    const double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+    constexpr double SQRT_2PI = 2.5066282746310002;
+    const double u = e * SQRT_2PI * std::exp(0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+void SobolNormalGenerator::fill(std::uint64_t stream, std::uint64_t firstDraw, std::span<double> out) const {
+    // each stream gets its own scramble
+    const std::array<std::uint32_t, 4> bits = PhiloxNormalGenerator::philox(
+            {0, 0, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)},
+            {static_cast<std::uint32_t>(seed_), static_cast<std::uint32_t>(seed_ >> 32)});
+
+    for (std::size_t i = 0; i < out.size(); ++i) {
+        const auto index = static_cast<std::uint32_t>(firstDraw + i);
+        out[i] = inverseNormalCDF(toUniform(point(index, bits[0])));
+    }
+}
+
+void MersenneNormalGenerator::fill(std::uint64_t /*stream*/, std::uint64_t /*firstDraw*/, std::span<double> out) const {
+    static thread_local std::mt19937 gen = [](){
+        std::random_device rd;
+        auto now = std::chrono::high_resolution_clock::now();
+        std::seed_seq ss{
+                static_cast<unsigned long long>(rd()),
+                static_cast<unsigned long long>(now.time_since_epoch().count()),
+                static_cast<unsigned long long>(std::hash<std::thread::id>{}(std::this_thread::get_id()))
+        };
+        return std::mt19937(ss);
+    }();
+
+    std::normal_distribution<> d(0, 1);
+    for (double& z : out) z = d(gen);
+}
@@ -0,0 +1,252 @@
+#include "Headers/RiskGrid.h"
+#include "Headers/BlackScholes.h"
+#include "Headers/Global.h"
+#include "Headers/PricingKernel.h"
+#include "Headers/Simd.h"
+#include "Headers/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t NEW = SIZE_MAX;
+constexpr double MIN_VOL = 1e-4;
+
+// Index of each new axis point on the current axis, NEW when it is not there
+std::vector<std::size_t> matchAxis(const std::vector<double>& current, const std::vector<double>& fresh) {
+    std::vector<std::size_t> map(fresh.size(), NEW);
+    for (std::size_t i = 0; i < fresh.size(); ++i) {
+        auto it = std::find(current.begin(), current.end(), fresh[i]);
+        if (it != current.end()) map[i] = static_cast<std::size_t>(it - current.begin());
+    }
+    return map;
+}
+
+std::vector<std::size_t> identity(std::size_t n) {
+    std::vector<std::size_t> map(n);
+    for (std::size_t i = 0; i < n; ++i) map[i] = i;
+    return map;
+}
+
+// Working rows of one tile: the gathered spots and the running sums over legs
+struct TileRows {
+    std::vector<double> spots, logMoneyness, vols;
+    std::vector<double> value, delta, gamma, theta, vega;
+
+    void reset(std::size_t n) {
+        for (std::vector<double>* row : {&spots, &logMoneyness, &vols}) row->resize(n);
+        for (std::vector<double>* row : {&value, &delta, &gamma, &theta, &vega}) row->assign(n, 0.0);
+    }
+};
+
+// Adds quantity x one live leg's value and Greeks to lanes [j, j + width) of the tile.
+// log(S/K), sqrt(T) and K e^(-rT) come precomputed from the axes.
+template <class V>
+void addLeg(TileRows& rows, std::size_t j, bool isCall, double quantity, double T, double sqrtT, double discountedK, double r) {
+    constexpr unsigned mask = greek::Premium | greek::Delta | greek::Gamma | greek::Theta | greek::Vega;
+    const V S = V::load(&rows.spots[j]);
+    const V sigma = V::load(&rows.vols[j]);
+    const V sqrtTs = V::broadcast(sqrtT);
+    const V callLanes = V::broadcast(isCall ? 1.0 : 0.0);
+    const GreeksOf<V> g = blackScholesKernel<mask>(callLanes > V::broadcast(0.5), S, V::load(&rows.logMoneyness[j]), V::broadcast(T), sqrtTs,
+                                                   V::broadcast(r), sigma, sigma * sqrtTs, V::broadcast(discountedK));
+
+    const V q = V::broadcast(quantity);
+    (V::load(&rows.value[j]) + q * g.premium).store(&rows.value[j]);
+    (V::load(&rows.delta[j]) + q * g.delta).store(&rows.delta[j]);
+    (V::load(&rows.gamma[j]) + q * g.gamma).store(&rows.gamma[j]);
+    (V::load(&rows.theta[j]) + q * g.theta).store(&rows.theta[j]);
+    (V::load(&rows.vega[j]) + q * g.vega).store(&rows.vega[j]);
+}
+
+}
+
+RiskGrid::RiskGrid(Strategy strategy, double spot, double r, const IVolatilitySurface& volSurface, RiskGridAxes axes, ThreadPool* pool)
+    : strategy_(std::move(strategy)), spot_(spot), r_(r), volSurface_(volSurface), pool_(pool) {
+    if (spot <= 0) throw std::invalid_argument("ERROR: Spot must be positive");
+    if (strategy_.getLegs().empty()) throw std::invalid_argument("ERROR: Strategy has no legs: " + strategy_.getName());
+    for (const StrategyLeg& leg : strategy_.getLegs()) {
+        std::optional<Greeks> g = BlackScholes::calculate(leg.option.getStrike(), leg.option.getTimeToExpiry(), leg.option.getType(), spot, r, volSurface);
+        if (!g) throw std::runtime_error("Error pricing leg of " + strategy_.getName());
+        entryCost_ += g->premium * leg.quantity;
+    }
+    const std::vector<std::size_t> dayMap(axes.daysForward.size(), NEW), volMap(axes.volShifts.size(), NEW), spotMap(axes.spotShocks.size(), NEW);
+    rebuild(std::move(axes), dayMap, volMap, spotMap);
+}
+
+std::size_t RiskGrid::setSpotShocks(std::vector<double> spotShocks) {
+    RiskGridAxes axes = axes_;
+    std::vector<std::size_t> spotMap = matchAxis(axes_.spotShocks, spotShocks);
+    axes.spotShocks = std::move(spotShocks);
+    return rebuild(std::move(axes), identity(axes_.daysForward.size()), identity(axes_.volShifts.size()), spotMap);
+}
+
+std::size_t RiskGrid::setVolShifts(std::vector<double> volShifts) {
+    RiskGridAxes axes = axes_;
+    std::vector<std::size_t> volMap = matchAxis(axes_.volShifts, volShifts);
+    axes.volShifts = std::move(volShifts);
+    return rebuild(std::move(axes), identity(axes_.daysForward.size()), volMap, identity(axes_.spotShocks.size()));
+}
+
+std::size_t RiskGrid::setDaysForward(std::vector<double> daysForward) {
+    RiskGridAxes axes = axes_;
+    std::vector<std::size_t> dayMap = matchAxis(axes_.daysForward, daysForward);
+    axes.daysForward = std::move(daysForward);
+    return rebuild(std::move(axes), dayMap, identity(axes_.volShifts.size()), identity(axes_.spotShocks.size()));
+}
+
+RiskCell RiskGrid::at(std::size_t day, std::size_t vol, std::size_t spot) const {
+    if (day >= axes_.daysForward.size() || vol >= axes_.volShifts.size() || spot >= axes_.spotShocks.size())
+        throw std::out_of_range("ERROR: Grid point out of range");
+    const std::size_t i = index(day, vol, spot);
+    return {pnl_[i], delta_[i], gamma_[i], theta_[i], vega_[i]};
+}
+
+std::size_t RiskGrid::rebuild(RiskGridAxes axes, const std::vector<std::size_t>& dayMap,
+                              const std::vector<std::size_t>& volMap, const std::vector<std::size_t>& spotMap) {
+    for (double shock : axes.spotShocks)
+        if (!(1.0 + shock > 0.0)) throw std::invalid_argument("ERROR: Spot shocks must leave the spot positive");
+    for (double days : axes.daysForward)
+        if (!(days >= 0.0)) throw std::invalid_argument("ERROR: Days forward must be non-negative");
+
+    const std::vector<StrategyLeg>& legs = strategy_.getLegs();
+    const std::size_t L = legs.size();
+    const std::size_t D = axes.daysForward.size(), V = axes.volShifts.size(), P = axes.spotShocks.size();
+    const std::size_t oldV = axes_.volShifts.size(), oldP = axes_.spotShocks.size();
+    ThreadPool& pool = pool_ ? *pool_ : ThreadPool::shared();
+
+    // spot axis: spots and log-moneyness
+    std::vector<double> spots(P), logMoneyness(L * P);
+    for (std::size_t p = 0; p < P; ++p) {
+        const std::size_t old = spotMap[p];
+        spots[p] = old != NEW ? spots_[old] : spot_ * (1.0 + axes.spotShocks[p]);
+        for (std::size_t l = 0; l < L; ++l)
+            logMoneyness[l * P + p] = old != NEW ? logMoneyness_[l * oldP + old] : std::log(spots[p] / legs[l].option.getStrike());
+    }
+
+    // day axis: remaining time, its root and the discounted strike
+    std::vector<LegDay> legDays(D * L);
+    for (std::size_t d = 0; d < D; ++d)
+        for (std::size_t l = 0; l < L; ++l) {
+            if (dayMap[d] != NEW) {
+                legDays[d * L + l] = legDays_[dayMap[d] * L + l];
+                continue;
+            }
+            const double T = legs[l].option.getTimeToExpiry() - axes.daysForward[d] / gbl::TRADING_DAYS;
+            legDays[d * L + l] = {T, T > 0.0 ? std::sqrt(T) : 0.0, legs[l].option.getStrike() * std::exp(-r_ * std::max(T, 0.0))};
+        }
+
+    // surface vols per day, leg and spot; only new (day, spot) pairs are looked up
+    std::vector<double> baseVols(D * L * P);
+    pool.parallelFor(D, [&](std::size_t d) {
+        std::vector<double> lookupSpots, lookupVols;
+        std::vector<std::size_t> lookupAt;
+        for (std::size_t l = 0; l < L; ++l) {
+            double* row = &baseVols[(d * L + l) * P];
+            lookupSpots.clear();
+            lookupAt.clear();
+            for (std::size_t p = 0; p < P; ++p) {
+                if (dayMap[d] != NEW && spotMap[p] != NEW) {
+                    row[p] = baseVols_[(dayMap[d] * L + l) * oldP + spotMap[p]];
+                } else {
+                    lookupSpots.push_back(spots[p]);
+                    lookupAt.push_back(p);
+                }
+            }
+            const LegDay& legDay = legDays[d * L + l];
+            if (lookupAt.empty() || legDay.T <= 0.0) continue;
+            lookupVols.resize(lookupAt.size());
+            volSurface_.getPathVols(legs[l].option.getStrike(), legDay.T, lookupSpots, lookupVols);
+            for (std::size_t k = 0; k < lookupAt.size(); ++k) row[lookupAt[k]] = lookupVols[k];
+        }
+    });
+
+    // the cube: mapped cells move over, tiles recompute the rest of each (day, vol) row
+    std::vector<double> pnl(D * V * P), delta(D * V * P), gamma(D * V * P), theta(D * V * P), vega(D * V * P);
+    struct Tile {
+        std::size_t day, vol;
+        std::vector<std::size_t> columns;
+    };
+    std::vector<Tile> tiles;
+    std::vector<std::size_t> allColumns = identity(P), newColumns;
+    for (std::size_t p = 0; p < P; ++p)
+        if (spotMap[p] == NEW) newColumns.push_back(p);
+
+    std::size_t computed = 0;
+    for (std::size_t d = 0; d < D; ++d)
+        for (std::size_t v = 0; v < V; ++v) {
+            const bool rowIsNew = dayMap[d] == NEW || volMap[v] == NEW;
+            if (!rowIsNew) {
+                for (std::size_t p = 0; p < P; ++p) {
+                    if (spotMap[p] == NEW) continue;
+                    const std::size_t from = (dayMap[d] * oldV + volMap[v]) * oldP + spotMap[p], to = (d * V + v) * P + p;
+                    pnl[to] = pnl_[from];
+                    delta[to] = delta_[from];
+                    gamma[to] = gamma_[from];
+                    theta[to] = theta_[from];
+                    vega[to] = vega_[from];
+                }
+            }
+            const std::vector<std::size_t>& columns = rowIsNew ? allColumns : newColumns;
+            if (columns.empty()) continue;
+            tiles.push_back({d, v, columns});
+            computed += columns.size();
+        }
+
+    pool.parallelFor(tiles.size(), [&](std::size_t t) {
+        thread_local TileRows rows;
+        const Tile& tile = tiles[t];
+        const std::size_t n = tile.columns.size();
+        const double shift = axes.volShifts[tile.vol];
+        rows.reset(n);
+        for (std::size_t j = 0; j < n; ++j) rows.spots[j] = spots[tile.columns[j]];
+
+        for (std::size_t l = 0; l < L; ++l) {
+            const LegDay& legDay = legDays[tile.day * L + l];
+            const bool isCall = legs[l].option.getType() == OptionType::Call;
+            const double quantity = legs[l].quantity;
+            if (legDay.T <= 0.0) {
+                const double K = legs[l].option.getStrike();
+                for (std::size_t j = 0; j < n; ++j) {
+                    const double S = rows.spots[j];
+                    rows.value[j] += quantity * (isCall ? std::max(S - K, 0.0) : std::max(K - S, 0.0));
+                    rows.delta[j] += quantity * (isCall ? (S > K ? 1.0 : 0.0) : (S < K ? -1.0 : 0.0));
+                }
+                continue;
+            }
+            const double* vols = &baseVols[(tile.day * L + l) * P];
+            for (std::size_t j = 0; j < n; ++j) {
+                rows.logMoneyness[j] = logMoneyness[l * P + tile.columns[j]];
+                rows.vols[j] = std::max(vols[tile.columns[j]] + shift, MIN_VOL);
+            }
+            std::size_t j = 0;
+            for (; j + simd::NativeD::width <= n; j += simd::NativeD::width)
+                addLeg<simd::NativeD>(rows, j, isCall, quantity, legDay.T, legDay.sqrtT, legDay.discountedK, r_);
+            for (; j < n; ++j)
+                addLeg<simd::ScalarD>(rows, j, isCall, quantity, legDay.T, legDay.sqrtT, legDay.discountedK, r_);
+        }
+
+        for (std::size_t j = 0; j < n; ++j) {
+            const std::size_t to = (tile.day * V + tile.vol) * P + tile.columns[j];
+            pnl[to] = rows.value[j] - entryCost_;
+            delta[to] = rows.delta[j];
+            gamma[to] = rows.gamma[j];
+            theta[to] = rows.theta[j];
+            vega[to] = rows.vega[j];
+        }
+    });
+
+    axes_ = std::move(axes);
+    spots_ = std::move(spots);
+    logMoneyness_ = std::move(logMoneyness);
+    legDays_ = std::move(legDays);
+    baseVols_ = std::move(baseVols);
+    pnl_ = std::move(pnl);
+    delta_ = std::move(delta);
+    gamma_ = std::move(gamma);
+    theta_ = std::move(theta);
+    vega_ = std::move(vega);
+    return computed;
+}
@@ -0,0 +1,295 @@
+#include "Headers/ScenarioRunner.h"
+#include "Headers/CsvRecords.h"
+#include "Headers/BlackScholes.h"
+#include "Headers/Global.h"
+#include "Headers/ThreadPool.h"
+#include "Headers/VolatilitySurface.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+using Fields = std::vector<std::pair<std::string, std::string>>;
+
+constexpr double DEFAULT_ATM_VOL = 0.30;
+
+// One flat JSON object: string, number, boolean or null values
+Fields parseJsonObject(const std::string& line) {
+    Fields fields;
+    std::size_t at = 0;
+    auto skipSpace = [&] { while (at < line.size() && std::isspace(static_cast<unsigned char>(line[at]))) ++at; };
+    auto expect = [&](char c) {
+        skipSpace();
+        if (at >= line.size() || line[at] != c) throw std::invalid_argument(std::string("ERROR: Expected '") + c + "' in JSON record");
+        ++at;
+    };
+    auto readString = [&] {
+        expect('"');
+        std::string text;
+        while (at < line.size() && line[at] != '"') {
+            if (line[at] == '\\' && at + 1 < line.size()) ++at;
+            text += line[at++];
+        }
+        expect('"');
+        return text;
+    };
+
+    expect('{');
+    skipSpace();
+    if (at < line.size() && line[at] == '}') return fields;
+    while (true) {
+        std::string key = readString();
+        expect(':');
+        skipSpace();
+        std::string value;
+        if (at < line.size() && line[at] == '"') {
+            value = readString();
+        } else {
+            const std::size_t end = line.find_first_of(",}", at);
+            if (end == std::string::npos) throw std::invalid_argument("ERROR: Unterminated JSON record");
+            value = csv::trim(std::string_view(line).substr(at, end - at));
+            at = end;
+            if (value == "null") value.clear();
+        }
+        fields.emplace_back(std::move(key), std::move(value));
+        skipSpace();
+        if (at < line.size() && line[at] == ',') {
+            ++at;
+            continue;
+        }
+        expect('}');
+        return fields;
+    }
+}
+
+const std::string* find(const Fields& fields, std::string_view key) {
+    for (const auto& [name, value] : fields)
+        if (name == key && !value.empty()) return &value;
+    return nullptr;
+}
+
+double toNumber(const std::string& text, std::string_view key) {
+    std::size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != text.size()) throw std::invalid_argument("ERROR: " + std::string(key) + " is not a number: " + text);
+    return value;
+}
+
+Scenario toScenario(const Fields& fields, std::size_t recordNumber) {
+    auto required = [&](std::string_view key) {
+        const std::string* text = find(fields, key);
+        if (!text) throw std::invalid_argument("ERROR: Missing " + std::string(key));
+        return toNumber(*text, key);
+    };
+    auto optional = [&](std::string_view key) -> std::optional<double> {
+        const std::string* text = find(fields, key);
+        if (!text) return std::nullopt;
+        return toNumber(*text, key);
+    };
+
+    Scenario scenario{};
+    const std::string* id = find(fields, "id");
+    scenario.id = id ? *id : std::to_string(recordNumber);
+    scenario.spot = required("spot");
+    scenario.target = required("target");
+    scenario.targetDays = required("targetDays");
+    scenario.expiryDays = required("expiryDays");
+    scenario.expectedReturn = optional("expectedReturn").value_or(scenario.expectedReturn);
+    scenario.marketPrice = optional("marketPrice");
+    scenario.atmVol = optional("vol");
+    scenario.slope = optional("slope").value_or(scenario.slope);
+    scenario.convexity = optional("convexity").value_or(scenario.convexity);
+    scenario.rate = optional("rate").value_or(scenario.rate);
+    return scenario;
+}
+
+std::vector<result> evaluateAt(const Scenario& scenario, double vol, const SimulationOptions& options) {
+    if (scenario.spot <= 0 || scenario.target <= 0) throw std::invalid_argument("ERROR: spot and target must be positive");
+    if (scenario.targetDays < 0 || scenario.expiryDays <= 0) throw std::invalid_argument("ERROR: targetDays must be non-negative and expiryDays positive");
+    if (scenario.expiryDays < scenario.targetDays) throw std::invalid_argument("ERROR: Option cannot expire before the target date");
+
+    ParametricVolatility volModel(vol, scenario.slope, scenario.convexity);
+    return OptionWizard::simulateStrategies(ScenarioRunner::strategies(scenario.spot, scenario.expiryDays), scenario.spot, scenario.target,
+                                            scenario.targetDays, scenario.rate, volModel, scenario.expectedReturn, vol, options);
+}
+
+// JSON string literal; control characters are escaped so a record stays on one valid line
+std::string quoted(std::string_view text) {
+    std::string out = "\"";
+    for (char c : text) {
+        switch (c) {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(static_cast<unsigned char>(c)));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    return out + "\"";
+}
+
+std::string csvCell(std::string_view text) {
+    if (text.find_first_of(",\"") == std::string_view::npos) return std::string(text);
+    std::string out = "\"";
+    for (char c : text) out += (c == '"') ? std::string("\"\"") : std::string(1, c);
+    return out + "\"";
+}
+
+std::string number(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.10g", value);
+    return buffer;
+}
+
+constexpr const char* CSV_HEADER = "scenario,strategy,entryCost,projectedValue,expectedValue,expectedValueStdError,"
+                                   "profitPercent,pop,popStdError,delta,gamma,theta,vega,atmVol,paths,error\n";
+
+std::string render(const std::string& id, const std::vector<result>& results, double vol, RecordFormat format) {
+    std::string out;
+    for (const result& res : results) {
+        const double values[] = {res.entryCost, res.projectedValue, res.expectedValue, res.expectedValueStdError, res.profitPercent,
+                                 res.pop, res.popStdError, res.netGreeks.delta, res.netGreeks.gamma, res.netGreeks.theta,
+                                 res.netGreeks.vega, vol};
+        if (format == RecordFormat::Csv) {
+            out += csvCell(id) + "," + csvCell(res.strategyName);
+            for (double v : values) out += "," + number(v);
+            out += "," + std::to_string(res.pathsUsed) + ",\n";
+        } else {
+            static constexpr const char* keys[] = {"entryCost", "projectedValue", "expectedValue", "expectedValueStdError", "profitPercent",
+                                                   "pop", "popStdError", "delta", "gamma", "theta", "vega", "atmVol"};
+            out += "{\"scenario\": " + quoted(id) + ", \"strategy\": " + quoted(res.strategyName);
+            for (std::size_t k = 0; k < std::size(values); ++k) out += ", \"" + std::string(keys[k]) + "\": " + number(values[k]);
+            out += ", \"paths\": " + std::to_string(res.pathsUsed) + "}\n";
+        }
+    }
+    return out;
+}
+
+std::string renderError(const std::string& id, const std::string& message, RecordFormat format) {
+    if (format == RecordFormat::Csv) return csvCell(id) + ",,,,,,,,,,,,,,," + csvCell(message) + "\n";
+    return "{\"scenario\": " + quoted(id) + ", \"error\": " + quoted(message) + "}\n";
+}
+
+}
+
+std::vector<Strategy> ScenarioRunner::strategies(double spot, double expiryDays) {
+    const double T = expiryDays / gbl::TRADING_DAYS;
+    std::vector<Strategy> set;
+    // Bull
+    set.push_back(Strategy::longCall(spot, T));
+    set.push_back(Strategy::bullCallSpread(spot, spot * 1.10, T));
+    // Bear
+    set.push_back(Strategy::longPut(spot, T));
+    set.push_back(Strategy::bearPutSpread(spot, spot * 0.90, T));
+    // Volatility
+    set.push_back(Strategy::straddle(spot, T));
+    // Structure: Long 90% Put / Short 95% Put / Short 105% Call / Long 110% Call
+    set.push_back(Strategy::ironCondor(spot * 0.90, spot * 0.95, spot * 1.05, spot * 1.10, T));
+    return set;
+}
+
+double ScenarioRunner::atmVol(const Scenario& scenario) {
+    if (scenario.marketPrice) {
+        Option atmOption(scenario.spot, scenario.targetDays / gbl::TRADING_DAYS, OptionType::Call);
+        if (std::optional<double> iv = BlackScholes::calculateIV(atmOption, scenario.spot, *scenario.marketPrice, scenario.rate)) return *iv;
+    }
+    return scenario.atmVol.value_or(DEFAULT_ATM_VOL);
+}
+
+std::vector<result> ScenarioRunner::evaluate(const Scenario& scenario, const SimulationOptions& options) {
+    return evaluateAt(scenario, atmVol(scenario), options);
+}
+
+ScenarioRunSummary ScenarioRunner::run(std::istream& in, RecordFormat inFormat, std::ostream& out, RecordFormat outFormat, const ScenarioRunOptions& options) {
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::shared();
+    const std::size_t window = std::max<std::size_t>(options.window, 1);
+
+    ScenarioRunSummary summary;
+    std::vector<std::string> header;
+    std::vector<std::string> lines, rendered;
+    std::vector<std::uint8_t> failed;
+    lines.reserve(window);
+    if (outFormat == RecordFormat::Csv) out << CSV_HEADER;
+
+    std::string line;
+    while (true) {
+        lines.clear();
+        while (lines.size() < window && std::getline(in, line)) {
+            if (csv::trim(line).empty()) continue;
+            if (inFormat == RecordFormat::Csv && header.empty()) {
+                header = csv::split(line);
+                continue;
+            }
+            lines.push_back(std::move(line));
+        }
+        if (lines.empty()) break;
+
+        const std::size_t first = summary.scenarios;
+        rendered.assign(lines.size(), {});
+        failed.assign(lines.size(), 0);
+        pool.parallelFor(lines.size(), [&](std::size_t i) {
+            const std::size_t index = first + i;
+            std::string id = std::to_string(index + 1);
+            try {
+                Fields fields;
+                if (inFormat == RecordFormat::Csv) {
+                    std::vector<std::string> cells = csv::split(lines[i]);
+                    if (cells.size() != header.size()) throw std::invalid_argument("ERROR: Record has " + std::to_string(cells.size()) + " fields, header has " + std::to_string(header.size()));
+                    for (std::size_t c = 0; c < cells.size(); ++c) fields.emplace_back(header[c], std::move(cells[c]));
+                } else {
+                    fields = parseJsonObject(lines[i]);
+                }
+                if (const std::string* given = find(fields, "id")) id = *given;
+                const Scenario scenario = toScenario(fields, index + 1);
+
+                SimulationOptions simulation = options.simulation;
+                if (!simulation.pool) simulation.pool = &pool;
+                if (simulation.seed) *simulation.seed += index;
+                simulation.stats = nullptr;   // one struct cannot take concurrent scenarios
+                const double vol = atmVol(scenario);
+                rendered[i] = render(id, evaluateAt(scenario, vol, simulation), vol, outFormat);
+            } catch (const std::exception& e) {
+                rendered[i] = renderError(id, e.what(), outFormat);
+                failed[i] = 1;
+            }
+        });
+
+        for (std::size_t i = 0; i < lines.size(); ++i) {
+            out << rendered[i];
+            summary.failed += failed[i];
+        }
+        out.flush();
+        summary.scenarios += lines.size();
+    }
+    return summary;
+}
+
+RecordFormat ScenarioRunner::formatOf(const std::string& path) {
+    const std::size_t dot = path.find_last_of('.');
+    const std::string extension = dot == std::string::npos ? std::string() : path.substr(dot + 1);
+    if (extension == "jsonl" || extension == "json" || extension == "ndjson") return RecordFormat::Jsonl;
+    return RecordFormat::Csv;
+}
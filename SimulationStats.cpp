@@ -0,0 +1,73 @@
+#include "Headers/SimulationStats.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+std::string number(double value) {
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%.9g", value);
+    return buffer;
+}
+
+}
+
+double SimulationStats::pathsPerSecond() const {
+    return wallSeconds > 0.0 ? static_cast<double>(paths) / wallSeconds : 0.0;
+}
+
+double SimulationStats::imbalance() const {
+    if (threads.empty()) return 1.0;
+    double total = 0.0, slowest = 0.0;
+    for (const SimulationThreadStats& t : threads) {
+        total += t.busySeconds;
+        slowest = std::max(slowest, t.busySeconds);
+    }
+    return total > 0.0 ? slowest * static_cast<double>(threads.size()) / total : 1.0;
+}
+
+std::string SimulationStats::toJson() const {
+    std::string out = "{\"instrumented\": " + std::string(instrumented ? "true" : "false")
+                      + ", \"wallSeconds\": " + number(wallSeconds)
+                      + ", \"phases\": {\"setup\": " + number(setupSeconds) + ", \"draws\": " + number(drawSeconds)
+                      + ", \"valuation\": " + number(valuationSeconds) + ", \"reduction\": " + number(reductionSeconds) + "}"
+                      + ", \"paths\": " + std::to_string(paths) + ", \"pathsPerSecond\": " + number(pathsPerSecond())
+                      + ", \"rounds\": " + std::to_string(rounds) + ", \"imbalance\": " + number(imbalance()) + ", \"threads\": [";
+    for (std::size_t i = 0; i < threads.size(); ++i) {
+        const SimulationThreadStats& t = threads[i];
+        out += (i ? ", " : "") + std::string("{\"worker\": ") + std::to_string(t.worker) + ", \"blocks\": " + std::to_string(t.blocks)
+               + ", \"paths\": " + std::to_string(t.paths) + ", \"busySeconds\": " + number(t.busySeconds) + "}";
+    }
+    return out + "]}";
+}
+
+std::string SimulationStats::toPrometheus(std::string_view prefix) const {
+    const std::string p(prefix);
+    std::string out;
+    auto family = [&](const std::string& name, const char* help) {
+        out += "# HELP " + p + "_" + name + " " + help + "\n# TYPE " + p + "_" + name + " gauge\n";
+    };
+    auto sample = [&](const std::string& name, const std::string& labels, double value) {
+        out += p + "_" + name + (labels.empty() ? "" : "{" + labels + "}") + " " + number(value) + "\n";
+    };
+
+    family("wall_seconds", "Wall time of the last simulation");
+    sample("wall_seconds", "", wallSeconds);
+    family("phase_seconds", "Time per phase; draws and valuation are summed over threads");
+    sample("phase_seconds", "phase=\"setup\"", setupSeconds);
+    sample("phase_seconds", "phase=\"draws\"", drawSeconds);
+    sample("phase_seconds", "phase=\"valuation\"", valuationSeconds);
+    sample("phase_seconds", "phase=\"reduction\"", reductionSeconds);
+    family("paths", "Paths simulated");
+    sample("paths", "", static_cast<double>(paths));
+    family("paths_per_second", "Paths over wall time");
+    sample("paths_per_second", "", pathsPerSecond());
+    family("imbalance", "Slowest thread's busy time over the mean");
+    sample("imbalance", "", imbalance());
+
+    family("thread_paths", "Paths simulated per thread");
+    for (const SimulationThreadStats& t : threads) sample("thread_paths", "worker=\"" + std::to_string(t.worker) + "\"", static_cast<double>(t.paths));
+    family("thread_busy_seconds", "Time each thread spent simulating blocks");
+    for (const SimulationThreadStats& t : threads) sample("thread_busy_seconds", "worker=\"" + std::to_string(t.worker) + "\"", t.busySeconds);
+    return out;
+}
@@ -80,4 +80,13 @@ Strategy Strategy::ironCondor(double K_put_long, double K_put_short, double K_ca
     s.addLeg(Option(K_call_long, T, OptionType::Call), 1);
 
     return s;
-}
\ No newline at end of file
+}
+
+Strategy Strategy::calendarSpread(double K, double T_near, double T_far, OptionType type) {
+    if (T_near >= T_far) throw std::invalid_argument("ERROR: calendarSpread");
+
+    Strategy s(type == OptionType::Call ? "Call Calendar" : "Put Calendar");
+    s.addLeg(Option(K, T_near, type), -1);
+    s.addLeg(Option(K, T_far, type), 1);
+    return s;
+}
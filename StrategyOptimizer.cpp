@@ -0,0 +1,363 @@
+#include "Headers/StrategyOptimizer.h"
+#include "Headers/BlackScholes.h"
+#include "Headers/Global.h"
+#include "Headers/ThreadPool.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+constexpr double INF = std::numeric_limits<double>::infinity();
+constexpr std::size_t SCREEN_CHUNK = 32;   // candidates per analytic simulateStrategies call
+
+struct Candidate {
+    StrategyShape shape;
+    std::uint16_t expiry;       // near expiry for calendars
+    std::uint16_t farExpiry;
+    std::uint16_t strikes[4];   // ascending
+    double cost;
+    double maxLoss;
+    double maxGain;
+    double bound;
+};
+
+struct LegRef {
+    std::uint16_t strike;
+    std::uint16_t expiry;
+    OptionType type;
+    int quantity;
+};
+
+// The legs of a candidate as the Strategy factories lay them out
+std::size_t legsOf(const Candidate& c, LegRef (&legs)[4]) {
+    const std::uint16_t* k = c.strikes;
+    switch (c.shape) {
+        case StrategyShape::BullCallSpread:
+            legs[0] = {k[0], c.expiry, OptionType::Call, 1};
+            legs[1] = {k[1], c.expiry, OptionType::Call, -1};
+            return 2;
+        case StrategyShape::BearPutSpread:
+            legs[0] = {k[1], c.expiry, OptionType::Put, 1};
+            legs[1] = {k[0], c.expiry, OptionType::Put, -1};
+            return 2;
+        case StrategyShape::Straddle:
+            legs[0] = {k[0], c.expiry, OptionType::Call, 1};
+            legs[1] = {k[0], c.expiry, OptionType::Put, 1};
+            return 2;
+        case StrategyShape::Strangle:
+            legs[0] = {k[0], c.expiry, OptionType::Put, 1};
+            legs[1] = {k[1], c.expiry, OptionType::Call, 1};
+            return 2;
+        case StrategyShape::IronCondor:
+            legs[0] = {k[1], c.expiry, OptionType::Put, -1};
+            legs[1] = {k[0], c.expiry, OptionType::Put, 1};
+            legs[2] = {k[2], c.expiry, OptionType::Call, -1};
+            legs[3] = {k[3], c.expiry, OptionType::Call, 1};
+            return 4;
+        case StrategyShape::CallCalendar:
+        case StrategyShape::PutCalendar: {
+            const OptionType type = c.shape == StrategyShape::CallCalendar ? OptionType::Call : OptionType::Put;
+            legs[0] = {k[0], c.expiry, type, -1};
+            legs[1] = {k[0], c.farExpiry, type, 1};
+            return 2;
+        }
+    }
+    return 0;
+}
+
+struct Grid {
+    std::vector<double> strikes;
+    std::vector<double> expiryDays;
+    std::vector<double> premiums;   // [expiry][strike][call, put], NaN where pricing failed
+
+    [[nodiscard]] double expiry(std::size_t e) const { return expiryDays[e] / gbl::TRADING_DAYS; }
+    [[nodiscard]] double premium(const LegRef& leg) const {
+        return premiums[(leg.expiry * strikes.size() + leg.strike) * 2 + (leg.type == OptionType::Call ? 0 : 1)];
+    }
+};
+
+Strategy toStrategy(const Candidate& c, const Grid& grid) {
+    const double T = grid.expiry(c.expiry);
+    double K[4];
+    for (int i = 0; i < 4; ++i) K[i] = grid.strikes[c.strikes[i]];
+    switch (c.shape) {
+        case StrategyShape::BullCallSpread: return Strategy::bullCallSpread(K[0], K[1], T);
+        case StrategyShape::BearPutSpread: return Strategy::bearPutSpread(K[1], K[0], T);
+        case StrategyShape::Straddle: return Strategy::straddle(K[0], T);
+        case StrategyShape::Strangle: return Strategy::strangle(K[0], K[1], T);
+        case StrategyShape::IronCondor: return Strategy::ironCondor(K[0], K[1], K[2], K[3], T);
+        case StrategyShape::CallCalendar: return Strategy::calendarSpread(K[0], T, grid.expiry(c.farExpiry), OptionType::Call);
+        case StrategyShape::PutCalendar: return Strategy::calendarSpread(K[0], T, grid.expiry(c.farExpiry), OptionType::Put);
+    }
+    throw std::invalid_argument("ERROR: Unknown strategy shape");
+}
+
+// The strategy under a name that spells out its strikes and expiries
+Strategy labelled(const Candidate& c, const Grid& grid) {
+    Strategy plain = toStrategy(c, grid);
+    LegRef legs[4];
+    const std::size_t count = legsOf(c, legs);
+    std::string label = plain.getName();
+    std::vector<std::uint16_t> strikes;
+    for (std::size_t i = 0; i < count; ++i) strikes.push_back(legs[i].strike);
+    std::sort(strikes.begin(), strikes.end());
+    strikes.erase(std::unique(strikes.begin(), strikes.end()), strikes.end());
+    char number[32];
+    for (std::size_t i = 0; i < strikes.size(); ++i) {
+        std::snprintf(number, sizeof(number), "%g", grid.strikes[strikes[i]]);
+        label += (i == 0 ? " " : "/") + std::string(number);
+    }
+    std::snprintf(number, sizeof(number), " %gd", grid.expiryDays[c.expiry]);
+    label += number;
+    if (c.shape == StrategyShape::CallCalendar || c.shape == StrategyShape::PutCalendar) {
+        std::snprintf(number, sizeof(number), "/%gd", grid.expiryDays[c.farExpiry]);
+        label += number;
+    }
+    Strategy named(label);
+    for (const StrategyLeg& leg : plain.getLegs()) named.addLeg(leg.option, leg.quantity);
+    return named;
+}
+
+// Lowest and highest value at expiry of legs sharing one expiry: piecewise linear with kinks
+// at the strikes, so the extremes are at zero, a strike or out along the call wing
+std::pair<double, double> payoffRange(const LegRef* legs, std::size_t count, const Grid& grid) {
+    auto payoff = [&](double S) {
+        double value = 0.0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const double K = grid.strikes[legs[i].strike];
+            value += legs[i].quantity * (legs[i].type == OptionType::Call ? std::max(S - K, 0.0) : std::max(K - S, 0.0));
+        }
+        return value;
+    };
+    double low = payoff(0.0), high = low;
+    int slope = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double value = payoff(grid.strikes[legs[i].strike]);
+        low = std::min(low, value);
+        high = std::max(high, value);
+        if (legs[i].type == OptionType::Call) slope += legs[i].quantity;
+    }
+    if (slope > 0) high = INF;
+    if (slope < 0) low = -INF;
+    return {low, high};
+}
+
+// result and CompactResult share the fields a score reads
+template <class Evaluation>
+std::optional<double> scoreOf(RankBy rankBy, const Evaluation& evaluation, double maxLoss) {
+    const double expectedPnl = evaluation.expectedValue - evaluation.entryCost;
+    switch (rankBy) {
+        case RankBy::ExpectedValue: return expectedPnl;
+        case RankBy::Pop: return evaluation.pop;
+        case RankBy::ReturnOnRisk:
+            if (!(maxLoss > 0.0) || std::isinf(maxLoss)) return std::nullopt;
+            return expectedPnl / maxLoss;
+    }
+    return std::nullopt;
+}
+
+}
+
+std::optional<double> StrategyOptimizer::score(RankBy rankBy, const result& evaluation, double maxLoss) {
+    return scoreOf(rankBy, evaluation, maxLoss);
+}
+
+std::optional<double> StrategyOptimizer::score(RankBy rankBy, const CompactResult& evaluation, double maxLoss) {
+    return scoreOf(rankBy, evaluation, maxLoss);
+}
+
+OptimizerSummary StrategyOptimizer::search(const StrategySearchSpace& space, double spot, double target, double targetDays, double r,
+                                           const IVolatilitySurface& volSurface, double mu, double sigma, const OptimizerOptions& options) {
+    if (spot <= 0 || target <= 0) throw std::invalid_argument("ERROR: spot and target must be positive");
+    if (targetDays < 0) throw std::invalid_argument("ERROR: targetDays must be non-negative");
+
+    Grid grid;
+    grid.strikes = space.strikes;
+    std::sort(grid.strikes.begin(), grid.strikes.end());
+    grid.strikes.erase(std::unique(grid.strikes.begin(), grid.strikes.end()), grid.strikes.end());
+    for (double days : space.expiryDays)
+        if (days >= targetDays && days > 0) grid.expiryDays.push_back(days);
+    std::sort(grid.expiryDays.begin(), grid.expiryDays.end());
+    grid.expiryDays.erase(std::unique(grid.expiryDays.begin(), grid.expiryDays.end()), grid.expiryDays.end());
+    if (grid.strikes.size() > UINT16_MAX || grid.expiryDays.size() > UINT16_MAX) throw std::invalid_argument("ERROR: Search grid too large");
+    for (double K : grid.strikes)
+        if (!(K > 0)) throw std::invalid_argument("ERROR: Strikes must be positive");
+
+    OptimizerSummary summary;
+    const std::size_t S = grid.strikes.size(), E = grid.expiryDays.size();
+    if (S == 0 || E == 0) return summary;
+
+    // stage 1: every grid premium in one batch
+    {
+        const std::size_t n = E * S * 2;
+        std::vector<double> strikes(n), expiries(n), spots(n, spot), rates(n, r), vols(n);
+        std::vector<OptionType> types(n);
+        std::vector<std::uint8_t> valid(n);
+        for (std::size_t e = 0; e < E; ++e)
+            for (std::size_t k = 0; k < S; ++k)
+                for (std::size_t t = 0; t < 2; ++t) {
+                    const std::size_t i = (e * S + k) * 2 + t;
+                    strikes[i] = grid.strikes[k];
+                    expiries[i] = grid.expiry(e);
+                    types[i] = t == 0 ? OptionType::Call : OptionType::Put;
+                }
+        volSurface.getVols(strikes, expiries, spot, vols);
+        grid.premiums.resize(n);
+        BlackScholes::calculateBatch({strikes, expiries, types, spots, rates, vols}, {.premium = grid.premiums}, valid);
+        for (std::size_t i = 0; i < n; ++i)
+            if (!valid[i]) grid.premiums[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // stage 1: enumerate, apply the constraints and bound the metric
+    std::vector<Candidate> feasible;
+    auto consider = [&](Candidate c) {
+        ++summary.candidates;
+        LegRef legs[4];
+        const std::size_t count = legsOf(c, legs);
+        c.cost = 0.0;
+        for (std::size_t i = 0; i < count; ++i) c.cost += legs[i].quantity * grid.premium(legs[i]);
+        if (std::isnan(c.cost)) return;
+
+        double low = 0.0, high = 0.0;
+        if (c.shape == StrategyShape::CallCalendar || c.shape == StrategyShape::PutCalendar) {
+            // at the near expiry: far option minus intrinsic peaks at the strike; a put calendar
+            // can end below zero by the far put's discount on the strike
+            const double K = grid.strikes[c.strikes[0]];
+            const double tau = grid.expiry(c.farExpiry) - grid.expiry(c.expiry);
+            const OptionType type = legs[1].type;
+            high = BlackScholes::calculatePremium(K, tau, type, K, r, volSurface.getVol(K, tau, K)).value_or(INF);
+            low = type == OptionType::Put ? K * (std::exp(-r * tau) - 1.0) : 0.0;
+        } else {
+            std::tie(low, high) = payoffRange(legs, count, grid);
+        }
+        c.maxGain = high - c.cost;
+        c.maxLoss = c.cost - low;
+
+        if (options.constraints.maxCost && c.cost > *options.constraints.maxCost) return;
+        if (options.constraints.maxLoss && c.maxLoss > *options.constraints.maxLoss) return;
+        switch (options.rankBy) {
+            case RankBy::ExpectedValue: c.bound = c.maxGain; break;
+            case RankBy::Pop: c.bound = c.maxGain > 0.0 ? 1.0 : 0.0; break;
+            case RankBy::ReturnOnRisk:
+                if (!(c.maxLoss > 0.0) || std::isinf(c.maxLoss)) return;
+                c.bound = c.maxGain / c.maxLoss;
+                break;
+        }
+        feasible.push_back(c);
+    };
+
+    auto withinWidth = [&](std::size_t low, std::size_t high) {
+        return space.maxWidth <= 0.0 || grid.strikes[high] - grid.strikes[low] <= space.maxWidth;
+    };
+    auto id = [](std::size_t i) { return static_cast<std::uint16_t>(i); };
+    for (StrategyShape shape : space.shapes) {
+        for (std::size_t e = 0; e < E; ++e) {
+            switch (shape) {
+                case StrategyShape::Straddle:
+                    for (std::size_t a = 0; a < S; ++a) consider({shape, id(e), id(e), {id(a), id(a), id(a), id(a)}});
+                    break;
+                case StrategyShape::BullCallSpread:
+                case StrategyShape::BearPutSpread:
+                case StrategyShape::Strangle:
+                    for (std::size_t a = 0; a < S; ++a)
+                        for (std::size_t b = a + 1; b < S && withinWidth(a, b); ++b) consider({shape, id(e), id(e), {id(a), id(b), id(b), id(b)}});
+                    break;
+                case StrategyShape::IronCondor:
+                    for (std::size_t a = 0; a < S; ++a)
+                        for (std::size_t b = a + 1; b < S; ++b)
+                            for (std::size_t c = b + 1; c < S; ++c)
+                                for (std::size_t d = c + 1; d < S && withinWidth(a, d); ++d) consider({shape, id(e), id(e), {id(a), id(b), id(c), id(d)}});
+                    break;
+                case StrategyShape::CallCalendar:
+                case StrategyShape::PutCalendar:
+                    for (std::size_t f = e + 1; f < E; ++f)
+                        for (std::size_t a = 0; a < S; ++a) consider({shape, id(e), id(f), {id(a), id(a), id(a), id(a)}});
+                    break;
+            }
+        }
+    }
+    summary.feasible = feasible.size();
+    if (feasible.empty() || options.top == 0) return summary;
+
+    // stage 2: analytic screen in order of falling bound
+    std::stable_sort(feasible.begin(), feasible.end(), [](const Candidate& a, const Candidate& b) { return a.bound > b.bound; });
+    ThreadPool& pool = options.simulation.pool ? *options.simulation.pool : ThreadPool::shared();
+    SimulationOptions screen = options.simulation;
+    screen.analytic = true;
+    screen.pool = &pool;
+    screen.stats = nullptr;
+
+    const std::size_t survivors = std::max(options.survivors, options.top);
+    const std::size_t round = SCREEN_CHUNK * 4 * std::max<std::size_t>(pool.size(), 1);
+    std::vector<double> screenScores(feasible.size(), std::numeric_limits<double>::quiet_NaN());
+    std::priority_queue<double, std::vector<double>, std::greater<>> best;   // survivors-th best on top
+    std::size_t next = 0;
+    while (next < feasible.size()) {
+        if (best.size() == survivors && best.top() >= feasible[next].bound) break;
+        const std::size_t end = std::min(next + round, feasible.size());
+        const std::size_t chunks = (end - next + SCREEN_CHUNK - 1) / SCREEN_CHUNK;
+        pool.parallelFor(chunks, [&](std::size_t chunk) {
+            const std::size_t first = next + chunk * SCREEN_CHUNK, last = std::min(first + SCREEN_CHUNK, end);
+            // compact candidates and results, two allocations per chunk rather than per candidate. They
+            // stay local: a thread waiting inside simulateStrategies may pick up another chunk.
+            StrategyBook book;
+            book.reserve(last - first);
+            for (std::size_t i = first; i < last; ++i) {
+                LegRef legs[4];
+                const std::size_t count = legsOf(feasible[i], legs);
+                CompactStrategy& strategy = book.add();
+                for (std::size_t l = 0; l < count; ++l)
+                    strategy.addLeg(Option(grid.strikes[legs[l].strike], grid.expiry(legs[l].expiry), legs[l].type), legs[l].quantity);
+            }
+            std::vector<CompactResult> results(book.size());
+            OptionWizard::simulateStrategies(book.strategies(), spot, target, targetDays, r, volSurface, mu, sigma, screen, results);
+            for (std::size_t i = first; i < last; ++i) {
+                const CompactResult& res = results[i - first];
+                std::optional<double> s = score(options.rankBy, res, feasible[i].maxLoss);
+                if (s && res.pop >= options.constraints.minPop) screenScores[i] = *s;
+            }
+        });
+        for (std::size_t i = next; i < end; ++i) {
+            if (std::isnan(screenScores[i])) continue;
+            best.push(screenScores[i]);
+            if (best.size() > survivors) best.pop();
+        }
+        next = end;
+    }
+    summary.screened = next;
+
+    // stage 3: simulate the survivors together
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < next; ++i)
+        if (!std::isnan(screenScores[i])) order.push_back(i);
+    const std::size_t kept = std::min(survivors, order.size());
+    std::partial_sort(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(kept), order.end(),
+                      [&](std::size_t a, std::size_t b) { return screenScores[a] > screenScores[b]; });
+    order.resize(kept);
+    if (order.empty()) return summary;
+
+    std::vector<Strategy> strategies;
+    strategies.reserve(order.size());
+    for (std::size_t i : order) strategies.push_back(labelled(feasible[i], grid));
+    SimulationOptions simulation = options.simulation;
+    simulation.pool = &pool;
+    std::vector<result> results = OptionWizard::simulateStrategies(strategies, spot, target, targetDays, r, volSurface, mu, sigma, simulation);
+    summary.simulated = results.size();
+
+    for (std::size_t j = 0; j < order.size(); ++j) {
+        const Candidate& c = feasible[order[j]];
+        std::optional<double> s = score(options.rankBy, results[j], c.maxLoss);
+        if (!s || results[j].pop < options.constraints.minPop) continue;
+        summary.ranked.push_back({std::move(strategies[j]), c.maxLoss, c.maxGain, screenScores[order[j]], results[j], *s});
+    }
+    std::stable_sort(summary.ranked.begin(), summary.ranked.end(), [](const RankedStrategy& a, const RankedStrategy& b) { return a.score > b.score; });
+    if (summary.ranked.size() > options.top) summary.ranked.erase(summary.ranked.begin() + static_cast<std::ptrdiff_t>(options.top), summary.ranked.end());
+    return summary;
+}
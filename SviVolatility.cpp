@@ -0,0 +1,263 @@
+#include "Headers/SviVolatility.h"
+#include "Headers/ThreadPool.h"
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+constexpr double MAX_RHO = 0.999;
+constexpr double MIN_THETA = 1e-8;
+constexpr double MIN_PSI = 1e-8;
+constexpr double SAME_EXPIRY = 1e-9;
+constexpr double WARM_EXPIRY = 1.0 / 252.0;   // previous slices within a trading day seed theta too
+constexpr double CROSSING_RANGE = 4.0;
+constexpr int CROSSING_STEPS = 800;
+
+using Params = std::array<double, 3>;   // theta, rho, psi
+
+// Projects parameters onto the butterfly-free region
+Params project(Params p) {
+    p[0] = std::max(p[0], MIN_THETA);
+    p[1] = std::clamp(p[1], -MAX_RHO, MAX_RHO);
+    const double wing = 1.0 + std::abs(p[1]);
+    const double cap = std::min(4.0 * (1.0 - 1e-9) / wing, std::sqrt(4.0 * p[0] / wing));
+    p[2] = std::clamp(p[2], MIN_PSI, cap);
+    return p;
+}
+
+// w(k) and its gradient in (theta, rho, psi)
+double totalVariance(const Params& p, double k, Params* gradient) {
+    const double theta = p[0], rho = p[1], psi = p[2];
+    const double u = psi * k / theta + rho;
+    const double R = std::sqrt(u * u + 1.0 - rho * rho);
+    if (gradient) {
+        (*gradient)[0] = 0.5 * (1.0 + R) - 0.5 * u * psi * k / (theta * R);
+        (*gradient)[1] = 0.5 * psi * k * (1.0 + 1.0 / R);
+        (*gradient)[2] = 0.5 * k * (rho + u / R);
+    }
+    return 0.5 * theta * (1.0 + R) + 0.5 * rho * psi * k;
+}
+
+// Solves the 3x3 system A x = b by Gaussian elimination with partial pivoting
+bool solve3(std::array<std::array<double, 3>, 3> A, Params b, Params& x) {
+    for (int c = 0; c < 3; ++c) {
+        int pivot = c;
+        for (int r = c + 1; r < 3; ++r)
+            if (std::abs(A[r][c]) > std::abs(A[pivot][c])) pivot = r;
+        if (!(std::abs(A[pivot][c]) > 0.0)) return false;
+        std::swap(A[c], A[pivot]);
+        std::swap(b[c], b[pivot]);
+        for (int r = c + 1; r < 3; ++r) {
+            const double f = A[r][c] / A[c][c];
+            for (int j = c; j < 3; ++j) A[r][j] -= f * A[c][j];
+            b[r] -= f * b[c];
+        }
+    }
+    for (int c = 2; c >= 0; --c) {
+        double sum = b[c];
+        for (int j = c + 1; j < 3; ++j) sum -= A[c][j] * x[j];
+        x[c] = sum / A[c][c];
+    }
+    return true;
+}
+
+struct SliceQuotes {
+    double expiry;
+    std::vector<double> k;
+    std::vector<double> vols;
+};
+
+double squaredError(const SliceQuotes& q, const Params& p) {
+    double sum = 0.0;
+    for (std::size_t j = 0; j < q.k.size(); ++j) {
+        const double r = std::sqrt(totalVariance(p, q.k[j], nullptr) / q.expiry) - q.vols[j];
+        sum += r * r;
+    }
+    return sum;
+}
+
+// Levenberg-Marquardt on the implied vol residuals sqrt(w(k)/T) - vol
+SviSliceFit fitSlice(const SliceQuotes& q, Params& p, const SviFitOptions& options) {
+    p = project(p);
+    double cost = squaredError(q, p);
+    double lambda = 1e-3;
+    int iteration = 0;
+
+    while (iteration < options.maxIterations && cost > 0.0) {
+        ++iteration;
+        std::array<std::array<double, 3>, 3> A{};
+        Params g{};
+        for (std::size_t j = 0; j < q.k.size(); ++j) {
+            Params dw{};
+            const double w = totalVariance(p, q.k[j], &dw);
+            const double vol = std::sqrt(w / q.expiry);
+            const double scale = 0.5 / (vol * q.expiry);   // d vol / d w
+            Params J{dw[0] * scale, dw[1] * scale, dw[2] * scale};
+            const double r = vol - q.vols[j];
+            for (int a = 0; a < 3; ++a) {
+                g[a] += J[a] * r;
+                for (int b = 0; b < 3; ++b) A[a][b] += J[a] * J[b];
+            }
+        }
+
+        bool improved = false;
+        double previous = cost;
+        while (lambda < 1e12) {
+            std::array<std::array<double, 3>, 3> damped = A;
+            for (int a = 0; a < 3; ++a) damped[a][a] += lambda * std::max(A[a][a], 1e-18);
+            Params step{};
+            if (solve3(damped, {-g[0], -g[1], -g[2]}, step)) {
+                const Params trial = project({p[0] + step[0], p[1] + step[1], p[2] + step[2]});
+                const double trialCost = squaredError(q, trial);
+                if (trialCost < cost) {
+                    p = trial;
+                    cost = trialCost;
+                    lambda = std::max(lambda / 3.0, 1e-12);
+                    improved = true;
+                    break;
+                }
+            }
+            lambda *= 4.0;
+        }
+        if (!improved || previous - cost <= options.tolerance * previous) break;
+    }
+
+    return {std::sqrt(cost / static_cast<double>(q.k.size())), iteration, q.k.size()};
+}
+
+// Starting point: ATM total variance read off the quotes, flat skew, moderate curvature.
+// A previous slice at (nearly) the same expiry is reused whole.
+Params initialGuess(const SliceQuotes& q, const SviVolatility* warmStart) {
+    double atm = q.vols.front();
+    auto above = std::find_if(q.k.begin(), q.k.end(), [](double k) { return k > 0.0; });
+    if (above == q.k.end()) atm = q.vols.back();
+    else if (above != q.k.begin()) {
+        const std::size_t j = static_cast<std::size_t>(above - q.k.begin());
+        atm = q.vols[j - 1] + (q.vols[j] - q.vols[j - 1]) * (0.0 - q.k[j - 1]) / (q.k[j] - q.k[j - 1]);
+    }
+    Params p{atm * atm * q.expiry, 0.0, atm * std::sqrt(q.expiry)};
+
+    if (warmStart) {
+        const std::vector<SviSlice>& previous = warmStart->slices();
+        const SviSlice& nearest = *std::min_element(previous.begin(), previous.end(), [&](const SviSlice& a, const SviSlice& b) {
+            return std::abs(a.expiry - q.expiry) < std::abs(b.expiry - q.expiry);
+        });
+        p[1] = nearest.rho;
+        p[2] = nearest.psi;
+        if (std::abs(nearest.expiry - q.expiry) <= WARM_EXPIRY) p[0] = nearest.theta * q.expiry / nearest.expiry;
+    }
+    return p;
+}
+
+}
+
+double SviSlice::totalVariance(double k) const {
+    return ::totalVariance({theta, rho, psi}, k, nullptr);
+}
+
+bool SviSlice::butterflyFree() const {
+    const double wing = 1.0 + std::abs(rho);
+    return theta > 0.0 && std::abs(rho) < 1.0 && psi > 0.0 && psi * wing < 4.0 && psi * psi * wing <= 4.0 * theta * (1.0 + 1e-12);
+}
+
+SviVolatility::SviVolatility(std::vector<SviSlice> slices) : slices_(std::move(slices)), floored_(slices_.size(), 0) {
+    if (slices_.empty()) throw std::invalid_argument("ERROR: SviVolatility needs at least one slice");
+    for (std::size_t i = 0; i < slices_.size(); ++i) {
+        const SviSlice& s = slices_[i];
+        if (!(s.expiry > 0.0) || !(s.theta > 0.0) || !(std::abs(s.rho) < 1.0) || !(s.psi > 0.0))
+            throw std::invalid_argument("ERROR: SviVolatility slice needs positive expiry, theta and psi and |rho| < 1");
+        if (i > 0 && !(s.expiry > slices_[i - 1].expiry))
+            throw std::invalid_argument("ERROR: SviVolatility slices must have increasing expiries");
+    }
+
+    for (std::size_t i = 1; i < slices_.size(); ++i) {
+        for (int step = 0; step <= CROSSING_STEPS && !floored_[i]; ++step) {
+            const double k = -CROSSING_RANGE + 2.0 * CROSSING_RANGE * step / CROSSING_STEPS;
+            floored_[i] = slices_[i].totalVariance(k) < flooredVariance(i - 1, k);
+        }
+    }
+}
+
+double SviVolatility::flooredVariance(std::size_t i, double k) const {
+    const double w = slices_[i].totalVariance(k);
+    return floored_[i] ? std::max(w, flooredVariance(i - 1, k)) : w;
+}
+
+double SviVolatility::volAt(double k, double timeToExpiry) const {
+    const SviSlice& first = slices_.front();
+    const SviSlice& last = slices_.back();
+    if (timeToExpiry <= first.expiry) return std::sqrt(flooredVariance(0, k) / first.expiry);
+    if (timeToExpiry >= last.expiry) return std::sqrt(flooredVariance(slices_.size() - 1, k) / last.expiry);
+
+    const auto upper = static_cast<std::size_t>(std::upper_bound(slices_.begin(), slices_.end(), timeToExpiry,
+        [](double t, const SviSlice& s) { return t < s.expiry; }) - slices_.begin());
+    const double t0 = slices_[upper - 1].expiry, t1 = slices_[upper].expiry;
+    const double w0 = flooredVariance(upper - 1, k), w1 = flooredVariance(upper, k);
+    const double w = w0 + (w1 - w0) * (timeToExpiry - t0) / (t1 - t0);
+    return std::sqrt(w / timeToExpiry);
+}
+
+double SviVolatility::getVol(double strike, double timeToExpiry, double spot) const {
+    const double k = (spot > 0.0 && strike > 0.0) ? std::log(strike / spot) : 0.0;
+    return volAt(k, timeToExpiry);
+}
+
+void SviVolatility::getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const {
+    if (expiries.size() != strikes.size() || out.size() != strikes.size()) throw std::invalid_argument("ERROR: volatility batch sizes differ");
+    for (std::size_t i = 0; i < strikes.size(); ++i) out[i] = SviVolatility::getVol(strikes[i], expiries[i], spot);
+}
+
+void SviVolatility::getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const {
+    if (out.size() != spots.size()) throw std::invalid_argument("ERROR: volatility batch sizes differ");
+    for (std::size_t i = 0; i < spots.size(); ++i) out[i] = SviVolatility::getVol(strike, timeToExpiry, spots[i]);
+}
+
+const std::vector<SviSlice>& SviVolatility::slices() const { return slices_; }
+
+std::size_t SviVolatility::calendarCrossings() const {
+    return static_cast<std::size_t>(std::count(floored_.begin(), floored_.end(), 1));
+}
+
+SviCalibration SviCalibrator::calibrate(const QuoteInputs& quotes, const SviVolatility* warmStart, const SviFitOptions& options) {
+    const std::size_t n = quotes.strikes.size();
+    std::vector<double> vols(n);
+    std::vector<IVStatus> status(n);
+    ImpliedVolatility::solveBatch(quotes, vols, status, options.pool);
+
+    // (expiry, log-moneyness, vol) of every converged quote, grouped into slices
+    std::vector<std::tuple<double, double, double>> solved;
+    for (std::size_t i = 0; i < n; ++i)
+        if (status[i] == IVStatus::Converged) solved.emplace_back(quotes.expiries[i], std::log(quotes.strikes[i] / quotes.spots[i]), vols[i]);
+    std::sort(solved.begin(), solved.end());
+
+    std::vector<SliceQuotes> groups;
+    for (std::size_t begin = 0; begin < solved.size();) {
+        const double T = std::get<0>(solved[begin]);
+        SliceQuotes group{T, {}, {}};
+        std::size_t end = begin;
+        for (; end < solved.size() && std::get<0>(solved[end]) - T <= SAME_EXPIRY; ++end) {
+            group.k.push_back(std::get<1>(solved[end]));
+            group.vols.push_back(std::get<2>(solved[end]));
+        }
+        if (group.k.size() >= 3) groups.push_back(std::move(group));
+        begin = end;
+    }
+    if (groups.empty()) throw std::invalid_argument("ERROR: calibrate needs an expiry with three usable quotes");
+
+    std::vector<Params> params(groups.size());
+    std::vector<SviSliceFit> fits(groups.size());
+    ThreadPool& pool = options.pool ? *options.pool : ThreadPool::shared();
+    pool.parallelFor(groups.size(), [&](std::size_t s) {
+        params[s] = initialGuess(groups[s], warmStart);
+        fits[s] = fitSlice(groups[s], params[s], options);
+    });
+
+    std::vector<SviSlice> slices;
+    for (std::size_t s = 0; s < groups.size(); ++s)
+        slices.push_back({groups[s].expiry, params[s][0], params[s][1], params[s][2]});
+    return {SviVolatility(std::move(slices)), std::move(fits)};
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runAdaptiveSimulationTest() {
+
+    double S = 100.0;
+    double T = 60.0 / gbl::TRADING_DAYS;
+    ParametricVolatility volModel(0.25, -0.2, 1.0);
+    Strategy call = Strategy::longCall(S, T);
+
+    // the reported standard error should match the spread of estimates across seeds
+    SimulationOptions fixed;
+    fixed.paths = 20000;
+    double sum = 0.0, sumSquares = 0.0, reported = 0.0;
+    const int seeds = 40;
+    for (int seed = 0; seed < seeds; ++seed) {
+        fixed.seed = seed;
+        result res = OptionWizard::simulateStrategy(call, S, S, 20.0, 0.05, volModel, 0.08, 0.25, fixed);
+        sum += res.expectedValue;
+        sumSquares += res.expectedValue * res.expectedValue;
+        reported += res.expectedValueStdError / seeds;
+    }
+    double observed = std::sqrt((sumSquares - sum * sum / seeds) / (seeds - 1));
+    bool errorCalibrated = reported > 0.7 * observed && reported < 1.4 * observed;
+
+    // adaptive runs stop once every strategy meets the target, within the budget
+    SimulationOptions adaptive;
+    adaptive.paths = 4096;
+    adaptive.targetStandardError = 0.01;
+    adaptive.maxPaths = 1000000;
+    adaptive.seed = 5;
+    std::vector<Strategy> strategies{call, Strategy::ironCondor(S * 0.90, S * 0.95, S * 1.05, S * 1.10, T)};
+    bool targetMet = true;
+    for (const Strategy& strat : strategies) {
+        result res = OptionWizard::simulateStrategy(strat, S, S, 20.0, 0.05, volModel, 0.08, 0.25, adaptive);
+        targetMet = targetMet && res.expectedValueStdError <= 0.01 && res.pathsUsed <= 1000000 && res.pathsUsed >= 4096;
+    }
+
+    // a budget too small for the target caps the run
+    adaptive.targetStandardError = 1e-6;
+    adaptive.maxPaths = 40000;
+    result capped = OptionWizard::simulateStrategy(call, S, S, 20.0, 0.05, volModel, 0.08, 0.25, adaptive);
+    bool budgetHonoured = capped.pathsUsed <= 40000 && capped.expectedValueStdError > 1e-6;
+
+    if (errorCalibrated && targetMet && budgetHonoured) {
+        std::cout << "[PASS] Adaptive simulation meets its error target within budget." << "\n";
+    } else {
+        std::cout << "[FAIL] Adaptive simulation (reported SE " << reported << " vs observed " << observed
+                  << ", target met " << targetMet << ", budget " << capped.pathsUsed << ")" << "\n";
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runAnalyticHorizonTest() {
+
+    double S = 100.0;
+    ParametricVolatility volModel(0.25, -0.2, 1.0);
+
+    SimulationOptions analytic;
+    analytic.analytic = true;
+    SimulationOptions simulated;
+    simulated.paths = 1 << 20;
+    simulated.quasiRandom = true;
+    simulated.seed = 9;
+
+    double worstEV = 0.0, worstPoP = 0.0;
+    bool deterministic = true;
+    // horizon at expiry (closed form) and 20 days before it (quadrature)
+    for (double expiryDays : {20.0, 40.0}) {
+        double T = expiryDays / gbl::TRADING_DAYS;
+        std::vector<Strategy> strategies;
+        strategies.push_back(Strategy::longCall(S, T));
+        strategies.push_back(Strategy::bullCallSpread(S, S * 1.10, T));
+        strategies.push_back(Strategy::longPut(S, T));
+        strategies.push_back(Strategy::bearPutSpread(S, S * 0.90, T));
+        strategies.push_back(Strategy::straddle(S, T));
+        strategies.push_back(Strategy::ironCondor(S * 0.90, S * 0.95, S * 1.05, S * 1.10, T));
+
+        std::vector<result> exact = OptionWizard::simulateStrategies(strategies, S, S, 20.0, 0.05, volModel, 0.08, 0.25, analytic);
+        std::vector<result> again = OptionWizard::simulateStrategies(strategies, S, S, 20.0, 0.05, volModel, 0.08, 0.25, analytic);
+        std::vector<result> mc = OptionWizard::simulateStrategies(strategies, S, S, 20.0, 0.05, volModel, 0.08, 0.25, simulated);
+        for (std::size_t i = 0; i < strategies.size(); ++i) {
+            worstEV = std::max(worstEV, std::abs(exact[i].expectedValue - mc[i].expectedValue));
+            worstPoP = std::max(worstPoP, std::abs(exact[i].pop - mc[i].pop));
+            deterministic = deterministic && exact[i].expectedValue == again[i].expectedValue
+                            && exact[i].pop == again[i].pop && exact[i].pathsUsed == 0;
+        }
+    }
+
+    if (worstEV < 1e-4 && worstPoP < 1e-4 && deterministic) {
+        std::cout << "[PASS] Analytic horizon PoP and EV match simulation." << "\n";
+    } else {
+        std::cout << "[FAIL] Analytic horizon (EV error " << worstEV << ", PoP error " << worstPoP << ")" << "\n";
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/Option.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runBatchPricingTest() {
+
+    std::vector<double> strikes, expiries, spots, rates, vols;
+    std::vector<OptionType> types;
+
+    for (double K = 40.0; K <= 200.0; K += 7.5) {
+        for (double T : {0.004, 0.05, 0.25, 1.0, 3.0}) {
+            for (double sigma : {0.03, 0.2, 0.6, 1.5}) {
+                for (OptionType type : {OptionType::Call, OptionType::Put}) {
+                    strikes.push_back(K);
+                    expiries.push_back(T);
+                    types.push_back(type);
+                    spots.push_back(100.0);
+                    rates.push_back(T < 1.0 ? 0.05 : 0.0);
+                    vols.push_back(sigma);
+                }
+            }
+        }
+    }
+    // lanes the scalar path rejects
+    strikes.push_back(100.0); expiries.push_back(0.0);  types.push_back(OptionType::Call); spots.push_back(100.0); rates.push_back(0.05); vols.push_back(0.2);
+    strikes.push_back(-5.0);  expiries.push_back(1.0);  types.push_back(OptionType::Put);  spots.push_back(100.0); rates.push_back(0.05); vols.push_back(0.2);
+    strikes.push_back(100.0); expiries.push_back(1.0);  types.push_back(OptionType::Put);  spots.push_back(0.0);   rates.push_back(0.05); vols.push_back(0.2);
+
+    const std::size_t n = strikes.size();
+    std::vector<double> premium(n), delta(n), gamma(n), theta(n), vega(n), rho(n);
+    std::vector<std::uint8_t> valid(n);
+
+    ChainInputs inputs{strikes, expiries, types, spots, rates, vols};
+    GreeksBatch outputs{premium, delta, gamma, theta, vega, rho};
+    std::size_t validCount = BlackScholes::calculateBatch(inputs, outputs, valid);
+
+    double maxError = 0.0;
+    bool maskMatches = true;
+    std::size_t expectedValid = 0;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        FlatVolatility vol(vols[i]);
+        std::optional<Greeks> g = BlackScholes::calculate(strikes[i], expiries[i], types[i], spots[i], rates[i], vol);
+        if (g.has_value() != (valid[i] == 1)) maskMatches = false;
+        if (!g) continue;
+        expectedValid++;
+
+        auto error = [](double expected, double actual) {
+            return std::abs(expected - actual) / std::max(1.0, std::abs(expected));
+        };
+        maxError = std::max({maxError,
+                             error(g->premium, premium[i]), error(g->delta, delta[i]), error(g->gamma, gamma[i]),
+                             error(g->theta, theta[i]), error(g->vega, vega[i]), error(g->rho, rho[i])});
+    }
+
+    if (maskMatches && validCount == expectedValid && maxError < 1e-9) {
+        std::cout << "[PASS] Batch pricing matches scalar Black-Scholes." << "\n";
+    } else {
+        std::cout << "[FAIL] Batch pricing diverges from scalar (max error " << maxError << ")" << "\n";
+    }
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/ChainFile.h"
+#include "../Headers/ImpliedVolatility.h"
+
+inline void runChainFileTest() {
+
+    // two underlyings, quotes written out of order, bid/ask a cent either side of the model price
+    struct Row { const char* symbol; double spot; double strike; int days; OptionType type; double vol; };
+    std::vector<Row> rows;
+    for (int days : {60, 10, 30})
+        for (double m : {0.9, 1.0, 1.1}) {
+            rows.push_back({"XYZ", 50.0, 50.0 * m, days, OptionType::Put, 0.3 + 0.1 * (1.0 - m)});
+            rows.push_back({"ABC", 120.0, 120.0 * m, days, OptionType::Call, 0.2 + 0.05 * (1.0 - m)});
+        }
+    std::ostringstream csv;
+    csv << "symbol,spot,rate,strike,expiryDays,type,bid,ask\n";
+    for (const Row& row : rows) {
+        double price = *BlackScholes::calculatePremium(row.strike, row.days / gbl::TRADING_DAYS, row.type, row.spot, 0.04, row.vol);
+        csv << row.symbol << "," << row.spot << ",0.04," << row.strike << "," << row.days << "," << (row.type == OptionType::Call ? "C" : "P")
+            << "," << std::setprecision(17) << price - 0.01 << "," << price + 0.01 << "\n";
+    }
+
+    const std::string path = (std::filesystem::temp_directory_path() / "options_wizard_chain_test.owc").string();
+    std::istringstream csvIn(csv.str());
+    std::size_t written = ChainFile::convertCsv(csvIn, path);
+    ChainFile chain = ChainFile::open(path);
+
+    // rows grouped by underlying in first-seen order, then by expiry and strike
+    ChainUnderlyingView xyz = chain.underlying(0), abc = chain.underlying(1);
+    bool layout = written == rows.size() && chain.size() == rows.size() && chain.underlyingCount() == 2
+                  && xyz.symbol == "XYZ" && xyz.first == 0 && xyz.count == 9 && abc.symbol == "ABC" && abc.first == 9 && abc.count == 9
+                  && chain.expiries()[0] == 10.0 / gbl::TRADING_DAYS && chain.strikes()[0] == 45.0 && chain.types()[9] == OptionType::Call
+                  && chain.spots()[9] == 120.0 && chain.underlyingIds()[17] == 1;
+    for (std::size_t i = 1; i < xyz.count; ++i)
+        layout = layout && (chain.expiries()[i - 1] < chain.expiries()[i] || chain.strikes()[i - 1] < chain.strikes()[i]);
+
+    // columns are used in place
+    bool aligned = reinterpret_cast<std::uintptr_t>(chain.strikes().data()) % 64 == 0
+                   && reinterpret_cast<std::uintptr_t>(chain.types().data()) % 64 == 0
+                   && reinterpret_cast<std::uintptr_t>(chain.mids().data()) % 64 == 0;
+
+    // the solver and batch pricer run straight on the file's columns
+    std::vector<double> vols(chain.size()), premium(chain.size());
+    std::vector<IVStatus> status(chain.size());
+    std::vector<std::uint8_t> valid(chain.size());
+    std::size_t converged = ImpliedVolatility::solveBatchInline(chain.quotes(), vols, status);
+    BlackScholes::calculateBatch(chain.chain(vols), GreeksBatch{.premium = premium}, valid);
+    bool priced = converged == chain.size();
+    for (std::size_t i = 0; i < chain.size(); ++i)
+        priced = priced && valid[i] && std::abs(premium[i] - chain.mids()[i]) < 1e-8;
+
+    // a moved-from file is empty, a corrupt one does not open: first an underlying claiming rows
+    // past the end, then garbage
+    ChainFile moved = std::move(chain);
+    bool moves = chain.size() == 0 && chain.strikes().empty() && moved.size() == rows.size();
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    const std::size_t record = bytes.find(std::string("ABC\0", 4));
+    const std::uint64_t badCount = rows.size();
+    if (record != std::string::npos) std::memcpy(&bytes[record + 56], &badCount, sizeof(badCount));   // the record's count field
+    bool rejects = record != std::string::npos;
+    for (const std::string& corrupt : {bytes, std::string(200, 'x')}) {
+        { std::ofstream(path, std::ios::binary | std::ios::trunc) << corrupt; }
+        try {
+            ChainFile::open(path);
+            rejects = false;
+        } catch (const std::runtime_error&) {
+        }
+    }
+    std::filesystem::remove(path);
+
+    if (layout && aligned && priced && moves && rejects) {
+        std::cout << "[PASS] Chain files load in place and price without copies." << "\n";
+    } else {
+        std::cout << "[FAIL] Chain file. Layout: " << layout << ", aligned: " << aligned << ", priced: " << priced
+                  << ", moves: " << moves << ", rejects: " << rejects << "\n";
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+#include "../Headers/CompactStrategy.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/PortfolioBook.h"
+
+inline void runCompactStrategyTest() {
+
+    // interning: one handle per distinct name
+    const StrategyName condor = StrategyName::intern("Iron Condor");
+    const bool names = condor == StrategyName::intern(std::string("Iron ") + "Condor") && condor.view() == "Iron Condor"
+                       && !(condor == StrategyName::intern("Long Straddle")) && StrategyName().view().empty();
+
+    // compact strategies value exactly as the Strategy objects they came from, on the analytic
+    // path and on paths with early settlement alike
+    ParametricVolatility smile(0.25, -0.3, 1.5);
+    const std::vector<Strategy> strategies = {Strategy::ironCondor(85.0, 92.0, 108.0, 115.0, 20.0 / 252.0), Strategy::straddle(100.0, 40.0 / 252.0),
+                                              Strategy::calendarSpread(100.0, 10.0 / 252.0, 40.0 / 252.0, OptionType::Call)};
+    StrategyBook book;
+    for (const Strategy& strategy : strategies) book.add(CompactStrategy::from(strategy));
+    bool matches = book.size() == strategies.size() && book[0].getName() == condor && book[2].toStrategy().getName() == strategies[2].getName();
+    for (bool analytic : {true, false}) {
+        SimulationOptions options;
+        options.analytic = analytic;
+        options.paths = 20000;
+        options.seed = 5;
+        std::vector<result> expected = OptionWizard::simulateStrategies(strategies, 100.0, 103.0, 20.0, 0.05, smile, 0.08, 0.25, options);
+        std::vector<CompactResult> compact(book.size());
+        OptionWizard::simulateStrategies(book.strategies(), 100.0, 103.0, 20.0, 0.05, smile, 0.08, 0.25, options, compact);
+        for (std::size_t s = 0; s < strategies.size(); ++s) {
+            matches = matches && compact[s].strategyName == book[s].getName() && compact[s].entryCost == expected[s].entryCost
+                      && compact[s].expectedValue == expected[s].expectedValue && compact[s].pop == expected[s].pop
+                      && compact[s].projectedValue == expected[s].projectedValue && compact[s].pathsUsed == expected[s].pathsUsed;
+        }
+    }
+
+    // the book keeps its block across scans; limits are enforced
+    const std::size_t capacity = book.capacity();
+    book.clear();
+    for (const Strategy& strategy : strategies) book.add(CompactStrategy::from(strategy));
+    const bool reused = book.capacity() == capacity && book.size() == strategies.size();
+    bool rejected = false;
+    try {
+        CompactStrategy wide = CompactStrategy::from(strategies[0]);
+        wide.addLeg(Option(120.0, 0.1, OptionType::Call), 1);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    try {
+        std::vector<CompactResult> tooFew(1);
+        OptionWizard::simulateStrategies(book.strategies(), 100.0, 103.0, 20.0, 0.05, smile, 0.08, 0.25, {}, tooFew);
+        rejected = false;
+    } catch (const std::invalid_argument&) {
+    }
+
+    // the portfolio book nets a compact strategy like the original
+    PortfolioBook fromStrategy(100.0, 0.05, smile), fromCompact(100.0, 0.05, smile);
+    fromStrategy.add(strategies[0], 3.0);
+    fromCompact.add(book[0], 3.0);
+    const bool netted = std::abs(fromStrategy.totals().delta - fromCompact.totals().delta) < 1e-12 && fromCompact.size() == 4;
+
+    if (names && matches && reused && rejected && netted) {
+        std::cout << "[PASS] Compact strategies price and net the same as Strategy and reuse their book." << "\n";
+    } else {
+        std::cout << "[FAIL] Compact Strategy (names: " << names << ", matches: " << matches << ", reused: " << reused
+                  << ", rejected: " << rejected << ", netted: " << netted << ")" << "\n";
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runGridVolatilityTest() {
+
+    double S = 100.0;
+    ParametricVolatility smile(0.25, -0.2, 1.0);
+    std::vector<double> nodes, expiries{30.0 / gbl::TRADING_DAYS, 90.0 / gbl::TRADING_DAYS, 1.0};
+    for (int k = -8; k <= 8; ++k) nodes.push_back(0.05 * k);
+    std::vector<double> sampled;
+    for (double T : expiries)
+        for (double m : nodes) sampled.push_back(smile.getVol(S * std::exp(m), T, S));
+
+    GridVolatility cubic(nodes, expiries, sampled);
+    GridVolatility linear(nodes, expiries, sampled, GridInterpolation::Linear);
+
+    // the grid reproduces its nodes and tracks the smile between them, cubic closer than linear
+    bool nodesOk = true;
+    double cubicError = 0.0, linearError = 0.0;
+    for (double T : expiries) {
+        for (double m : nodes) nodesOk = nodesOk && std::abs(cubic.getVol(S * std::exp(m), T, S) - smile.getVol(S * std::exp(m), T, S)) < 1e-12;
+        for (double m = -0.39; m < 0.4; m += 0.013) {
+            cubicError = std::max(cubicError, std::abs(cubic.getVol(S * std::exp(m), T, S) - smile.getVol(S * std::exp(m), T, S)));
+            linearError = std::max(linearError, std::abs(linear.getVol(S * std::exp(m), T, S) - smile.getVol(S * std::exp(m), T, S)));
+        }
+    }
+    bool interpolationOk = nodesOk && cubicError < 1e-3 && cubicError < linearError;
+
+    // monotone data never overshoots between nodes
+    GridVolatility step({-0.1, 0.0, 0.1, 0.2}, {0.5}, {0.2, 0.2, 0.4, 0.4});
+    bool monotoneOk = true;
+    for (double m = -0.1; m <= 0.2; m += 0.001) {
+        double v = step.getVol(S * std::exp(m), 0.5, S);
+        monotoneOk = monotoneOk && v >= 0.2 - 1e-15 && v <= 0.4 + 1e-15;
+    }
+
+    // batch lookups match getVol (up to contraction differences in the inlined loops)
+    std::vector<double> strikes, times, spots, batch(200), paths(200);
+    for (int i = 0; i < 200; ++i) {
+        strikes.push_back(60.0 + 0.4 * i);
+        times.push_back(0.02 + 0.006 * i);
+        spots.push_back(80.0 + 0.2 * i);
+    }
+    bool batchOk = true;
+    for (const IVolatilitySurface* surface : {static_cast<const IVolatilitySurface*>(&cubic), static_cast<const IVolatilitySurface*>(&smile)}) {
+        surface->getVols(strikes, times, S, batch);
+        surface->getPathVols(105.0, 0.3, spots, paths);
+        for (int i = 0; i < 200; ++i)
+            batchOk = batchOk && std::abs(batch[i] - surface->getVol(strikes[i], times[i], S)) < 1e-13
+                     && std::abs(paths[i] - surface->getVol(105.0, 0.3, spots[i])) < 1e-13;
+    }
+
+    // quotes priced off the smile come back through the implied vol solver
+    std::vector<double> qStrikes, qExpiries, qSpots, qRates, qPrices;
+    std::vector<OptionType> qTypes;
+    for (double T : expiries) {
+        for (double m : nodes) {
+            double K = S * std::exp(m);
+            OptionType type = m < 0.0 ? OptionType::Put : OptionType::Call;
+            qStrikes.push_back(K);
+            qExpiries.push_back(T);
+            qTypes.push_back(type);
+            qSpots.push_back(S);
+            qRates.push_back(0.05);
+            qPrices.push_back(BlackScholes::calculatePremium(K, T, type, S, 0.05, smile.getVol(K, T, S)).value_or(0.0));
+        }
+    }
+    GridVolatility market = GridVolatility::fromQuotes({qStrikes, qExpiries, qTypes, qSpots, qRates, qPrices}, nodes);
+    double quoteError = 0.0;
+    for (std::size_t i = 0; i < qStrikes.size(); ++i)
+        quoteError = std::max(quoteError, std::abs(market.getVol(qStrikes[i], qExpiries[i], S) - smile.getVol(qStrikes[i], qExpiries[i], S)));
+
+    // a flat sticky-strike grid takes the cached-vol path and must agree with FlatVolatility
+    FlatVolatility flat(0.25);
+    GridVolatility flatGrid({-1.0, 1.0}, {1.0}, {0.25, 0.25}, GridInterpolation::Linear, S);
+    SimulationOptions options;
+    options.paths = 20000;
+    options.seed = 5;
+    Strategy condor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, 60.0 / gbl::TRADING_DAYS);
+    result flatRun = OptionWizard::simulateStrategy(condor, S, S, 20.0, 0.05, flat, 0.08, 0.25, options);
+    result gridRun = OptionWizard::simulateStrategy(condor, S, S, 20.0, 0.05, flatGrid, 0.08, 0.25, options);
+    bool cachedOk = !flatGrid.dependsOnSpot() && flatRun.expectedValue == gridRun.expectedValue && flatRun.pop == gridRun.pop;
+
+    if (interpolationOk && monotoneOk && batchOk && quoteError < 1e-7 && cachedOk) {
+        std::cout << "[PASS] Grid volatility surface interpolates, batches and rebuilds from quotes." << "\n";
+    } else {
+        std::cout << "[FAIL] Grid volatility (interpolation " << cubicError << " vs linear " << linearError
+                  << ", monotone " << monotoneOk << ", batch " << batchOk << ", quotes " << quoteError
+                  << ", cached " << cachedOk << ")" << "\n";
+    }
+}
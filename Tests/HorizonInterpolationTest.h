@@ -0,0 +1,44 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/CubicSpline.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runHorizonInterpolationTest() {
+
+    // spline of a call price over the normal draw against the exact price
+    double S = 100.0, K = 105.0, T = 0.25, r = 0.05, sigma = 0.3;
+    auto price = [&](double Z) {
+        return BlackScholes::calculatePremium(K, T, OptionType::Call, S * std::exp(sigma * std::sqrt(T) * Z), r, sigma).value_or(0.0);
+    };
+    std::vector<double> nodes(257);
+    for (std::size_t i = 0; i < nodes.size(); ++i) nodes[i] = price(-6.0 + 12.0 * static_cast<double>(i) / 256.0);
+    CubicSpline spline(-6.0, 6.0, nodes);
+
+    double splineError = 0.0;
+    for (double Z = -6.0; Z <= 6.0; Z += 0.001)
+        splineError = std::max(splineError, std::abs(spline.evaluate(Z) - price(Z)));
+
+    // interpolated simulation against the exact one; both carry MC noise
+    ParametricVolatility volModel(0.25, -0.2, 1.0);
+    Strategy condor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, 60.0 / gbl::TRADING_DAYS);
+    SimulationOptions interpolated;
+    interpolated.interpolateHorizonValue = true;
+
+    result exact = OptionWizard::simulateStrategy(condor, S, S, 20.0, r, volModel, 0.08, 0.25);
+    result approx = OptionWizard::simulateStrategy(condor, S, S, 20.0, r, volModel, 0.08, 0.25, interpolated);
+
+    bool agree = std::abs(exact.expectedValue - approx.expectedValue) < 0.05 && std::abs(exact.pop - approx.pop) < 0.01;
+
+    if (splineError < 1e-4 && agree) {
+        std::cout << "[PASS] Horizon value interpolation matches exact pricing." << "\n";
+    } else {
+        std::cout << "[FAIL] Horizon value interpolation (spline error " << splineError << ", EV "
+                  << exact.expectedValue << " vs " << approx.expectedValue << ")" << "\n";
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/ImpliedVolatility.h"
+#include "../Headers/Option.h"
+
+inline void runImpliedVolatilityTest() {
+
+    double S = 100.0;
+    std::vector<double> strikes, expiries, spots, rates, prices, trueVols;
+    std::vector<OptionType> types;
+
+    for (double K = 30.0; K <= 300.0; K *= 1.07) {
+        for (double T : {0.01, 0.1, 0.5, 1.0, 2.5}) {
+            for (double sigma : {0.05, 0.15, 0.3, 0.7, 1.4}) {
+                for (OptionType type : {OptionType::Call, OptionType::Put}) {
+                    double r = 0.04;
+                    std::optional<double> premium = BlackScholes::calculatePremium(K, T, type, S, r, sigma);
+                    // skip quotes whose time value is lost in the intrinsic value
+                    double intrinsic = std::max(0.0, (type == OptionType::Call ? 1.0 : -1.0) * (S - K * std::exp(-r * T)));
+                    if (!premium || *premium - intrinsic < 1e-6) continue;
+
+                    strikes.push_back(K);
+                    expiries.push_back(T);
+                    types.push_back(type);
+                    spots.push_back(S);
+                    rates.push_back(r);
+                    prices.push_back(*premium);
+                    trueVols.push_back(sigma);
+                }
+            }
+        }
+    }
+    std::size_t solvable = strikes.size();
+
+    // arbitrage violations and bad inputs
+    strikes.push_back(80.0);  expiries.push_back(1.0); types.push_back(OptionType::Call); spots.push_back(S); rates.push_back(0.0); prices.push_back(19.0);
+    strikes.push_back(100.0); expiries.push_back(1.0); types.push_back(OptionType::Call); spots.push_back(S); rates.push_back(0.0); prices.push_back(100.5);
+    strikes.push_back(100.0); expiries.push_back(0.0); types.push_back(OptionType::Put);  spots.push_back(S); rates.push_back(0.0); prices.push_back(5.0);
+
+    std::size_t n = strikes.size();
+    std::vector<double> vols(n);
+    std::vector<IVStatus> status(n);
+    std::size_t converged = ImpliedVolatility::solveBatch({strikes, expiries, types, spots, rates, prices}, vols, status);
+
+    double maxPriceError = 0.0;
+    for (std::size_t i = 0; i < solvable; ++i) {
+        if (status[i] != IVStatus::Converged) continue;
+        std::optional<double> repriced = BlackScholes::calculatePremium(strikes[i], expiries[i], types[i], spots[i], rates[i], vols[i]);
+        maxPriceError = std::max(maxPriceError, std::abs(repriced.value_or(0.0) - prices[i]) / std::max(1.0, prices[i]));
+    }
+
+    bool flagsOk = status[solvable] == IVStatus::BelowIntrinsic
+                   && status[solvable + 1] == IVStatus::AboveMaximum
+                   && status[solvable + 2] == IVStatus::InvalidInput;
+
+    if (converged == solvable && maxPriceError < 1e-9 && flagsOk) {
+        std::cout << "[PASS] Batch implied vol reprices every quote." << "\n";
+    } else {
+        std::cout << "[FAIL] Batch implied vol: " << converged << "/" << solvable << " converged, max price error " << maxPriceError << "\n";
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runPathEngineTest() {
+
+    double S = 100.0, r = 0.05, mu = 0.08, sigma = 0.25;
+    double nearT = 20.0 / gbl::TRADING_DAYS;
+    double farT = 60.0 / gbl::TRADING_DAYS;
+    ParametricVolatility volModel(sigma, 0.0, 0.0);
+
+    // calendar: short the near call, long the far call
+    Strategy calendar("Calendar");
+    calendar.addLeg(Option(S, nearT, OptionType::Call), -1);
+    calendar.addLeg(Option(S, farT, OptionType::Call), 1);
+    Strategy farOnly("Far call");
+    farOnly.addLeg(Option(S, farT, OptionType::Call), 1);
+
+    SimulationOptions simulated;
+    simulated.paths = 200000;
+    simulated.seed = 21;
+    SimulationOptions analytic;
+    analytic.analytic = true;
+
+    // horizon 40 days: the near call settles on day 20 at that day's spot, so its expected
+    // payoff is Black-Scholes at rate mu over 20 days, grown back at mu
+    double nearPayoff = BlackScholes::calculatePremium(S, nearT, OptionType::Call, S, mu, sigma).value_or(0.0) * std::exp(mu * nearT);
+    result farExpected = OptionWizard::simulateStrategy(farOnly, S, S, 40.0, r, volModel, mu, sigma, analytic);
+    result early = OptionWizard::simulateStrategy(calendar, S, S, 40.0, r, volModel, mu, sigma, simulated);
+    double expectedEV = farExpected.expectedValue - nearPayoff;
+    bool settlesOnOwnDate = std::abs(early.expectedValue - expectedEV) < 4.0 * early.expectedValueStdError;
+
+    // horizon on the near expiry: each leg keeps its own remaining time
+    result atNear = OptionWizard::simulateStrategy(calendar, S, S, 20.0, r, volModel, mu, sigma, simulated);
+    result atNearExact = OptionWizard::simulateStrategy(calendar, S, S, 20.0, r, volModel, mu, sigma, analytic);
+    bool perLegExpiry = std::abs(atNear.expectedValue - atNearExact.expectedValue) < 4.0 * atNear.expectedValueStdError
+                        && atNearExact.expectedValue > 0.5;
+
+    // exit rules that never trigger change nothing; a profit target can only add winners
+    Strategy call = Strategy::longCall(S, farT);
+    SimulationOptions plain = simulated;
+    SimulationOptions unreachable = simulated;
+    unreachable.takeProfit = 1e9;
+    unreachable.timeSteps = 10;
+    SimulationOptions target = unreachable;
+    target.takeProfit = 1.0;
+    result base = OptionWizard::simulateStrategy(call, S, S, 40.0, r, volModel, mu, sigma, plain);
+    result never = OptionWizard::simulateStrategy(call, S, S, 40.0, r, volModel, mu, sigma, unreachable);
+    result exits = OptionWizard::simulateStrategy(call, S, S, 40.0, r, volModel, mu, sigma, target);
+    bool exitRules = std::abs(base.expectedValue - never.expectedValue) < 1e-9 * base.expectedValue
+                     && base.pop == never.pop && exits.pop > base.pop;
+
+    if (settlesOnOwnDate && perLegExpiry && exitRules) {
+        std::cout << "[PASS] Path engine settles legs on their own dates and applies exit rules." << "\n";
+    } else {
+        std::cout << "[FAIL] Path engine (early settlement EV " << early.expectedValue << " vs " << expectedEV
+                  << ", per-leg EV " << atNear.expectedValue << " vs " << atNearExact.expectedValue
+                  << ", exit PoP " << exits.pop << " vs " << base.pop << ")" << "\n";
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../Headers/OptionWizard.h"
+
+inline void runPathwiseGreeksTest() {
+
+    ParametricVolatility smile(0.25, -0.3, 1.5);
+    const double S = 100.0, r = 0.05, mu = 0.08, sigma = 0.25, days = 20.0;
+    SimulationOptions options;
+    options.paths = 200000;
+    options.seed = 11;
+    options.sensitivities = true;
+
+    // Central differences of full reruns on the same seed, so both sides see the same draws.
+    // Bumping the spot also reprices the entry, which moves the PoP threshold.
+    double worst = 0.0;   // largest miss in units of the allowed error
+    bool sameValues = true;
+    for (const Strategy& strategy : {Strategy::ironCondor(85.0, 92.0, 108.0, 115.0, 60.0 / 252.0), Strategy::straddle(100.0, 50.0 / 252.0)}) {
+        auto run = [&](double spot, double sg, double m, double d, const SimulationOptions& o) {
+            return OptionWizard::simulateStrategy(strategy, spot, spot, d, r, smile, m, sg, o);
+        };
+        const result base = run(S, sigma, mu, days, options);
+        const MetricSensitivities& g = *base.sensitivities;
+
+        SimulationOptions plain = options;
+        plain.sensitivities = false;
+        const result without = run(S, sigma, mu, days, plain);
+        sameValues = sameValues && !without.sensitivities && without.expectedValue == base.expectedValue && without.pop == base.pop;
+
+        auto check = [&](double estimate, double stdError, const result& up, const result& down, double h, bool pop) {
+            const double fd = pop ? (up.pop - down.pop) / (2.0 * h) : (up.expectedValue - down.expectedValue) / (2.0 * h);
+            // a PoP difference counts the paths that cross the threshold, so it carries its own noise
+            const double fdError = pop ? std::sqrt(std::abs(up.pop - down.pop) / options.paths) / (2.0 * h) : 0.0;
+            worst = std::max(worst, std::abs(estimate - fd) / (5.0 * std::hypot(stdError, fdError) + 0.03 * std::abs(fd) + 1e-6));
+        };
+        auto both = [&](double ev, double evError, double pop, double popError, auto bumped, double h) {
+            const result up = bumped(h), down = bumped(-h);
+            check(ev, evError, up, down, h, false);
+            check(pop, popError, up, down, h, true);
+        };
+        both(g.expectedValue.spot, g.expectedValueStdError.spot, g.pop.spot, g.popStdError.spot,
+             [&](double h) { return run(S + h, sigma, mu, days, plain); }, 1.0);
+        both(g.expectedValue.sigma, g.expectedValueStdError.sigma, g.pop.sigma, g.popStdError.sigma,
+             [&](double h) { return run(S, sigma + h, mu, days, plain); }, 0.02);
+        both(g.expectedValue.mu, g.expectedValueStdError.mu, g.pop.mu, g.popStdError.mu,
+             [&](double h) { return run(S, sigma, mu + h, days, plain); }, 0.02);
+        both(g.expectedValue.days, g.expectedValueStdError.days, g.pop.days, g.popStdError.days,
+             [&](double h) { return run(S, sigma, mu, days + h, plain); }, 1.0);
+    }
+
+    // legs expiring on the horizon leave the horizon sensitivities undefined
+    options.paths = 20000;
+    const result atExpiry = OptionWizard::simulateStrategy(Strategy::bullCallSpread(100.0, 110.0, days / 252.0), S, S, days, r, smile, mu, sigma, options);
+    const bool expiryNan = atExpiry.sensitivities && std::isnan(atExpiry.sensitivities->expectedValue.days) && std::isfinite(atExpiry.sensitivities->pop.spot);
+
+    if (worst <= 1.0 && sameValues && expiryNan) {
+        std::cout << "[PASS] Pathwise and likelihood-ratio sensitivities agree with finite differences." << "\n";
+    } else {
+        std::cout << "[FAIL] Pathwise Greeks (worst miss: " << worst << " of tolerance, same values: " << sameValues << ", NaN at expiry: " << expiryNan << ")" << "\n";
+    }
+}
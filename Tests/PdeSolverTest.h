@@ -0,0 +1,72 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../Headers/PdeSolver.h"
+#include "../Headers/BlackScholes.h"
+
+inline void runPdeSolverTest() {
+
+    const double K = 100.0, T = 1.0, r = 0.05, sigma = 0.2;
+    FlatVolatility flat(sigma);
+
+    // American reference: Cox-Ross-Rubinstein tree with early exercise at every node
+    auto binomialPut = [&](double S, int steps) {
+        const double dt = T / steps, up = std::exp(sigma * std::sqrt(dt)), p = (std::exp(r * dt) - 1.0 / up) / (up - 1.0 / up);
+        const double discount = std::exp(-r * dt);
+        std::vector<double> v(steps + 1);
+        for (int i = 0; i <= steps; ++i) v[i] = std::max(K - S * std::pow(up, 2 * i - steps), 0.0);
+        for (int j = steps - 1; j >= 0; --j)
+            for (int i = 0; i <= j; ++i)
+                v[i] = std::max(discount * (p * v[i + 1] + (1.0 - p) * v[i]), K - S * std::pow(up, 2 * i - j));
+        return v[0];
+    };
+
+    // European solves across the grid against the closed form
+    PdeOptions european;
+    european.american = false;
+    double europeanError = 0.0, greekError = 0.0;
+    for (OptionType type : {OptionType::Call, OptionType::Put}) {
+        PdeGrid grid = PdeSolver::solve(K, T, type, 100.0, r, sigma, european);
+        for (double S : {80.0, 95.0, 100.0, 103.7, 120.0}) {
+            std::optional<Greeks> g = BlackScholes::calculate(K, T, type, S, r, flat);
+            PdePoint point = grid.at(S);
+            europeanError = std::max(europeanError, std::abs(point.value - g->premium));
+            greekError = std::max({greekError, std::abs(point.delta - g->delta), std::abs(point.gamma - g->gamma), std::abs(point.theta - g->theta)});
+        }
+    }
+
+    // American: the call is the European one without dividends, the put matches the tree
+    PdeGrid americanPut = PdeSolver::solve(K, T, OptionType::Put, 100.0, r, sigma);
+    PdeGrid americanCall = PdeSolver::solve(K, T, OptionType::Call, 100.0, r, sigma);
+    double americanError = std::abs(americanCall.at(100.0).value - BlackScholes::calculatePremium(K, T, OptionType::Call, 100.0, r, sigma).value());
+    for (double S : {90.0, 100.0, 110.0}) americanError = std::max(americanError, std::abs(americanPut.at(S).value - binomialPut(S, 2000)));
+
+    bool exercise = true;
+    for (std::size_t i = 0; i < americanPut.spots.size(); ++i)
+        exercise = exercise && americanPut.values[i] >= std::max(K - americanPut.spots[i], 0.0) - 1e-6;
+    exercise = exercise && americanPut.at(100.0).value > BlackScholes::calculatePremium(K, T, OptionType::Put, 100.0, r, sigma).value() + 0.4;
+
+    // stopping at a horizon leaves the value with the remaining time; the batch matches single solves
+    PdeOptions halfway = european;
+    halfway.elapsed = 0.5;
+    const double horizonError = std::abs(PdeSolver::solve(K, T, OptionType::Call, 100.0, r, sigma, halfway).at(110.0).value
+                                         - BlackScholes::calculatePremium(K, 0.5, OptionType::Call, 110.0, r, sigma).value());
+    std::vector<Option> options = {Option(95.0, 0.5, OptionType::Put), Option(105.0, 0.25, OptionType::Call), Option(100.0, 1.0, OptionType::Put)};
+    std::vector<PdeGrid> batch = PdeSolver::solveBatch(options, 100.0, r, flat);
+    bool batchMatches = batch.size() == options.size();
+    for (std::size_t i = 0; batchMatches && i < options.size(); ++i)
+        batchMatches = batch[i].values == PdeSolver::solve(options[i].getStrike(), options[i].getTimeToExpiry(), options[i].getType(), 100.0, r, sigma).values;
+    std::vector<double> spots = {100.0, 105.0}, values(2);
+    batch[2].valuesAt(spots, values);
+    batchMatches = batchMatches && std::abs(values[0] - batch[2].at(100.0).value) < 1e-12 && std::abs(values[1] - batch[2].at(105.0).value) < 1e-12;
+
+    bool accurate = europeanError < 2e-3 && greekError < 2e-3 && americanError < 5e-3 && horizonError < 2e-3;
+    if (accurate && exercise && batchMatches) {
+        std::cout << "[PASS] PDE solver matches Black-Scholes and prices early exercise." << "\n";
+    } else {
+        std::cout << "[FAIL] PDE Solver (European error: " << europeanError << ", American error: " << americanError << ", Greek error: " << greekError
+                  << ", horizon error: " << horizonError << ", exercise: " << exercise << ", batch: " << batchMatches << ")" << "\n";
+    }
+}
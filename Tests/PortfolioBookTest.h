@@ -0,0 +1,94 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../Headers/PortfolioBook.h"
+#include "../Headers/BlackScholes.h"
+#include "../Headers/Global.h"
+
+inline void runPortfolioBookTest() {
+
+    const double r = 0.05;
+    ParametricVolatility volModel(0.25, -0.3, 1.5);
+
+    // strategies on a few expiries that share strikes, so legs net across strategies
+    std::vector<Strategy> strategies;
+    for (int e = 1; e <= 3; ++e) {
+        const double T = 20.0 * e / gbl::TRADING_DAYS;
+        for (double K = 90.0; K <= 110.0; K += 5.0) {
+            strategies.push_back(Strategy::straddle(K, T));
+            strategies.push_back(Strategy::bullCallSpread(K, K + 5.0, T));
+            strategies.push_back(Strategy::bearPutSpread(K + 5.0, K, T));
+        }
+        strategies.push_back(Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, T));
+    }
+
+    // totals of the strategies in `held`, each leg priced on its own
+    auto bruteForce = [&](const std::vector<std::pair<std::size_t, double>>& held, double spot) {
+        Greeks sum{};
+        for (const auto& [s, multiplier] : held)
+            for (const StrategyLeg& leg : strategies[s].getLegs()) {
+                std::optional<Greeks> g = BlackScholes::calculate(leg.option.getStrike(), leg.option.getTimeToExpiry(), leg.option.getType(), spot, r, volModel);
+                const double q = leg.quantity * multiplier;
+                sum.premium += q * g->premium;
+                sum.delta += q * g->delta;
+                sum.gamma += q * g->gamma;
+                sum.theta += q * g->theta;
+                sum.vega += q * g->vega;
+                sum.rho += q * g->rho;
+            }
+        return sum;
+    };
+    auto difference = [](const Greeks& a, const Greeks& b) {
+        return std::max({std::abs(a.premium - b.premium), std::abs(a.delta - b.delta), std::abs(a.gamma - b.gamma),
+                         std::abs(a.theta - b.theta), std::abs(a.vega - b.vega), std::abs(a.rho - b.rho)});
+    };
+
+    PortfolioBook book(100.0, r, volModel);
+    std::vector<std::pair<std::size_t, double>> held;
+    for (std::size_t s = 0; s < strategies.size(); ++s) {
+        const double multiplier = 1.0 + static_cast<double>(s % 3);
+        book.add(strategies[s], multiplier);
+        held.emplace_back(s, multiplier);
+    }
+    const double addError = difference(book.totals(), bruteForce(held, 100.0));
+    const std::size_t fullRows = book.size();
+
+    // removing half the strategies moves the totals without repricing the rest
+    for (std::size_t s = 0; s < strategies.size(); s += 2) book.remove(strategies[s], held[s].second);
+    std::vector<std::pair<std::size_t, double>> remaining;
+    for (std::size_t s = 1; s < strategies.size(); s += 2) remaining.push_back(held[s]);
+    const double removeError = difference(book.totals(), bruteForce(remaining, 100.0));
+
+    // rows hold the netted quantity and vanish once flat
+    bool netted = true;
+    PortfolioBook flat(100.0, r, volModel);
+    flat.add(Strategy::bullCallSpread(100.0, 105.0, 0.1));
+    flat.add(Strategy::longCall(105.0, 0.1));
+    netted = netted && flat.size() == 1 && flat.quantity(100.0, 0.1, OptionType::Call) == 1.0 && flat.quantity(105.0, 0.1, OptionType::Call) == 0.0;
+    flat.remove(Strategy::longCall(100.0, 0.1));
+    netted = netted && flat.size() == 0 && difference(flat.totals(), Greeks{}) < 1e-12;
+
+    // a new market reprices every row and rebuilds the totals
+    const std::size_t priced = book.reprice(104.0, r);
+    const double repriceError = difference(book.totals(), bruteForce(remaining, 104.0));
+
+    bool rejected = false;
+    const Greeks before = book.totals();
+    try {
+        book.add(std::vector<BookPosition>{{100.0, 0.2, OptionType::Call, 1.0}, {-5.0, 0.2, OptionType::Put, 1.0}});
+    } catch (const std::invalid_argument&) {
+        rejected = difference(before, book.totals()) == 0.0 && book.quantity(100.0, 0.2, OptionType::Call) == 0.0;
+    }
+
+    bool accurate = addError < 1e-9 && removeError < 1e-9 && repriceError < 1e-9;
+    bool consistent = priced == book.size() && book.totals().rho != 0.0;
+
+    if (accurate && netted && consistent && rejected) {
+        std::cout << "[PASS] Portfolio book nets positions and keeps its totals in step with repricing." << "\n";
+    } else {
+        std::cout << "[FAIL] Portfolio Book (errors: " << addError << "/" << removeError << "/" << repriceError << ", netted: " << netted
+                  << ", rows: " << fullRows << ", priced: " << priced << "/" << book.size() << ", rho: " << book.totals().rho << ", rejected: " << rejected << ")" << "\n";
+    }
+}
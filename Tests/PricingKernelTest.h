@@ -0,0 +1,51 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/PricingKernel.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runPricingKernelTest() {
+
+    using simd::ScalarD;
+    auto close = [](double a, double b) { return std::abs(a - b) <= 1e-13 * std::max(1.0, std::abs(b)); };
+
+    bool typedOk = true, maskOk = true, wrapperOk = true;
+    for (double K : {50.0, 95.0, 100.0, 130.0, 250.0}) {
+        for (double T : {0.01, 0.3, 2.0}) {
+            for (double sigma : {0.05, 0.3, 1.2}) {
+                ScalarD k{K}, t{T}, s{100.0}, r{0.04}, v{sigma};
+                GreeksOf<ScalarD> call = blackScholesKernel<OptionType::Call, greek::All>(k, t, s, r, v);
+                GreeksOf<ScalarD> put = blackScholesKernel<OptionType::Put, greek::All>(k, t, s, r, v);
+                GreeksOf<ScalarD> mixedCall = blackScholesKernel<greek::All>(ScalarD::Mask{true}, k, t, s, r, v);
+                GreeksOf<ScalarD> mixedPut = blackScholesKernel<greek::All>(ScalarD::Mask{false}, k, t, s, r, v);
+
+                // single-type kernels agree with the per-lane kernel
+                typedOk = typedOk && close(call.premium.v, mixedCall.premium.v) && close(call.theta.v, mixedCall.theta.v)
+                          && close(put.premium.v, mixedPut.premium.v) && close(put.rho.v, mixedPut.rho.v)
+                          && close(put.delta.v, mixedPut.delta.v);
+
+                // masked kernels give the same terms and leave the rest at zero
+                GreeksOf<ScalarD> premium = blackScholesKernel<OptionType::Put, greek::Premium>(k, t, s, r, v);
+                GreeksOf<ScalarD> premiumVega = blackScholesKernel<OptionType::Call, greek::Premium | greek::Vega>(k, t, s, r, v);
+                GreeksOf<ScalarD> deltaGamma = blackScholesKernel<OptionType::Call, greek::Delta | greek::Gamma>(k, t, s, r, v);
+                maskOk = maskOk && close(premium.premium.v, put.premium.v) && premium.delta.v == 0.0 && premium.vega.v == 0.0
+                         && close(premiumVega.premium.v, call.premium.v) && close(premiumVega.vega.v, call.vega.v) && premiumVega.theta.v == 0.0
+                         && close(deltaGamma.delta.v, call.delta.v) && close(deltaGamma.gamma.v, call.gamma.v) && deltaGamma.premium.v == 0.0;
+
+                // the public functions are thin wrappers over the same kernels
+                FlatVolatility flat(sigma);
+                std::optional<Greeks> g = BlackScholes::calculate(K, T, OptionType::Call, 100.0, 0.04, flat);
+                std::optional<double> p = BlackScholes::calculatePremium(K, T, OptionType::Put, 100.0, 0.04, sigma);
+                wrapperOk = wrapperOk && g && p && close(g->premium, call.premium.v) && close(g->rho, call.rho.v) && close(*p, put.premium.v);
+            }
+        }
+    }
+
+    if (typedOk && maskOk && wrapperOk) {
+        std::cout << "[PASS] Specialized pricing kernels agree with the full kernel." << "\n";
+    } else {
+        std::cout << "[FAIL] Pricing kernels (typed " << typedOk << ", masks " << maskOk << ", wrappers " << wrapperOk << ")" << "\n";
+    }
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include "../Headers/Random.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/ThreadPool.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runRandomTest() {
+
+    // Philox4x32-10 known-answer vectors from the Random123 distribution
+    using Block = std::array<std::uint32_t, 4>;
+    bool knownAnswers =
+            PhiloxNormalGenerator::philox({0, 0, 0, 0}, {0, 0})
+                    == Block{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}
+            && PhiloxNormalGenerator::philox({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff})
+                    == Block{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}
+            && PhiloxNormalGenerator::philox({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0})
+                    == Block{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+
+    // any split of a range gives the same draws
+    PhiloxNormalGenerator philox(42);
+    std::vector<double> whole(10007);
+    philox.fill(3, 5, whole);
+    bool splitMatches = true;
+    for (std::size_t cut : {1u, 2u, 3u, 7u, 1024u, 5001u}) {
+        std::vector<double> head(cut), tail(whole.size() - cut);
+        philox.fill(3, 5, head);
+        philox.fill(3, 5 + cut, tail);
+        for (std::size_t i = 0; i < whole.size(); ++i)
+            if ((i < cut ? head[i] : tail[i - cut]) != whole[i]) splitMatches = false;
+    }
+
+    // moments of a large sample
+    std::vector<double> sample(1 << 20);
+    philox.fill(0, 0, sample);
+    double mean = 0.0, variance = 0.0, kurtosis = 0.0;
+    for (double z : sample) mean += z;
+    mean /= static_cast<double>(sample.size());
+    for (double z : sample) {
+        variance += (z - mean) * (z - mean);
+        kurtosis += std::pow(z - mean, 4);
+    }
+    variance /= static_cast<double>(sample.size());
+    kurtosis /= static_cast<double>(sample.size()) * variance * variance;
+    bool moments = std::abs(mean) < 0.005 && std::abs(variance - 1.0) < 0.01 && std::abs(kurtosis - 3.0) < 0.05;
+
+    // a seeded simulation is bit-identical for any pool size
+    ThreadPool onePool(1), threePool(3);
+    ParametricVolatility volModel(0.25, -0.2, 1.0);
+    Strategy condor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, 60.0 / gbl::TRADING_DAYS);
+    SimulationOptions single;
+    single.seed = 7;
+    single.pool = &onePool;
+    SimulationOptions several = single;
+    several.pool = &threePool;
+    result one = OptionWizard::simulateStrategy(condor, 100.0, 100.0, 20.0, 0.05, volModel, 0.08, 0.25, single);
+    result three = OptionWizard::simulateStrategy(condor, 100.0, 100.0, 20.0, 0.05, volModel, 0.08, 0.25, several);
+    bool reproducible = one.expectedValue == three.expectedValue && one.pop == three.pop;
+
+    if (knownAnswers && splitMatches && moments && reproducible) {
+        std::cout << "[PASS] Philox normals are correct and seeded simulations are reproducible." << "\n";
+    } else {
+        std::cout << "[FAIL] Random layer (known answers " << knownAnswers << ", split " << splitMatches
+                  << ", moments " << moments << ", reproducible " << reproducible << ")" << "\n";
+    }
+}
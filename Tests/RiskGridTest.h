@@ -0,0 +1,91 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../Headers/RiskGrid.h"
+#include "../Headers/BlackScholes.h"
+#include "../Headers/Global.h"
+
+inline void runRiskGridTest() {
+
+    // the surface with every vol moved by a constant, as one vol-shift slice of the grid sees it
+    struct ShiftedVolatility : IVolatilitySurface {
+        const IVolatilitySurface& base;
+        double shift;
+        ShiftedVolatility(const IVolatilitySurface& base, double shift) : base(base), shift(shift) {}
+        [[nodiscard]] double getVol(double strike, double timeToExpiry, double spot) const override {
+            return std::max(base.getVol(strike, timeToExpiry, spot) + shift, 1e-4);
+        }
+    };
+
+    const double spot = 100.0, r = 0.05;
+    ParametricVolatility volModel(0.25, -0.3, 1.5);
+    Strategy condor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, 20.0 / gbl::TRADING_DAYS);
+    RiskGridAxes axes{{-0.10, -0.03, 0.0, 0.02, 0.07, 0.15}, {-0.05, 0.0, 0.10}, {0.0, 5.0, 25.0}};
+    RiskGrid grid(condor, spot, r, volModel, axes);
+
+    // every cell against pricing the legs one at a time; day 25 is past expiry
+    auto checkAgainstScalar = [&](const RiskGrid& g) {
+        double worst = 0.0;
+        const RiskGridAxes& ax = g.axes();
+        for (std::size_t d = 0; d < ax.daysForward.size(); ++d)
+            for (std::size_t v = 0; v < ax.volShifts.size(); ++v) {
+                ShiftedVolatility shifted(volModel, ax.volShifts[v]);
+                for (std::size_t p = 0; p < ax.spotShocks.size(); ++p) {
+                    const double S = spot * (1.0 + ax.spotShocks[p]);
+                    RiskCell expected{-g.entryCost(), 0.0, 0.0, 0.0, 0.0};
+                    for (const StrategyLeg& leg : condor.getLegs()) {
+                        const double K = leg.option.getStrike();
+                        const double T = leg.option.getTimeToExpiry() - ax.daysForward[d] / gbl::TRADING_DAYS;
+                        const bool isCall = leg.option.getType() == OptionType::Call;
+                        if (T <= 0.0) {
+                            expected.pnl += leg.quantity * (isCall ? std::max(S - K, 0.0) : std::max(K - S, 0.0));
+                            expected.delta += leg.quantity * (isCall ? (S > K ? 1.0 : 0.0) : (S < K ? -1.0 : 0.0));
+                            continue;
+                        }
+                        std::optional<Greeks> greeks = BlackScholes::calculate(K, T, leg.option.getType(), S, r, shifted);
+                        if (!greeks) return 1.0;
+                        expected.pnl += leg.quantity * greeks->premium;
+                        expected.delta += leg.quantity * greeks->delta;
+                        expected.gamma += leg.quantity * greeks->gamma;
+                        expected.theta += leg.quantity * greeks->theta;
+                        expected.vega += leg.quantity * greeks->vega;
+                    }
+                    const RiskCell cell = g.at(d, v, p);
+                    worst = std::max({worst, std::abs(cell.pnl - expected.pnl), std::abs(cell.delta - expected.delta),
+                                      std::abs(cell.gamma - expected.gamma), std::abs(cell.theta - expected.theta),
+                                      std::abs(cell.vega - expected.vega)});
+                }
+            }
+        return worst;
+    };
+
+    const double fullError = checkAgainstScalar(grid);
+    const double todayPnl = grid.at(0, 1, 2).pnl;
+
+    // replacing an axis computes only the slices of new points and matches a grid built fresh
+    const std::size_t spotCells = grid.setSpotShocks({-0.10, -0.05, 0.0, 0.02, 0.07, 0.15, 0.20});
+    const std::size_t volCells = grid.setVolShifts({0.0, 0.10, 0.20});
+    const std::size_t dayCells = grid.setDaysForward({0.0, 5.0, 10.0, 25.0});
+    bool incrementalCounts = spotCells == 2 * 3 * 3 && volCells == 3 * 7 && dayCells == 3 * 7;
+
+    RiskGrid fresh(condor, spot, r, volModel, grid.axes());
+    double incrementalError = 0.0;
+    for (std::size_t i = 0; i < grid.pnl().size(); ++i)
+        incrementalError = std::max({incrementalError, std::abs(grid.pnl()[i] - fresh.pnl()[i]), std::abs(grid.delta()[i] - fresh.delta()[i]),
+                                     std::abs(grid.gamma()[i] - fresh.gamma()[i]), std::abs(grid.theta()[i] - fresh.theta()[i]),
+                                     std::abs(grid.vega()[i] - fresh.vega()[i])});
+    const double updatedError = checkAgainstScalar(grid);
+
+    bool matchesScalar = fullError < 1e-9 && updatedError < 1e-9;
+    bool flatToday = std::abs(todayPnl) < 1e-9;
+    bool consistent = incrementalCounts && incrementalError < 1e-12 && grid.pnl().size() == 4 * 3 * 7;
+
+    if (matchesScalar && flatToday && consistent) {
+        std::cout << "[PASS] Risk grid matches scalar pricing and refreshes only the cells a move touches." << "\n";
+    } else {
+        std::cout << "[FAIL] Risk Grid (scalar error: " << fullError << "/" << updatedError << ", today's P&L: " << todayPnl
+                  << ", incremental cells: " << spotCells << "/" << volCells << "/" << dayCells << ", incremental error: " << incrementalError << ")" << "\n";
+    }
+}
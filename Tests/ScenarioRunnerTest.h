@@ -0,0 +1,82 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../Headers/ScenarioRunner.h"
+
+inline void runScenarioRunnerTest() {
+
+    // the same four scenarios as CSV and JSONL; the third does not parse
+    const std::string csv =
+        "id,spot,target,targetDays,expiryDays,expectedReturn,marketPrice,slope,convexity\n"
+        "a,100,105,20,45,0.08,3.2,-0.2,1.0\n"
+        "b,50,48,10,30,0.05,,-0.5,2.5\n"
+        "c,100,oops,20,45,0.08,3.2,-0.2,1.0\n"
+        "\n"
+        "d,250,260,5,5,0.10,8.0,-0.05,0.3\n";
+    const std::string jsonl =
+        "{\"id\": \"a\", \"spot\": 100, \"target\": 105, \"targetDays\": 20, \"expiryDays\": 45, \"expectedReturn\": 0.08, \"marketPrice\": 3.2}\n"
+        "{\"id\": \"b\", \"spot\": 50, \"target\": 48, \"targetDays\": 10, \"expiryDays\": 30, \"expectedReturn\": 0.05, \"marketPrice\": null, \"slope\": -0.5, \"convexity\": 2.5}\n"
+        "{\"id\": \"c\", \"spot\": 100, \"target\": \"oops\", \"targetDays\": 20, \"expiryDays\": 45}\n"
+        "{\"id\": \"d\", \"spot\": 250, \"target\": 260, \"targetDays\": 5, \"expiryDays\": 5, \"expectedReturn\": 0.10, \"marketPrice\": 8.0, \"slope\": -0.05, \"convexity\": 0.3}\n";
+
+    auto runWith = [](const std::string& input, RecordFormat format, std::size_t window) {
+        std::istringstream in(input);
+        std::ostringstream out;
+        ScenarioRunOptions options;
+        options.window = window;
+        ScenarioRunSummary summary = ScenarioRunner::run(in, format, out, RecordFormat::Csv, options);
+        return std::make_pair(summary, out.str());
+    };
+
+    auto [summary, csvOut] = runWith(csv, RecordFormat::Csv, 256);
+    auto [jsonSummary, jsonOut] = runWith(jsonl, RecordFormat::Jsonl, 256);
+    auto [smallSummary, smallWindowOut] = runWith(csv, RecordFormat::Csv, 1);
+
+    std::vector<std::string> rows;
+    std::istringstream lines(csvOut);
+    for (std::string row; std::getline(lines, row);) rows.push_back(row);
+
+    // header, six strategies each for a, b and d, one error row for c, all in input order
+    bool shape = summary.scenarios == 4 && summary.failed == 1 && rows.size() == 1 + 3 * 6 + 1
+                 && rows[1].rfind("a,", 0) == 0 && rows[7].rfind("b,", 0) == 0 && rows[13].rfind("c,", 0) == 0
+                 && rows[13].find("target is not a number") != std::string::npos && rows[14].rfind("d,", 0) == 0;
+    bool formatsAgree = csvOut == jsonOut && jsonSummary.failed == 1;
+    bool windowed = csvOut == smallWindowOut && smallSummary.scenarios == 4;
+
+    // control characters in ids and messages are escaped, so every JSONL line stays valid
+    std::istringstream controlIn("id,spot,target,targetDays,expiryDays\n"
+                                 "e\tf\x01,100,oops,20,45\n");
+    std::ostringstream controlOut;
+    ScenarioRunner::run(controlIn, RecordFormat::Csv, controlOut, RecordFormat::Jsonl, ScenarioRunOptions{});
+    const std::string controlJson = controlOut.str();
+    bool escaped = controlJson.find("\"e\\tf\\u0001\"") != std::string::npos
+                   && std::count_if(controlJson.begin(), controlJson.end(), [](char c) { return static_cast<unsigned char>(c) < 0x20; }) == 1;
+
+    // a record gives what evaluating its scenario directly gives
+    Scenario a{};
+    a.id = "a";
+    a.spot = 100.0;
+    a.target = 105.0;
+    a.targetDays = 20.0;
+    a.expiryDays = 45.0;
+    a.marketPrice = 3.2;
+    SimulationOptions analytic;
+    analytic.analytic = true;
+    std::vector<result> direct = ScenarioRunner::evaluate(a, analytic);
+    std::istringstream firstRow(rows[1]);
+    std::vector<std::string> cells;
+    for (std::string cell; std::getline(firstRow, cell, ',');) cells.push_back(cell);
+    bool matches = cells.size() >= 5 && cells[1] == direct[0].strategyName
+                   && std::abs(std::stod(cells[4]) - direct[0].expectedValue) < 1e-8 * (1.0 + std::abs(direct[0].expectedValue));
+
+    if (shape && formatsAgree && windowed && escaped && matches) {
+        std::cout << "[PASS] Batch runner streams scenarios in input order." << "\n";
+    } else {
+        std::cout << "[FAIL] Batch runner. Shape: " << shape << ", formats agree: " << formatsAgree
+                  << ", windowed: " << windowed << ", escaped: " << escaped << ", matches: " << matches << "\n";
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runSharedPathsTest() {
+
+    double S = 100.0;
+    double T = 30.0 / gbl::TRADING_DAYS;
+    ParametricVolatility volModel(0.3, -0.2, 1.0);
+
+    std::vector<Strategy> strategies;
+    strategies.push_back(Strategy::longCall(S, T));
+    strategies.push_back(Strategy::bearPutSpread(S, S * 0.90, T));
+    strategies.push_back(Strategy::ironCondor(S * 0.90, S * 0.95, S * 1.05, S * 1.10, T));
+    // already expired at the horizon, valued from payoffs
+    strategies.push_back(Strategy::straddle(S, 10.0 / gbl::TRADING_DAYS));
+
+    SimulationOptions options;
+    options.paths = 50000;
+    options.seed = 11;
+
+    std::vector<result> together = OptionWizard::simulateStrategies(strategies, S, S * 1.01, 20.0, 0.05, volModel, 0.08, 0.3, options);
+
+    // with a shared seed each strategy sees the same paths as when simulated alone
+    bool matches = together.size() == strategies.size();
+    for (std::size_t i = 0; matches && i < strategies.size(); ++i) {
+        result alone = OptionWizard::simulateStrategy(strategies[i], S, S * 1.01, 20.0, 0.05, volModel, 0.08, 0.3, options);
+        matches = alone.strategyName == together[i].strategyName && alone.expectedValue == together[i].expectedValue
+                  && alone.pop == together[i].pop && alone.entryCost == together[i].entryCost;
+    }
+
+    if (matches) {
+        std::cout << "[PASS] Shared-path simulation matches per-strategy runs." << "\n";
+    } else {
+        std::cout << "[FAIL] Shared-path simulation diverges from per-strategy runs." << "\n";
+    }
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <iostream>
+#include <numeric>
+#include <string>
+#include "../Headers/Instrumentation.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/SimulationStats.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/ThreadPool.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runSimulationStatsTest() {
+
+    double S = 100.0, r = 0.05, mu = 0.08, sigma = 0.25;
+    double T = 60.0 / gbl::TRADING_DAYS;
+    ParametricVolatility volModel(sigma, -0.2, 1.0);
+    Strategy condor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, T);
+    ThreadPool pool(2);
+
+    SimulationOptions plain;
+    plain.paths = 100000;
+    plain.seed = 8;
+    plain.pool = &pool;
+    SimulationOptions instrumented = plain;
+    SimulationStats stats;
+    instrumented.stats = &stats;
+
+    // collecting stats does not change the result
+    result reference = OptionWizard::simulateStrategy(condor, S, S, 20.0, r, volModel, mu, sigma, plain);
+    result observed = OptionWizard::simulateStrategy(condor, S, S, 20.0, r, volModel, mu, sigma, instrumented);
+    bool unchanged = reference.expectedValue == observed.expectedValue && reference.pop == observed.pop;
+
+    bool consistent = true;
+    if constexpr (instrument::enabled) {
+        std::uint64_t threadPaths = 0;
+        for (const SimulationThreadStats& t : stats.threads) threadPaths += t.paths;
+        consistent = stats.instrumented && stats.paths == observed.pathsUsed && threadPaths == stats.paths && stats.rounds == 1
+                     && stats.drawSeconds > 0.0 && stats.valuationSeconds > 0.0 && stats.setupSeconds > 0.0
+                     && stats.wallSeconds >= stats.setupSeconds + stats.reductionSeconds && stats.pathsPerSecond() > 0.0
+                     && stats.imbalance() >= 1.0;
+
+        // bridged paths with exit rules count their draws and valuation too
+        SimulationOptions bridged = instrumented;
+        bridged.timeSteps = 8;
+        bridged.stopLoss = 1.0;
+        result exits = OptionWizard::simulateStrategy(condor, S, S, 20.0, r, volModel, mu, sigma, bridged);
+        consistent = consistent && stats.paths == exits.pathsUsed && stats.drawSeconds > 0.0;
+
+        // the analytic path is all setup
+        SimulationOptions analytic = instrumented;
+        analytic.analytic = true;
+        OptionWizard::simulateStrategy(condor, S, S, 20.0, r, volModel, mu, sigma, analytic);
+        consistent = consistent && stats.paths == 0 && stats.threads.empty() && stats.rounds == 0 && stats.setupSeconds > 0.0;
+    } else {
+        consistent = !stats.instrumented && stats.paths == 0 && stats.threads.empty() && stats.wallSeconds == 0.0;
+    }
+
+    // exports carry the same figures
+    OptionWizard::simulateStrategy(condor, S, S, 20.0, r, volModel, mu, sigma, instrumented);
+    const std::string json = stats.toJson();
+    const std::string prometheus = stats.toPrometheus();
+    const std::string paths = std::to_string(stats.paths);
+    bool exported = json.find("\"paths\": " + paths) != std::string::npos
+                    && prometheus.find("options_wizard_simulation_paths " + paths + "\n") != std::string::npos
+                    && prometheus.find("# TYPE options_wizard_simulation_phase_seconds gauge") != std::string::npos
+                    && prometheus.find("options_wizard_simulation_phase_seconds{phase=\"valuation\"}") != std::string::npos;
+
+    if (unchanged && consistent && exported) {
+        std::cout << "[PASS] Simulation stats account for every path and phase." << "\n";
+    } else {
+        std::cout << "[FAIL] Simulation stats. Unchanged: " << unchanged << ", consistent: " << consistent
+                  << ", exported: " << exported << "\n" << json << "\n";
+    }
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <iostream>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+// Largest error of the single-precision tier against double, per output. Relative errors
+// skip reference values under 1e-4, where the float tier's absolute error dominates.
+struct PrecisionErrors {
+    const char* output;
+    double maxAbsolute = 0.0;
+    double maxRelative = 0.0;
+};
+
+// Accuracy harness: prices a dense grid of moneyness (K/S 0.5-2), expiry (1 day-3 years)
+// and vol (5%-150%), calls and puts, through both tiers of calculateBatch
+inline std::array<PrecisionErrors, 6> comparePricingPrecision() {
+    std::vector<double> strikes, expiries, spots, rates, vols;
+    std::vector<OptionType> types;
+    for (int m = 0; m <= 60; ++m) {
+        for (int t = 0; t <= 19; ++t) {
+            for (int v = 0; v <= 14; ++v) {
+                for (OptionType type : {OptionType::Call, OptionType::Put}) {
+                    strikes.push_back(100.0 * std::pow(2.0, -1.0 + m / 30.0));
+                    expiries.push_back(std::exp(std::log(1.0 / 252.0) + (std::log(3.0) - std::log(1.0 / 252.0)) * t / 19.0));
+                    vols.push_back(0.05 + 1.45 * v / 14.0);
+                    spots.push_back(100.0);
+                    rates.push_back(0.04);
+                    types.push_back(type);
+                }
+            }
+        }
+    }
+
+    const std::size_t n = strikes.size();
+    std::array<std::vector<double>, 6> exact, single;
+    for (std::size_t k = 0; k < 6; ++k) {
+        exact[k].resize(n);
+        single[k].resize(n);
+    }
+    std::vector<std::uint8_t> valid(n);
+    ChainInputs chain{strikes, expiries, types, spots, rates, vols};
+    BlackScholes::calculateBatch(chain, {exact[0], exact[1], exact[2], exact[3], exact[4], exact[5]}, valid);
+    BlackScholes::calculateBatch(chain, {single[0], single[1], single[2], single[3], single[4], single[5]}, valid, Precision::Single);
+
+    std::array<PrecisionErrors, 6> errors{{{"premium"}, {"delta"}, {"gamma"}, {"theta"}, {"vega"}, {"rho"}}};
+    for (std::size_t k = 0; k < 6; ++k) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const double error = std::abs(single[k][i] - exact[k][i]);
+            errors[k].maxAbsolute = std::max(errors[k].maxAbsolute, error);
+            if (std::abs(exact[k][i]) >= 1e-4) errors[k].maxRelative = std::max(errors[k].maxRelative, error / std::abs(exact[k][i]));
+        }
+    }
+    return errors;
+}
+
+inline void runSinglePrecisionTest() {
+
+    // float carries ~7 digits; allow for the cancellation in S N(d1) - K e^(-rT) N(d2)
+    std::array<PrecisionErrors, 6> errors = comparePricingPrecision();
+    bool pricingOk = true;
+    for (const PrecisionErrors& e : errors) pricingOk = pricingOk && e.maxAbsolute < 1e-3 && e.maxRelative < 1e-2;
+    pricingOk = pricingOk && errors[0].maxAbsolute < 1e-4;
+
+    // on the same paths the float tier moves the simulated EV by far less than its standard error
+    ParametricVolatility volModel(0.25, -0.2, 1.0);
+    Strategy condor = Strategy::ironCondor(90.0, 95.0, 105.0, 110.0, 60.0 / gbl::TRADING_DAYS);
+    SimulationOptions options;
+    options.paths = 50000;
+    options.seed = 8;
+    result exact = OptionWizard::simulateStrategy(condor, 100.0, 102.0, 20.0, 0.05, volModel, 0.08, 0.25, options);
+    options.precision = Precision::Single;
+    result single = OptionWizard::simulateStrategy(condor, 100.0, 102.0, 20.0, 0.05, volModel, 0.08, 0.25, options);
+    bool simulationOk = std::abs(single.expectedValue - exact.expectedValue) < 0.01 * exact.expectedValueStdError;
+
+    if (pricingOk && simulationOk) {
+        std::cout << "[PASS] Single-precision tier stays within its error bounds." << "\n";
+    } else {
+        std::cout << "[FAIL] Single precision (premium abs " << errors[0].maxAbsolute << ", EV " << single.expectedValue
+                  << " vs " << exact.expectedValue << ")" << "\n";
+        for (const PrecisionErrors& e : errors)
+            std::cout << "       " << e.output << " abs " << e.maxAbsolute << " rel " << e.maxRelative << "\n";
+    }
+}
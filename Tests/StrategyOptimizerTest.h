@@ -0,0 +1,94 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "../Headers/StrategyOptimizer.h"
+#include "../Headers/ThreadPool.h"
+
+inline void runStrategyOptimizerTest() {
+
+    const double spot = 100.0, target = 104.0, targetDays = 20.0, r = 0.05, mu = 0.08, sigma = 0.25;
+    ParametricVolatility volModel(sigma, -0.2, 1.0);
+    StrategySearchSpace space;
+    for (double K = 86.0; K <= 114.0; K += 2.0) space.strikes.push_back(K);
+    space.expiryDays = {10.0, 20.0, 40.0};   // 10 is before the horizon and dropped
+
+    // analytic valuation end to end, so the runs below are deterministic
+    OptimizerOptions options;
+    options.simulation.analytic = true;
+    options.top = 5;
+    options.survivors = 5;
+    options.constraints.maxLoss = 6.0;
+
+    bool consistent = true;
+    for (RankBy rankBy : {RankBy::ExpectedValue, RankBy::Pop, RankBy::ReturnOnRisk}) {
+        options.rankBy = rankBy;
+        options.survivors = 5;
+        OptimizerSummary pruned = StrategyOptimizer::search(space, spot, target, targetDays, r, volModel, mu, sigma, options);
+        options.survivors = 1000000;
+        OptimizerSummary exhaustive = StrategyOptimizer::search(space, spot, target, targetDays, r, volModel, mu, sigma, options);
+
+        // the bounds only skip candidates that could not have made the cut
+        bool same = pruned.ranked.size() == options.top && pruned.ranked.size() == exhaustive.ranked.size()
+                    && exhaustive.screened == exhaustive.feasible && pruned.screened <= exhaustive.screened;
+        for (std::size_t i = 0; same && i < pruned.ranked.size(); ++i)
+            same = pruned.ranked[i].evaluation.strategyName == exhaustive.ranked[i].evaluation.strategyName
+                   && std::abs(pruned.ranked[i].score - exhaustive.ranked[i].score) < 1e-12;
+
+        // ranked best first, within the constraints and their own bounds
+        for (std::size_t i = 0; same && i < pruned.ranked.size(); ++i) {
+            const RankedStrategy& ranked = pruned.ranked[i];
+            const double expectedPnl = ranked.evaluation.expectedValue - ranked.evaluation.entryCost;
+            same = ranked.maxLoss <= 6.0 && expectedPnl <= ranked.maxGain + 1e-9 && expectedPnl >= -ranked.maxLoss - 1e-9
+                   && (i == 0 || pruned.ranked[i - 1].score >= ranked.score);
+            for (const StrategyLeg& leg : ranked.strategy.getLegs()) same = same && leg.option.getTimeToExpiry() * gbl::TRADING_DAYS >= targetDays - 1e-9;
+        }
+
+        // the winner valued on its own gives the same score
+        if (same) {
+            const RankedStrategy& best = pruned.ranked.front();
+            result alone = OptionWizard::simulateStrategy(best.strategy, spot, target, targetDays, r, volModel, mu, sigma, options.simulation);
+            std::optional<double> s = StrategyOptimizer::score(rankBy, alone, best.maxLoss);
+            same = s && std::abs(*s - best.score) < 1e-9;
+        }
+        consistent = consistent && same;
+    }
+
+    // candidates per shape on 15 strikes and two usable expiries
+    options.rankBy = RankBy::ExpectedValue;
+    options.constraints = {};
+    OptimizerSummary all = StrategyOptimizer::search(space, spot, target, targetDays, r, volModel, mu, sigma, options);
+    const std::size_t pairs = 15 * 14 / 2, quads = 15 * 14 * 13 * 12 / 24;
+    bool enumerated = all.candidates == 2 * (3 * pairs + 15 + quads) + 2 * 15;
+
+    // exit rules force the screen to simulate, so waiting workers pick up other screen chunks
+    // while theirs runs; every seeded search must still screen everything and agree
+    ThreadPool workers(4);
+    OptimizerOptions exits;
+    exits.top = 5;
+    exits.survivors = 1000000;
+    exits.simulation.paths = 2000;
+    exits.simulation.seed = 3;
+    exits.simulation.takeProfit = 5.0;
+    exits.simulation.pool = &workers;
+    StrategySearchSpace wide = space;
+    wide.expiryDays = {20.0, 40.0};
+    OptimizerSummary exitRun = StrategyOptimizer::search(wide, spot, target, targetDays, r, volModel, mu, sigma, exits);
+    bool reentrant = exitRun.screened == exitRun.feasible && exitRun.ranked.size() == exits.top;
+    for (int repeat = 0; repeat < 2 && reentrant; ++repeat) {
+        OptimizerSummary again = StrategyOptimizer::search(wide, spot, target, targetDays, r, volModel, mu, sigma, exits);
+        reentrant = again.screened == exitRun.screened && again.ranked.size() == exitRun.ranked.size();
+        for (std::size_t i = 0; reentrant && i < again.ranked.size(); ++i)
+            reentrant = again.ranked[i].evaluation.strategyName == exitRun.ranked[i].evaluation.strategyName && again.ranked[i].score == exitRun.ranked[i].score;
+    }
+
+    Strategy calendar = Strategy::calendarSpread(100.0, 0.1, 0.2, OptionType::Put);
+    bool calendarLegs = calendar.getLegs().size() == 2 && calendar.getLegs()[0].quantity == -1 && calendar.getLegs()[1].option.getTimeToExpiry() == 0.2;
+
+    if (consistent && enumerated && reentrant && calendarLegs) {
+        std::cout << "[PASS] Strategy optimizer ranks every candidate in the grid consistently." << "\n";
+    } else {
+        std::cout << "[FAIL] Strategy Optimizer (consistent: " << consistent << ", candidates: " << all.candidates << ", re-entrant: " << reentrant << ", calendar: " << calendarLegs << ")" << "\n";
+    }
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/SviVolatility.h"
+
+// Quotes priced off a known SSVI surface (power-law phi) at the given spot
+struct SviTestChain {
+    std::vector<double> strikes, expiries, spots, rates, prices;
+    std::vector<OptionType> types;
+
+    SviTestChain(const std::vector<SviSlice>& truth, double spot, double elapsed, std::size_t perExpiry) {
+        SviVolatility surface(truth);
+        for (const SviSlice& slice : truth) {
+            const double T = slice.expiry - elapsed;
+            const double width = 3.0 * std::sqrt(slice.theta);
+            for (std::size_t j = 0; j < perExpiry; ++j) {
+                const double K = 100.0 * std::exp(-width + 2.0 * width * static_cast<double>(j) / static_cast<double>(perExpiry - 1));
+                const OptionType type = K < spot ? OptionType::Put : OptionType::Call;
+                strikes.push_back(K);
+                expiries.push_back(T);
+                spots.push_back(spot);
+                rates.push_back(0.03);
+                types.push_back(type);
+                prices.push_back(BlackScholes::calculatePremium(K, T, type, spot, 0.03, surface.getVol(K, T, spot)).value_or(0.0));
+            }
+        }
+    }
+    [[nodiscard]] QuoteInputs quotes() const { return {strikes, expiries, types, spots, rates, prices}; }
+};
+
+inline std::vector<SviSlice> sviTestSurface(std::size_t expiryCount) {
+    std::vector<SviSlice> truth;
+    for (std::size_t i = 0; i < expiryCount; ++i) {
+        const double T = 0.05 + 1.95 * static_cast<double>(i) / static_cast<double>(expiryCount - 1);
+        const double theta = 0.2 * 0.2 * T + 0.002 * std::sqrt(T);
+        const double psi = 1.2 * std::pow(theta, 0.6) * std::pow(1.0 + theta, -0.6);
+        truth.push_back({T, theta, -0.4, psi});
+    }
+    return truth;
+}
+
+inline void runSviCalibrationTest() {
+
+    std::vector<SviSlice> truth = sviTestSurface(8);
+    SviTestChain chain(truth, 100.0, 0.0, 41);
+    SviCalibration cold = SviCalibrator::calibrate(chain.quotes());
+
+    // the fit recovers the generating parameters and stays arbitrage-free
+    bool recovered = cold.surface.slices().size() == truth.size() && cold.surface.calendarCrossings() == 0;
+    int coldIterations = 0;
+    for (std::size_t i = 0; recovered && i < truth.size(); ++i) {
+        const SviSlice& fit = cold.surface.slices()[i];
+        recovered = std::abs(fit.theta / truth[i].theta - 1.0) < 1e-6 && std::abs(fit.rho - truth[i].rho) < 1e-5
+                    && std::abs(fit.psi / truth[i].psi - 1.0) < 1e-5 && fit.butterflyFree() && cold.fits[i].rmsError < 1e-7;
+        coldIterations += cold.fits[i].iterations;
+    }
+
+    // half an hour later the spot has moved; the refit starts from the previous surface
+    const double elapsed = 0.5 / (252.0 * 6.5);
+    SviTestChain later(truth, 100.4, elapsed, 41);
+    SviCalibration warm = SviCalibrator::calibrate(later.quotes(), &cold.surface);
+    int warmIterations = 0;
+    double warmError = 0.0;
+    for (const SviSliceFit& fit : warm.fits) {
+        warmIterations += fit.iterations;
+        warmError = std::max(warmError, fit.rmsError);
+    }
+    bool warmOk = warm.fits.size() == truth.size() && warmIterations < coldIterations && warmError < 1e-3;
+
+    if (recovered && warmOk) {
+        std::cout << "[PASS] SSVI calibration recovers the surface and warm-starts refits." << "\n";
+    } else {
+        std::cout << "[FAIL] SSVI calibration (recovered " << recovered << ", iterations cold " << coldIterations
+                  << " warm " << warmIterations << ", warm rms " << warmError << ")" << "\n";
+    }
+}
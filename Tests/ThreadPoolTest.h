@@ -0,0 +1,43 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include "../Headers/ThreadPool.h"
+
+inline void runThreadPoolTest() {
+
+    ThreadPool pool(4);
+
+    // every index runs exactly once
+    std::vector<std::atomic<int>> hits(10000);
+    pool.parallelFor(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+    bool allOnce = true;
+    for (const std::atomic<int>& h : hits) allOnce = allOnce && h.load() == 1;
+
+    // nested calls finish because waiting callers run queued work
+    std::atomic<int> nested{0};
+    pool.parallelFor(16, [&](std::size_t) {
+        pool.parallelFor(16, [&](std::size_t) { nested.fetch_add(1); });
+    });
+
+    // the first exception reaches the caller and the pool keeps working afterwards
+    bool rethrown = false;
+    try {
+        pool.parallelFor(64, [](std::size_t i) { if (i == 17) throw std::runtime_error("task failed"); });
+    } catch (const std::runtime_error&) {
+        rethrown = true;
+    }
+    std::atomic<int> after{0};
+    pool.parallelFor(8, [&](std::size_t) { after.fetch_add(1); });
+
+    ThreadPoolStats stats = pool.stats();
+    bool statsConsistent = stats.workers == 4 && stats.queued == 0 && stats.executed == 10000 + 16 + 256 + 64 + 8;
+
+    if (allOnce && nested == 256 && rethrown && after == 8 && statsConsistent) {
+        std::cout << "[PASS] Thread pool runs every task once, nests and propagates errors." << "\n";
+    } else {
+        std::cout << "[FAIL] Thread pool (nested " << nested << ", rethrown " << rethrown
+                  << ", executed " << stats.executed << ")" << "\n";
+    }
+}
@@ -0,0 +1,79 @@
+#pragma once
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <sstream>
+#include <vector>
+#include "../Headers/TickReplay.h"
+#include "../Headers/BlackScholes.h"
+#include "../Headers/ScenarioRunner.h"
+
+inline void runTickRepricerTest() {
+
+    const double spot0 = 100.0, r = 0.05;
+    ParametricVolatility volModel(0.25, -0.3, 1.5);
+    std::vector<Strategy> strategies = ScenarioRunner::strategies(spot0, 30.0);
+    strategies.push_back(Strategy::strangle(90.0, 115.0, 0.4));
+    TickRepricer repricer(strategies, spot0, r, volModel);
+
+    // every leg against a fresh BlackScholes::calculate at the vol it was set up with
+    auto checkAt = [&](double spot) {
+        const Greeks& net = repricer.onTick(spot);
+        Greeks expected{};
+        double worst = 0.0;
+        std::size_t index = 0;
+        for (const Strategy& strategy : strategies)
+            for (const StrategyLeg& leg : strategy.getLegs()) {
+                const double K = leg.option.getStrike(), T = leg.option.getTimeToExpiry();
+                FlatVolatility sticky(volModel.getVol(K, T, spot0));
+                std::optional<Greeks> g = BlackScholes::calculate(K, T, leg.option.getType(), spot, r, sticky);
+                const Greeks fast = repricer.leg(index++);
+                worst = std::max({worst, std::abs(fast.premium - g->premium), std::abs(fast.delta - g->delta), std::abs(fast.gamma - g->gamma),
+                                  std::abs(fast.theta - g->theta), std::abs(fast.vega - g->vega), std::abs(fast.rho - g->rho)});
+                expected.premium += leg.quantity * g->premium;
+                expected.delta += leg.quantity * g->delta;
+                expected.rho += leg.quantity * g->rho;
+            }
+        worst = std::max({worst, std::abs(net.premium - expected.premium), std::abs(net.delta - expected.delta), std::abs(net.rho - expected.rho)});
+        return worst;
+    };
+    double legError = 0.0;
+    for (double spot : {100.0, 92.5, 108.0, 100.01, 70.0, 140.0}) legError = std::max(legError, checkAt(spot));
+
+    // replay: header with time, then bare spots; the final state matches a direct tick
+    std::istringstream withHeader("time,spot\n0.001,100.5\n0.002,100.25\n\n0.003,99.75\n");
+    std::istringstream bare("101\n102.5\n");
+    std::vector<Tick> ticks = TickReplay::read(withHeader);
+    std::vector<Tick> bareTicks = TickReplay::read(bare);
+    bool parsed = ticks.size() == 3 && ticks[2].time == 0.003 && ticks[2].spot == 99.75 && bareTicks.size() == 2 && bareTicks[1].spot == 102.5;
+
+    std::vector<Tick> walk;
+    double spot = spot0;
+    for (int i = 0; i < 20000; ++i) {
+        spot *= 1.0 + 0.0005 * std::sin(0.37 * i);
+        walk.push_back({static_cast<double>(i), spot});
+    }
+    LatencyReport report = TickReplay::replay(repricer, walk);
+    const double lastDelta = repricer.net().delta;
+    TickRepricer fresh(strategies, spot0, r, volModel);
+    bool replayed = report.ticks == walk.size() && std::accumulate(report.histogram.begin(), report.histogram.end(), std::size_t{0}) == walk.size()
+                    && report.p50Ns <= report.p99Ns && report.p99Ns <= report.p999Ns && report.p999Ns <= report.maxNs
+                    && std::abs(fresh.onTick(walk.back().spot).delta - lastDelta) < 1e-12;
+
+    bool rejected = true;
+    for (const char* text : {"spot\n100\n-3\n", "time,spot\n0.5,100\n1.0x,101\n"}) {
+        try {
+            std::istringstream bad(text);
+            TickReplay::read(bad);
+            rejected = false;
+        } catch (const std::invalid_argument&) {
+        }
+    }
+
+    if (legError < 1e-10 && parsed && replayed && rejected) {
+        std::cout << "[PASS] Tick repricer matches full pricing on every tick and replays tick files." << "\n";
+    } else {
+        std::cout << "[FAIL] Tick Repricer (max error: " << legError << ", parsed: " << parsed << ", replayed: " << replayed << ", rejected: " << rejected << ")" << "\n";
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <iostream>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "../Headers/BlackScholes.h"
+#include "../Headers/OptionWizard.h"
+#include "../Headers/Random.h"
+#include "../Headers/Strategy.h"
+#include "../Headers/VolatilitySurface.h"
+
+inline void runVarianceReductionTest() {
+
+    // the first 2^k scrambled Sobol points fall one in each of 2^k strata
+    std::vector<int> strata(1024, 0);
+    for (std::uint32_t i = 0; i < 1024; ++i)
+        strata[SobolNormalGenerator::point(i, 0x5eed1234u) >> 22]++;
+    bool stratified = std::all_of(strata.begin(), strata.end(), [](int c) { return c == 1; });
+
+    double inverseError = 0.0;
+    for (double p : {1e-12, 1e-6, 0.01, 0.02425, 0.3, 0.5, 0.77, 0.999, 1.0 - 1e-9}) {
+        double x = SobolNormalGenerator::inverseNormalCDF(p);
+        inverseError = std::max(inverseError, std::abs(0.5 * std::erfc(-x / std::sqrt(2.0)) - p) / std::min(p, 1.0 - p));
+    }
+
+    // a long call valued half way to expiry: with mu = r its discounted expected value is the
+    // Black-Scholes price today
+    double S = 100.0, K = 100.0, T = 1.0, r = 0.05, sigma = 0.2;
+    double horizon = 0.5;
+    double bsPrice = BlackScholes::calculatePremium(K, T, OptionType::Call, S, r, sigma).value_or(0.0);
+    Strategy call = Strategy::longCall(K, T);
+    ParametricVolatility volModel(sigma, 0.0, 0.0);
+
+    SimulationOptions plain;
+    plain.paths = 20000;
+    plain.seed = 3;
+    SimulationOptions controlled = plain;
+    controlled.controlVariates = true;
+    SimulationOptions sobol = plain;
+    sobol.quasiRandom = true;
+
+    auto presentValue = [&](const result& res) { return res.expectedValue * std::exp(-r * horizon); };
+    result base = OptionWizard::simulateStrategy(call, S, S, horizon * gbl::TRADING_DAYS, r, volModel, r, sigma, plain);
+    result cv = OptionWizard::simulateStrategy(call, S, S, horizon * gbl::TRADING_DAYS, r, volModel, r, sigma, controlled);
+    result qmc = OptionWizard::simulateStrategy(call, S, S, horizon * gbl::TRADING_DAYS, r, volModel, r, sigma, sobol);
+
+    bool cvAccurate = std::abs(presentValue(cv) - bsPrice) < 4.0 * cv.expectedValueStdError + 1e-9
+                      && cv.expectedValueStdError < base.expectedValueStdError / 5.0;
+    bool qmcAccurate = std::abs(presentValue(qmc) - bsPrice) < 0.01;
+
+    if (stratified && inverseError < 1e-12 && cvAccurate && qmcAccurate) {
+        std::cout << "[PASS] Sobol and control-variate modes are unbiased and tighter." << "\n";
+    } else {
+        std::cout << "[FAIL] Variance reduction (stratified " << stratified << ", inverse error " << inverseError
+                  << ", CV " << presentValue(cv) << " +/- " << cv.expectedValueStdError
+                  << ", Sobol " << presentValue(qmc) << " vs " << bsPrice << ")" << "\n";
+    }
+}
@@ -0,0 +1,168 @@
+#include "Headers/ThreadPool.h"
+#include <exception>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+
+// Tells each worker thread which queue is its own; callers outside the pool have none
+thread_local std::size_t homeQueue = SIZE_MAX;
+thread_local const ThreadPool* homePool = nullptr;
+
+}
+
+ThreadPool::ThreadPool(unsigned threads, bool pinThreads) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+    for (unsigned i = 0; i < threads; ++i)
+        workers_.push_back(std::make_unique<Worker>());
+    for (unsigned i = 0; i < threads; ++i) {
+        threads_.emplace_back(&ThreadPool::workerLoop, this, i);
+#ifdef __linux__
+        if (pinThreads) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(i % std::max(1u, std::thread::hardware_concurrency()), &cpus);
+            pthread_setaffinity_np(threads_.back().native_handle(), sizeof(cpus), &cpus);
+        }
+#else
+        (void)pinThreads;
+#endif
+    }
+}
+
+std::size_t ThreadPool::currentWorker() const {
+    return homePool == this ? homeQueue : workers_.size();
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : threads_) t.join();
+}
+
+bool ThreadPool::tryRun(std::size_t home) {
+    const std::size_t n = workers_.size();
+    Task task;
+    bool found = false;
+
+    if (home < n) {
+        Worker& own = *workers_[home];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.queue.empty()) {
+            task = std::move(own.queue.back());
+            own.queue.pop_back();
+            found = true;
+        }
+    }
+
+    const std::size_t start = home < n ? home + 1 : 0;
+    for (std::size_t k = 0; k < n && !found; ++k) {
+        const std::size_t victim = (start + k) % n;
+        if (victim == home) continue;
+        Worker& other = *workers_[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.queue.empty()) {
+            task = std::move(other.queue.front());
+            other.queue.pop_front();
+            found = true;
+            if (home < n) workers_[home]->steals.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    if (!found) return false;
+    // counted before running: once the task finishes its parallelFor may already have returned
+    pending_.fetch_sub(1, std::memory_order_relaxed);
+    if (home < n) workers_[home]->executed.fetch_add(1, std::memory_order_relaxed);
+    else callerExecuted_.fetch_add(1, std::memory_order_relaxed);
+    task.run();
+    return true;
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    homeQueue = index;
+    homePool = this;
+    while (true) {
+        if (tryRun(index)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex_);
+        wake_.wait(lock, [&] { return stopping_ || pending_.load(std::memory_order_relaxed) > 0; });
+        if (stopping_ && pending_.load(std::memory_order_relaxed) == 0) return;
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+    if (count == 0) return;
+
+    struct Group {
+        std::atomic<std::size_t> remaining;
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    } group;
+    group.remaining = count;
+
+    // deal the indices round-robin so every queue starts with a share to steal from
+    const std::size_t n = workers_.size();
+    const std::size_t first = nextQueue_.fetch_add(1, std::memory_order_relaxed);
+    for (std::size_t i = 0; i < count; ++i) {
+        Worker& target = *workers_[(first + i) % n];
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.queue.push_back({[&group, &body, i]() {
+            try {
+                body(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> errorLock(group.mutex);
+                if (!group.error) group.error = std::current_exception();
+            }
+            // decrement under the lock: the caller may destroy the group as soon as it sees zero
+            std::lock_guard<std::mutex> doneLock(group.mutex);
+            if (group.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                group.finished.notify_all();
+        }});
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        pending_.fetch_add(count, std::memory_order_relaxed);
+    }
+    wake_.notify_all();
+
+    // help out until the last index is done; a worker of another pool helps as a plain caller
+    const std::size_t home = currentWorker();
+    while (group.remaining.load(std::memory_order_acquire) > 0) {
+        if (tryRun(home)) continue;
+        std::unique_lock<std::mutex> lock(group.mutex);
+        group.finished.wait_for(lock, std::chrono::microseconds(200),
+                                [&] { return group.remaining.load(std::memory_order_acquire) == 0; });
+    }
+
+    std::lock_guard<std::mutex> lock(group.mutex);
+    if (group.error) std::rethrow_exception(group.error);
+}
+
+ThreadPoolStats ThreadPool::stats() const {
+    ThreadPoolStats s{workers_.size(), 0, callerExecuted_.load(std::memory_order_relaxed), 0};
+    for (const std::unique_ptr<Worker>& w : workers_) {
+        {
+            std::lock_guard<std::mutex> lock(w->mutex);
+            s.queued += w->queue.size();
+        }
+        s.executed += w->executed.load(std::memory_order_relaxed);
+        s.steals += w->steals.load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+ThreadPool& ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,109 @@
+#include "Headers/TickReplay.h"
+#include "Headers/CsvRecords.h"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <istream>
+#include <stdexcept>
+
+namespace {
+
+// A whole cell as a finite number, positive if required; throws std::invalid_argument naming
+// the field and line otherwise
+double toNumber(const std::string& text, const char* field, bool positive, std::size_t lineNumber) {
+    std::size_t used = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &used);
+    } catch (const std::exception&) {
+        used = 0;
+    }
+    if (used != text.size() || !std::isfinite(value) || (positive && !(value > 0)))
+        throw std::invalid_argument(std::string("ERROR: Bad ") + field + " on line " + std::to_string(lineNumber) + ": " + text);
+    return value;
+}
+
+// Nearest-rank percentile of sorted samples: the ceil(p n)-th smallest
+double percentile(const std::vector<std::uint64_t>& sorted, double p) {
+    const double rank = std::ceil(p * static_cast<double>(sorted.size()));
+    const std::size_t index = rank < 1.0 ? 0 : static_cast<std::size_t>(rank) - 1;
+    return static_cast<double>(sorted[std::min(index, sorted.size() - 1)]);
+}
+
+}
+
+std::vector<Tick> TickReplay::read(std::istream& in) {
+    std::vector<Tick> ticks;
+    std::size_t spotColumn = 0, timeColumn = std::string::npos;
+    bool first = true;
+    std::size_t lineNumber = 0;
+    for (std::string line; std::getline(in, line);) {
+        ++lineNumber;
+        if (csv::trim(line).empty()) continue;
+        std::vector<std::string> cells = csv::split(line);
+        if (first) {
+            first = false;
+            std::size_t spot = csv::column(cells, "spot");
+            if (spot == std::string::npos) spot = csv::column(cells, "price");
+            if (spot != std::string::npos) {
+                spotColumn = spot;
+                timeColumn = csv::column(cells, "time");
+                continue;
+            }
+            if (cells.size() != 1) throw std::invalid_argument("ERROR: Tick file header needs a spot or price column");
+        }
+        if (spotColumn >= cells.size()) throw std::invalid_argument("ERROR: Missing spot on line " + std::to_string(lineNumber));
+        const double time = timeColumn < cells.size() ? toNumber(cells[timeColumn], "time", false, lineNumber) : static_cast<double>(ticks.size());
+        ticks.push_back({time, toNumber(cells[spotColumn], "spot", true, lineNumber)});
+    }
+    return ticks;
+}
+
+LatencyReport TickReplay::replay(TickRepricer& repricer, std::span<const Tick> ticks) {
+    LatencyReport report;
+    if (ticks.empty()) return report;
+
+    std::vector<std::uint64_t> samples(ticks.size());
+    volatile double sink = 0.0;
+    for (std::size_t i = 0; i < ticks.size(); ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        const Greeks& net = repricer.onTick(ticks[i].spot);
+        const auto end = std::chrono::steady_clock::now();
+        sink = sink + net.delta;
+        samples[i] = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    }
+
+    report.ticks = ticks.size();
+    double total = 0.0;
+    for (std::uint64_t ns : samples) {
+        total += static_cast<double>(ns);
+        const std::size_t bucket = ns == 0 ? 0 : static_cast<std::size_t>(std::bit_width(ns) - 1);
+        if (bucket >= report.histogram.size()) report.histogram.resize(bucket + 1, 0);
+        ++report.histogram[bucket];
+    }
+    std::sort(samples.begin(), samples.end());
+    report.meanNs = total / static_cast<double>(samples.size());
+    report.p50Ns = percentile(samples, 0.50);
+    report.p99Ns = percentile(samples, 0.99);
+    report.p999Ns = percentile(samples, 0.999);
+    report.maxNs = static_cast<double>(samples.back());
+    return report;
+}
+
+std::string LatencyReport::toString() const {
+    char line[160];
+    std::snprintf(line, sizeof(line), "%zu ticks  mean %.0f ns  p50 %.0f ns  p99 %.0f ns  p99.9 %.0f ns  max %.0f ns\n",
+                  ticks, meanNs, p50Ns, p99Ns, p999Ns, maxNs);
+    std::string out = line;
+    for (std::size_t b = 0; b < histogram.size(); ++b) {
+        if (histogram[b] == 0) continue;
+        std::snprintf(line, sizeof(line), "  %10llu - %-10llu ns  %10zu  %6.2f%%\n", b == 0 ? 0ULL : 1ULL << b, (2ULL << b) - 1, histogram[b],
+                      100.0 * static_cast<double>(histogram[b]) / static_cast<double>(ticks));
+        out += line;
+    }
+    return out;
+}
@@ -0,0 +1,101 @@
+#include "Headers/TickRepricer.h"
+#include "Headers/PricingKernel.h"
+#include "Headers/Simd.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+std::vector<BookPosition> positionsOf(const std::vector<Strategy>& strategies) {
+    std::vector<BookPosition> positions;
+    for (const Strategy& strategy : strategies)
+        for (const StrategyLeg& leg : strategy.getLegs())
+            positions.push_back({leg.option.getStrike(), leg.option.getTimeToExpiry(), leg.option.getType(), static_cast<double>(leg.quantity)});
+    return positions;
+}
+
+}
+
+TickRepricer::TickRepricer(std::span<const BookPosition> positions, double spot, double r, const IVolatilitySurface& volSurface)
+    : legs_(positions.size()), r_(r), spot_(spot), volSurface_(volSurface) {
+    if (!(spot > 0)) throw std::invalid_argument("ERROR: Spot must be positive");
+    const std::size_t width = simd::NativeD::width;
+    resize((legs_ + width - 1) / width * width);
+    for (std::size_t i = 0; i < legs_; ++i) {
+        const BookPosition& position = positions[i];
+        if (!(position.strike > 0) || !(position.expiry > 0)) throw std::invalid_argument("ERROR: Legs need a positive strike and expiry");
+        strikes_[i] = position.strike;
+        expiries_[i] = position.expiry;
+        quantities_[i] = position.quantity;
+        isCall_[i] = position.type == OptionType::Call ? 1.0 : 0.0;
+    }
+    refreshVols();
+}
+
+TickRepricer::TickRepricer(const std::vector<Strategy>& strategies, double spot, double r, const IVolatilitySurface& volSurface)
+    : TickRepricer(positionsOf(strategies), spot, r, volSurface) {}
+
+void TickRepricer::resize(std::size_t padded) {
+    for (std::vector<double>* column : {&strikes_, &expiries_, &quantities_, &isCall_, &logK_, &sqrtT_, &sigma_, &sigmaSqrtT_, &discountedK_,
+                                        &premium_, &delta_, &gamma_, &theta_, &vega_, &rho_})
+        column->assign(padded, 0.0);
+    // padding lanes price a harmless unit option with zero quantity
+    for (std::size_t i = legs_; i < padded; ++i) strikes_[i] = expiries_[i] = sigma_[i] = 1.0;
+}
+
+void TickRepricer::precompute() {
+    for (std::size_t i = 0; i < strikes_.size(); ++i) {
+        const double K = strikes_[i], T = expiries_[i], sigma = sigma_[i];
+        logK_[i] = std::log(K);
+        sqrtT_[i] = std::sqrt(T);
+        sigmaSqrtT_[i] = sigma * sqrtT_[i];
+        discountedK_[i] = K * std::exp(-r_ * T);
+    }
+}
+
+const Greeks& TickRepricer::refreshVols() {
+    std::span<double> vols = std::span<double>(sigma_).first(legs_);
+    volSurface_.getVols(std::span<const double>(strikes_).first(legs_), std::span<const double>(expiries_).first(legs_), spot_, vols);
+    for (double& sigma : vols) sigma = std::max(sigma, 1e-4);
+    precompute();
+    return onTick(spot_);
+}
+
+const Greeks& TickRepricer::onTick(double spot) {
+    using V = simd::NativeD;
+    if (!(spot > 0)) throw std::invalid_argument("ERROR: Spot must be positive");
+    spot_ = spot;
+    const V S = V::broadcast(spot);
+    const V logS = V::broadcast(std::log(spot));
+    const V r = V::broadcast(r_), half = V::broadcast(0.5);
+
+    for (std::size_t i = 0; i < strikes_.size(); i += V::width) {
+        const GreeksOf<V> g = blackScholesKernel<greek::All>(half < V::load(&isCall_[i]), S, logS - V::load(&logK_[i]), V::load(&expiries_[i]),
+                                                             V::load(&sqrtT_[i]), r, V::load(&sigma_[i]), V::load(&sigmaSqrtT_[i]),
+                                                             V::load(&discountedK_[i]));
+        g.premium.store(&premium_[i]);
+        g.delta.store(&delta_[i]);
+        g.gamma.store(&gamma_[i]);
+        g.theta.store(&theta_[i]);
+        g.vega.store(&vega_[i]);
+        g.rho.store(&rho_[i]);
+    }
+
+    net_ = {};
+    for (std::size_t i = 0; i < legs_; ++i) {
+        const double q = quantities_[i];
+        net_.premium += q * premium_[i];
+        net_.delta += q * delta_[i];
+        net_.gamma += q * gamma_[i];
+        net_.theta += q * theta_[i];
+        net_.vega += q * vega_[i];
+        net_.rho += q * rho_[i];
+    }
+    return net_;
+}
+
+Greeks TickRepricer::leg(std::size_t index) const {
+    if (index >= legs_) throw std::out_of_range("ERROR: Leg index out of range");
+    return {premium_[index], delta_[index], gamma_[index], theta_[index], vega_[index], rho_[index]};
+}
@@ -1,11 +1,41 @@
 #include "Headers/VolatilitySurface.h"
 #include <cmath>
 #include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+namespace {
+
+void checkBatch(std::size_t inputs, std::size_t second, std::size_t outputs) {
+    if (second != inputs || outputs != inputs) throw std::invalid_argument("ERROR: volatility batch sizes differ");
+}
+
+}
+
+void IVolatilitySurface::getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const {
+    checkBatch(strikes.size(), expiries.size(), out.size());
+    for (std::size_t i = 0; i < strikes.size(); ++i) out[i] = getVol(strikes[i], expiries[i], spot);
+}
+
+void IVolatilitySurface::getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const {
+    checkBatch(spots.size(), spots.size(), out.size());
+    for (std::size_t i = 0; i < spots.size(); ++i) out[i] = getVol(strike, timeToExpiry, spots[i]);
+}
+
+void FlatVolatility::getVols(std::span<const double> strikes, std::span<const double> expiries, double /*spot*/, std::span<double> out) const {
+    checkBatch(strikes.size(), expiries.size(), out.size());
+    std::fill(out.begin(), out.end(), sigma_);
+}
+
+void FlatVolatility::getPathVols(double /*strike*/, double /*timeToExpiry*/, std::span<const double> spots, std::span<double> out) const {
+    checkBatch(spots.size(), spots.size(), out.size());
+    std::fill(out.begin(), out.end(), sigma_);
+}
 
 ParametricVolatility::ParametricVolatility(double atmVol, double slope, double convexity)
         : atmVol_(atmVol), slope_(slope), convexity_(convexity) {}
 
-double ParametricVolatility::getVol(double strike, double timeToExpiry, double spot) const {
+double ParametricVolatility::smileAt(double strike, double timeToExpiry, double spot) const {
     if (spot <= 0.0 || strike <= 0.0 || timeToExpiry <= 0.0)
         return atmVol_;
 
@@ -19,3 +49,168 @@ double ParametricVolatility::getVol(double strike, double timeToExpiry, double s
 
     return std::max(0.01, vol); // no negative vol
 }
+
+double ParametricVolatility::getVol(double strike, double timeToExpiry, double spot) const {
+    return smileAt(strike, timeToExpiry, spot);
+}
+
+void ParametricVolatility::getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const {
+    checkBatch(strikes.size(), expiries.size(), out.size());
+    for (std::size_t i = 0; i < strikes.size(); ++i) out[i] = smileAt(strikes[i], expiries[i], spot);
+}
+
+void ParametricVolatility::getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const {
+    checkBatch(spots.size(), spots.size(), out.size());
+    for (std::size_t i = 0; i < spots.size(); ++i) out[i] = smileAt(strike, timeToExpiry, spots[i]);
+}
+
+GridVolatility::GridVolatility(std::vector<double> logMoneyness, std::vector<double> expiries, std::vector<double> vols,
+                               GridInterpolation interpolation, std::optional<double> referenceSpot)
+        : logMoneyness_(std::move(logMoneyness)), expiries_(std::move(expiries)), vols_(std::move(vols)),
+          interpolation_(interpolation), referenceSpot_(referenceSpot) {
+    const std::size_t cols = logMoneyness_.size();
+    if (cols < 2 || expiries_.empty() || vols_.size() != cols * expiries_.size())
+        throw std::invalid_argument("ERROR: GridVolatility needs 2+ moneyness nodes, 1+ expiries and one vol per node");
+    if (!std::is_sorted(logMoneyness_.begin(), logMoneyness_.end(), std::less_equal<>())
+        || !std::is_sorted(expiries_.begin(), expiries_.end(), std::less_equal<>()) || !(expiries_.front() > 0.0))
+        throw std::invalid_argument("ERROR: GridVolatility nodes must be strictly increasing with positive expiries");
+    if (!std::all_of(vols_.begin(), vols_.end(), [](double v) { return v > 0.0 && std::isfinite(v); }))
+        throw std::invalid_argument("ERROR: GridVolatility vols must be positive");
+    if (referenceSpot_ && !(*referenceSpot_ > 0.0))
+        throw std::invalid_argument("ERROR: GridVolatility reference spot must be positive");
+
+    // evenly spaced nodes (the usual case) locate their cell without a search
+    const double spacing = (logMoneyness_.back() - logMoneyness_.front()) / static_cast<double>(cols - 1);
+    bool uniform = true;
+    for (std::size_t k = 0; k < cols; ++k)
+        uniform = uniform && std::abs(logMoneyness_[k] - (logMoneyness_.front() + spacing * static_cast<double>(k))) <= 1e-12 * spacing;
+    inverseStep_ = uniform ? 1.0 / spacing : 0.0;
+
+    if (interpolation_ != GridInterpolation::MonotoneCubic) return;
+
+    // Fritsch-Carlson: zero slope at local extrema, weighted harmonic mean of the secants elsewhere
+    slopes_.resize(vols_.size());
+    for (std::size_t row = 0; row < expiries_.size(); ++row) {
+        const double* v = &vols_[row * cols];
+        double* d = &slopes_[row * cols];
+        auto secant = [&](std::size_t k) { return (v[k + 1] - v[k]) / (logMoneyness_[k + 1] - logMoneyness_[k]); };
+        d[0] = secant(0);
+        d[cols - 1] = secant(cols - 2);
+        for (std::size_t k = 1; k + 1 < cols; ++k) {
+            const double left = secant(k - 1), right = secant(k);
+            if (left * right <= 0.0) {
+                d[k] = 0.0;
+                continue;
+            }
+            const double hl = logMoneyness_[k] - logMoneyness_[k - 1];
+            const double hr = logMoneyness_[k + 1] - logMoneyness_[k];
+            const double wl = 2.0 * hr + hl, wr = hr + 2.0 * hl;
+            d[k] = (wl + wr) / (wl / left + wr / right);
+        }
+    }
+}
+
+GridVolatility GridVolatility::fromQuotes(const QuoteInputs& quotes, std::vector<double> logMoneyness,
+                                          GridInterpolation interpolation, std::optional<double> referenceSpot) {
+    const std::size_t n = quotes.strikes.size();
+    std::vector<double> vols(n);
+    std::vector<IVStatus> status(n);
+    ImpliedVolatility::solveBatch(quotes, vols, status);
+
+    // (expiry, log-moneyness, vol) of every converged quote
+    std::vector<std::tuple<double, double, double>> solved;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (status[i] != IVStatus::Converged) continue;
+        const double spot = referenceSpot.value_or(quotes.spots[i]);
+        solved.emplace_back(quotes.expiries[i], std::log(quotes.strikes[i] / spot), vols[i]);
+    }
+    if (solved.empty()) throw std::invalid_argument("ERROR: fromQuotes has no quote that converged");
+    std::sort(solved.begin(), solved.end());
+
+    constexpr double SAME_EXPIRY = 1e-9;
+    std::vector<double> expiries, grid;
+    for (std::size_t begin = 0; begin < solved.size();) {
+        const double T = std::get<0>(solved[begin]);
+        std::size_t end = begin;
+        while (end < solved.size() && std::get<0>(solved[end]) - T <= SAME_EXPIRY) ++end;
+
+        expiries.push_back(T);
+        for (double m : logMoneyness) {
+            auto above = std::find_if(solved.begin() + begin, solved.begin() + end,
+                                      [&](const auto& quote) { return std::get<1>(quote) > m; });
+            double vol = 0.0;
+            if (above == solved.begin() + begin) vol = std::get<2>(*above);
+            else if (above == solved.begin() + end) vol = std::get<2>(*(above - 1));
+            else {
+                const auto& [t0, m0, v0] = *(above - 1);
+                const auto& [t1, m1, v1] = *above;
+                vol = v0 + (v1 - v0) * (m - m0) / (m1 - m0);
+            }
+            grid.push_back(vol);
+        }
+        begin = end;
+    }
+    return GridVolatility(std::move(logMoneyness), std::move(expiries), std::move(grid), interpolation, referenceSpot);
+}
+
+double GridVolatility::rowVol(std::size_t row, double m) const {
+    const std::size_t cols = logMoneyness_.size();
+    const double* v = &vols_[row * cols];
+    if (m <= logMoneyness_.front()) return v[0];
+    if (m >= logMoneyness_.back()) return v[cols - 1];
+
+    std::size_t k = 0;
+    if (inverseStep_ > 0.0) {
+        k = std::min(static_cast<std::size_t>((m - logMoneyness_.front()) * inverseStep_), cols - 2);
+    } else {
+        k = static_cast<std::size_t>(std::upper_bound(logMoneyness_.begin(), logMoneyness_.end(), m) - logMoneyness_.begin()) - 1;
+    }
+    const double h = logMoneyness_[k + 1] - logMoneyness_[k];
+    const double t = (m - logMoneyness_[k]) / h;
+    if (interpolation_ == GridInterpolation::Linear) return v[k] + (v[k + 1] - v[k]) * t;
+
+    // cubic Hermite between the nodes with the precomputed slopes
+    const double* d = &slopes_[row * cols];
+    const double t2 = t * t, t3 = t2 * t;
+    return (2.0 * t3 - 3.0 * t2 + 1.0) * v[k] + (t3 - 2.0 * t2 + t) * h * d[k]
+           + (-2.0 * t3 + 3.0 * t2) * v[k + 1] + (t3 - t2) * h * d[k + 1];
+}
+
+GridVolatility::ExpiryBracket GridVolatility::bracket(double timeToExpiry) const {
+    if (timeToExpiry <= expiries_.front()) return {0, 0, 1.0, 0.0};
+    if (timeToExpiry >= expiries_.back()) return {expiries_.size() - 1, expiries_.size() - 1, 1.0, 0.0};
+
+    // total variance is linear in T between rows: vol^2 = w0 * v0^2 + w1 * v1^2
+    const auto row = static_cast<std::size_t>(std::upper_bound(expiries_.begin(), expiries_.end(), timeToExpiry) - expiries_.begin()) - 1;
+    const double t0 = expiries_[row], t1 = expiries_[row + 1];
+    return {row, row + 1, (t1 - timeToExpiry) * t0 / ((t1 - t0) * timeToExpiry), (timeToExpiry - t0) * t1 / ((t1 - t0) * timeToExpiry)};
+}
+
+double GridVolatility::volAt(double m, const ExpiryBracket& b) const {
+    const double v0 = rowVol(b.lower, m);
+    if (b.lower == b.upper) return v0;
+    const double v1 = rowVol(b.upper, m);
+    return std::sqrt(b.lowerWeight * v0 * v0 + b.upperWeight * v1 * v1);
+}
+
+double GridVolatility::getVol(double strike, double timeToExpiry, double spot) const {
+    const double reference = referenceSpot_.value_or(spot);
+    const double m = (reference > 0.0 && strike > 0.0) ? std::log(strike / reference) : 0.0;
+    return volAt(m, bracket(timeToExpiry));
+}
+
+void GridVolatility::getVols(std::span<const double> strikes, std::span<const double> expiries, double spot, std::span<double> out) const {
+    checkBatch(strikes.size(), expiries.size(), out.size());
+    for (std::size_t i = 0; i < strikes.size(); ++i) out[i] = GridVolatility::getVol(strikes[i], expiries[i], spot);
+}
+
+void GridVolatility::getPathVols(double strike, double timeToExpiry, std::span<const double> spots, std::span<double> out) const {
+    checkBatch(spots.size(), spots.size(), out.size());
+    if (referenceSpot_) {
+        std::fill(out.begin(), out.end(), GridVolatility::getVol(strike, timeToExpiry, *referenceSpot_));
+        return;
+    }
+    const ExpiryBracket b = bracket(timeToExpiry);
+    for (std::size_t i = 0; i < spots.size(); ++i)
+        out[i] = volAt((spots[i] > 0.0 && strike > 0.0) ? std::log(strike / spots[i]) : 0.0, b);
+}
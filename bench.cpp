@@ -0,0 +1,46 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+#include "Benchmarks/BenchmarkSuite.h"
+#include "Benchmarks/BenchmarkReport.h"
+
+// options_bench [--quick] [--trials N] [--json FILE] [--baseline FILE] [--tolerance FRACTION]
+// Runs the benchmark suite, optionally writes the results as JSON and compares them against
+// a stored baseline. Exits with 1 when any figure is worse than the baseline by more than the
+// tolerance (default 0.10).
+int main(int argc, char* argv[]) {
+    BenchmarkSuiteOptions options;
+    std::string jsonPath, baselinePath;
+    double tolerance = 0.10;
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--quick") == 0) options.quick = true;
+        else if (std::strcmp(argv[i], "--trials") == 0 && hasValue) options.trials = std::max(1, std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--json") == 0 && hasValue) jsonPath = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue) baselinePath = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue) tolerance = std::atof(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: %s [--quick] [--trials N] [--json FILE] [--baseline FILE] [--tolerance FRACTION]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    try {
+        BenchmarkReport report = runBenchmarkSuite(options);
+        if (!jsonPath.empty()) report.writeJson(jsonPath);
+        if (!baselinePath.empty()) {
+            printf("\n");
+            BenchmarkComparison summary = report.compare(BenchmarkReport::readJson(baselinePath), tolerance);
+            printf("%zu of %zu benchmarks regressed by more than %.0f%%\n", summary.regressions, summary.compared, 100.0 * tolerance);
+            if (summary.regressions > 0) return 1;
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
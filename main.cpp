@@ -3,16 +3,56 @@
 #include <vector>
 #include <limits>
 #include <cstring>
+#include <cstdlib>
 #include <memory>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <string>
 #include "Headers/Global.h"
 #include "Headers/Option.h"
 #include "Headers/BlackScholes.h"
 #include "Headers/OptionWizard.h"
 #include "Headers/Strategy.h"
 #include "Headers/VolatilitySurface.h"
+#include "Headers/ScenarioRunner.h"
+#include "Headers/ChainFile.h"
+#include "Headers/TickReplay.h"
+#include "Headers/StrategyOptimizer.h"
 #include "Tests/ParityTest.h"
 #include "Tests/FiniteDifferenceTest.h"
 #include "Tests/MonteCarloConvergenceTest.h"
+#include "Tests/BatchPricingTest.h"
+#include "Tests/ImpliedVolatilityTest.h"
+#include "Tests/HorizonInterpolationTest.h"
+#include "Tests/RandomTest.h"
+#include "Tests/ThreadPoolTest.h"
+#include "Tests/SharedPathsTest.h"
+#include "Tests/AdaptiveSimulationTest.h"
+#include "Tests/VarianceReductionTest.h"
+#include "Tests/AnalyticHorizonTest.h"
+#include "Tests/PathEngineTest.h"
+#include "Tests/GridVolatilityTest.h"
+#include "Tests/SviCalibrationTest.h"
+#include "Tests/PricingKernelTest.h"
+#include "Tests/SinglePrecisionTest.h"
+#include "Tests/SimulationStatsTest.h"
+#include "Tests/ScenarioRunnerTest.h"
+#include "Tests/ChainFileTest.h"
+#include "Tests/RiskGridTest.h"
+#include "Tests/PortfolioBookTest.h"
+#include "Tests/TickRepricerTest.h"
+#include "Tests/StrategyOptimizerTest.h"
+#include "Tests/PdeSolverTest.h"
+#include "Tests/PathwiseGreeksTest.h"
+#include "Tests/CompactStrategyTest.h"
+#include "Benchmarks/ImpliedVolBenchmark.h"
+#include "Benchmarks/SimulationBenchmark.h"
+#include "Benchmarks/RandomBenchmark.h"
+#include "Benchmarks/ConvergenceBenchmark.h"
+#include "Benchmarks/CalibrationBenchmark.h"
+#include "Benchmarks/KernelBenchmark.h"
+#include "Benchmarks/PrecisionBenchmark.h"
 #include "UserInterface.h"
 
 
@@ -24,6 +64,159 @@ int main(int argc, char* argv[]) {
         runFiniteDifferenceTest();
         runParityTest();
         runMonteCarloConvergenceTest();
+        runBatchPricingTest();
+        runImpliedVolatilityTest();
+        runHorizonInterpolationTest();
+        runRandomTest();
+        runThreadPoolTest();
+        runSharedPathsTest();
+        runAdaptiveSimulationTest();
+        runVarianceReductionTest();
+        runAnalyticHorizonTest();
+        runPathEngineTest();
+        runGridVolatilityTest();
+        runSviCalibrationTest();
+        runPricingKernelTest();
+        runSinglePrecisionTest();
+        runSimulationStatsTest();
+        runScenarioRunnerTest();
+        runChainFileTest();
+        runRiskGridTest();
+        runPortfolioBookTest();
+        runTickRepricerTest();
+        runStrategyOptimizerTest();
+        runPdeSolverTest();
+        runPathwiseGreeksTest();
+        runCompactStrategyTest();
+        return 0;
+    }
+
+    // Benchmarks
+    if (argc > 1 && std::strcmp(argv[1], "--bench") == 0) {
+        runImpliedVolBenchmark();
+        runSimulationBenchmark();
+        runRandomBenchmark();
+        runConvergenceBenchmark();
+        runCalibrationBenchmark();
+        runKernelBenchmark();
+        runPrecisionBenchmark();
+        return 0;
+    }
+
+    // Batch: --batch <scenarios.csv|.jsonl> [--output <file>] [--paths N] [--seed N]
+    // Evaluates every record and writes one row per strategy, in input order, to the output
+    // file (stdout by default) in the format of its extension. Analytic unless --paths is given.
+    if (argc > 2 && std::strcmp(argv[1], "--batch") == 0) {
+        std::ifstream input(argv[2]);
+        if (!input) {
+            std::cerr << "Cannot open " << argv[2] << std::endl;
+            return 1;
+        }
+        ScenarioRunOptions options;
+        std::string outputPath;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--output") == 0) outputPath = argv[i + 1];
+            else if (std::strcmp(argv[i], "--paths") == 0) {
+                options.simulation.analytic = false;
+                options.simulation.paths = std::atoi(argv[i + 1]);
+            }
+            else if (std::strcmp(argv[i], "--seed") == 0) options.simulation.seed = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        std::ofstream file;
+        if (!outputPath.empty()) file.open(outputPath);
+        std::ostream& output = outputPath.empty() ? std::cout : file;
+        const RecordFormat outputFormat = outputPath.empty() ? ScenarioRunner::formatOf(argv[2]) : ScenarioRunner::formatOf(outputPath);
+
+        auto start = std::chrono::steady_clock::now();
+        ScenarioRunSummary summary = ScenarioRunner::run(input, ScenarioRunner::formatOf(argv[2]), output, outputFormat, options);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cerr << summary.scenarios << " scenarios (" << summary.failed << " failed) in " << seconds << " s, "
+                  << static_cast<double>(summary.scenarios) / seconds << " scenarios/s" << std::endl;
+        return summary.failed == 0 ? 0 : 1;
+    }
+
+    // --convert-chain <quotes.csv> <chain file>: writes the binary columnar chain format
+    if (argc > 3 && std::strcmp(argv[1], "--convert-chain") == 0) {
+        std::ifstream input(argv[2]);
+        if (!input) {
+            std::cerr << "Cannot open " << argv[2] << std::endl;
+            return 1;
+        }
+        try {
+            std::size_t quotes = ChainFile::convertCsv(input, argv[3]);
+            std::cerr << quotes << " quotes written to " << argv[3] << std::endl;
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // --replay <ticks.csv> [--expiry-days N] [--vol v]: reprices the default strategy set, struck
+    // at the first tick, on every tick and prints the tick-to-Greeks latency histogram
+    if (argc > 2 && std::strcmp(argv[1], "--replay") == 0) {
+        std::ifstream input(argv[2]);
+        if (!input) {
+            std::cerr << "Cannot open " << argv[2] << std::endl;
+            return 1;
+        }
+        double expiryDays = 30.0, vol = 0.30;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--expiry-days") == 0) expiryDays = std::atof(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--vol") == 0) vol = std::atof(argv[i + 1]);
+        }
+        try {
+            std::vector<Tick> ticks = TickReplay::read(input);
+            if (ticks.empty()) throw std::invalid_argument("ERROR: No ticks in " + std::string(argv[2]));
+            ParametricVolatility volModel(vol, -0.2, 1.0);
+            TickRepricer repricer(ScenarioRunner::strategies(ticks.front().spot, expiryDays), ticks.front().spot, 0.05, volModel);
+            LatencyReport report = TickReplay::replay(repricer, ticks);
+            std::cout << repricer.size() << " legs\n" << report.toString();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // --optimize <spot> <target> <targetDays> [--rank ev|pop|ror] [--max-cost X] [--max-loss X]
+    // [--min-pop P] [--vol v] [--paths N]: searches spreads, straddles, strangles, condors and
+    // calendars on strikes 80-120% of spot and expiries 1-3x the horizon
+    if (argc > 4 && std::strcmp(argv[1], "--optimize") == 0) {
+        const double spot = std::atof(argv[2]), target = std::atof(argv[3]), targetDays = std::atof(argv[4]);
+        double vol = 0.30;
+        OptimizerOptions options;
+        for (int i = 5; i + 1 < argc; i += 2) {
+            if (std::strcmp(argv[i], "--rank") == 0) {
+                if (std::strcmp(argv[i + 1], "pop") == 0) options.rankBy = RankBy::Pop;
+                else if (std::strcmp(argv[i + 1], "ror") == 0) options.rankBy = RankBy::ReturnOnRisk;
+            }
+            else if (std::strcmp(argv[i], "--max-cost") == 0) options.constraints.maxCost = std::atof(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--max-loss") == 0) options.constraints.maxLoss = std::atof(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--min-pop") == 0) options.constraints.minPop = std::atof(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--vol") == 0) vol = std::atof(argv[i + 1]);
+            else if (std::strcmp(argv[i], "--paths") == 0) options.simulation.paths = std::atoi(argv[i + 1]);
+        }
+        StrategySearchSpace space;
+        for (int pct = 80; pct <= 120; pct += 2) space.strikes.push_back(std::round(spot * pct) / 100.0);
+        const double firstExpiry = std::max(targetDays, 1.0);
+        space.expiryDays = {firstExpiry, 2.0 * firstExpiry, 3.0 * firstExpiry};
+        try {
+            ParametricVolatility volModel(vol, -0.2, 1.0);
+            auto start = std::chrono::steady_clock::now();
+            OptimizerSummary summary = StrategyOptimizer::search(space, spot, target, targetDays, 0.05, volModel, 0.08, vol, options);
+            double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            std::cerr << summary.candidates << " candidates, " << summary.feasible << " feasible, " << summary.screened << " screened, "
+                      << summary.simulated << " simulated in " << seconds << " s" << std::endl;
+            for (const RankedStrategy& ranked : summary.ranked) {
+                printf("%-36s cost %8.3f  EV %8.3f  PoP %6.2f%%  max loss %8.3f  score %.4f\n", ranked.evaluation.strategyName.c_str(),
+                       ranked.evaluation.entryCost, ranked.evaluation.expectedValue - ranked.evaluation.entryCost, ranked.evaluation.pop * 100.0,
+                       ranked.maxLoss, ranked.score);
+            }
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            return 1;
+        }
         return 0;
     }
 
@@ -58,29 +251,20 @@ int main(int argc, char* argv[]) {
 
 
 
-    std::vector<Strategy> strategies;
-
-    // Bull
-    strategies.push_back(Strategy::longCall(i_current_stock_price, (i_expiry_days / gbl::TRADING_DAYS)));
-    strategies.push_back(Strategy::bullCallSpread(i_current_stock_price, i_current_stock_price * 1.10, (i_expiry_days / gbl::TRADING_DAYS)));
-    // Bear
-    strategies.push_back(Strategy::longPut(i_current_stock_price, (i_expiry_days / gbl::TRADING_DAYS)));
-    strategies.push_back(Strategy::bearPutSpread(i_current_stock_price, i_current_stock_price * 0.90, (i_expiry_days / gbl::TRADING_DAYS)));
-    // Volatility
-    strategies.push_back(Strategy::straddle(i_current_stock_price, (i_expiry_days / gbl::TRADING_DAYS)));
-    // Structure: Long 90% Put / Short 95% Put / Short 105% Call / Long 110% Call
-    strategies.push_back(Strategy::ironCondor(i_current_stock_price * 0.90, i_current_stock_price * 0.95, i_current_stock_price * 1.05, i_current_stock_price * 1.10, (i_expiry_days / gbl::TRADING_DAYS)));
-
-
+    std::vector<Strategy> strategies = ScenarioRunner::strategies(i_current_stock_price, i_expiry_days);
 
     std::vector<result> results;
 
-    for(const Strategy& strat : strategies) {
-        try {
-            result res = OptionWizard::simulateStrategy(strat, i_current_stock_price, i_target_price, i_target_date, r, *volModel, i_expected_return, sigma);
-            results.push_back(res);
-        } catch (const std::exception& e) {
-            std::cerr << "Error simulating " << strat.getName() << ": " << e.what() << std::endl;
+    try {
+        results = OptionWizard::simulateStrategies(strategies, i_current_stock_price, i_target_price, i_target_date, r, *volModel, i_expected_return, sigma);
+    } catch (const std::exception&) {
+        // one bad strategy fails the whole batch: run them singly to report it and keep the rest
+        for(const Strategy& strat : strategies) {
+            try {
+                results.push_back(OptionWizard::simulateStrategy(strat, i_current_stock_price, i_target_price, i_target_date, r, *volModel, i_expected_return, sigma));
+            } catch (const std::exception& e) {
+                std::cerr << "Error simulating " << strat.getName() << ": " << e.what() << std::endl;
+            }
         }
     }
 